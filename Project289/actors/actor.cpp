@@ -1,13 +1,17 @@
 #include "actor.h"
 #include "actor_component.h"
 
+#include <vector>
+
 Actor::Actor(ActorId id) {
     m_id = id;
     m_type_name = "Unknown";
     m_resource_name = "Unknown";
 }
 
-Actor::~Actor() {}
+Actor::~Actor() {
+    Destroy();
+}
 
 bool Actor::Init(TiXmlElement* pData) {
     m_name = "NoName";
@@ -23,7 +27,20 @@ void Actor::PostInit() {
 }
 
 void Actor::Destroy() {
+    // Components still referenced elsewhere outlive this call, so they lose their back-reference instead of dangling.
+    std::vector<WeakActorComponentPtr> components;
+    components.reserve(m_components.size());
+    for (auto it = m_components.begin(); it != m_components.end(); ++it) {
+        components.push_back(it->second);
+    }
     m_components.clear();
+
+    for (const WeakActorComponentPtr& pWeakComponent : components) {
+        StrongActorComponentPtr pComponent = pWeakComponent.lock();
+        if (pComponent) {
+            pComponent->SetOwner(nullptr);
+        }
+    }
 }
 
 void Actor::Update(float deltaMs) {
@@ -48,6 +65,14 @@ void Actor::SetName(std::string new_name) {
     m_name = std::move(new_name);
 }
 
+const std::string& Actor::GetResourceName() const {
+    return m_resource_name;
+}
+
+void Actor::SetResourceName(std::string resource_name) {
+    m_resource_name = std::move(resource_name);
+}
+
 const ActorComponents& Actor::GetComponents() {
     return m_components;
 }
@@ -75,4 +100,20 @@ std::string Actor::ToXML() {
     outDoc.Accept(&printer);
 
     return printer.CStr();
+}
+
+void Actor::ToBinary(BinaryWriter& out) const {
+    size_t actorBlock = out.BeginBlock();
+    out.WriteVarint(m_id);
+    out.WriteString(m_resource_name);
+    out.WriteString(m_name);
+
+    out.WriteVarint(m_components.size());
+    for (auto it = m_components.begin(); it != m_components.end(); ++it) {
+        out.WriteU32(it->first);
+        size_t componentBlock = out.BeginBlock();
+        it->second->VSerializeBinary(out);
+        out.EndBlock(componentBlock);
+    }
+    out.EndBlock(actorBlock);
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <utility>
 
 #include "../tools/tinyxml/tinyxml.h"
+#include "../tools/binary_stream.h"
 
 class Actor;
 class ActorComponent;
@@ -43,11 +44,15 @@ public:
     void Update(float deltaMs);
 
     std::string ToXML();
+    // Appends one length prefixed actor record, read back by ActorFactory::BuildActorFromBinary.
+    void ToBinary(BinaryWriter& out) const;
 
     unsigned int GetId() const;
     const std::string& GetType() const;
     const std::string& GetName() const;
     void SetName(std::string new_name);
+    const std::string& GetResourceName() const;
+    void SetResourceName(std::string resource_name);
 
     template <class ComponentType>
     std::weak_ptr<ComponentType> GetComponent(ComponentId id) {
@@ -65,7 +70,7 @@ public:
 
     template <class ComponentType>
     std::weak_ptr<ComponentType> GetComponent(const char* name) {
-        unsigned int id = ActorComponent::GetIdFromName(name);
+        unsigned int id = ComponentType::GetIdFromName(name);
         auto findIt = m_components.find(id);
         if (findIt != m_components.end()) {
             StrongActorComponentPtr pBase(findIt->second);
@@ -83,6 +88,16 @@ public:
         return GetComponent<ComponentType>(name.c_str());
     }
 
+    // Non-owning lookup by the compile-time id; the pointer is only valid until the actor is destroyed.
+    template <class ComponentType>
+    ComponentType* GetComponentFast() {
+        auto findIt = m_components.find(ComponentType::sk_ComponentId);
+        if (findIt != m_components.end()) {
+            return static_cast<ComponentType*>(findIt->second.get());
+        }
+        return nullptr;
+    }
+
     const ActorComponents& GetComponents();
 
     void AddComponent(StrongActorComponentPtr pComponent);
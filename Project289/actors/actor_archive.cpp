@@ -0,0 +1,16 @@
+#include "actor_archive.h"
+
+void WriteActorArchiveHeader(BinaryWriter& out, uint32_t actorCount) {
+	out.WriteU32(sk_ActorArchiveMagic);
+	out.WriteU32(sk_ActorArchiveVersion);
+	out.WriteU32(actorCount);
+}
+
+bool ReadActorArchiveHeader(BinaryReader& in, uint32_t& version, uint32_t& actorCount) {
+	if (in.ReadU32() != sk_ActorArchiveMagic) {
+		return false;
+	}
+	version = in.ReadU32();
+	actorCount = in.ReadU32();
+	return in.IsGood() && version >= 1u && version <= sk_ActorArchiveVersion;
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+
+#include "../tools/binary_stream.h"
+
+// Binary actor archive used for quick saves and level streaming: a header followed by one record per actor
+// (see Actor::ToBinary). Bump sk_ActorArchiveVersion whenever a component changes its payload and branch on
+// the version in VDeserializeBinary so older archives keep loading.
+constexpr uint32_t sk_ActorArchiveMagic = 0x52414341u; // "ACAR"
+constexpr uint32_t sk_ActorArchiveVersion = 3u;
+
+void WriteActorArchiveHeader(BinaryWriter& out, uint32_t actorCount);
+bool ReadActorArchiveHeader(BinaryReader& in, uint32_t& version, uint32_t& actorCount);
@@ -2,32 +2,44 @@
 
 #include "actor.h"
 
-ActorComponent::~ActorComponent() {
-	m_pOwner.reset();
-}
+ActorComponent::~ActorComponent() {}
 
 void ActorComponent::VPostInit() {}
 
 void ActorComponent::VUpdate(float deltaMs) {}
 
+bool ActorComponent::VRequiresUpdate() const {
+	return false;
+}
+
 void ActorComponent::VOnChanged() {}
 
+void ActorComponent::VSerializeBinary(BinaryWriter& out) const {}
+
+bool ActorComponent::VDeserializeBinary(BinaryReader& in, uint32_t version) {
+	return true;
+}
+
+StrongActorComponentPtr ActorComponent::VClone() const {
+	return StrongActorComponentPtr();
+}
+
 ComponentId ActorComponent::GetIdFromName(const std::string& componentStr) {
-	return static_cast<ComponentId>(std::hash<std::string>{}(componentStr));
+	return Fnv1a32(componentStr.c_str());
 }
 
 ComponentId ActorComponent::VGetId() const {
 	return GetIdFromName(VGetName());
 }
 
-void ActorComponent::SetOwner(StrongActorPtr pOwner) {
+void ActorComponent::SetOwner(Actor* pOwner) {
 	m_pOwner = pOwner;
 }
 
-StrongActorPtr ActorComponent::GetOwner() {
+Actor* ActorComponent::GetOwner() {
 	return m_pOwner;
 }
 
 ActorId ActorComponent::GetOwnerId() {
-	return m_pOwner->GetId();
+	return m_pOwner ? m_pOwner->GetId() : INVALID_ACTOR_ID;
 }
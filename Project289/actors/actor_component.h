@@ -4,14 +4,21 @@
 #include <functional>
 
 #include "../tools/tinyxml/tinyxml.h"
+#include "../tools/fnv_hash.h"
+#include "../tools/binary_stream.h"
 
-#include "Actor.h"
+#include "actor.h"
+#include "component_pool.h"
 
 class ActorComponent {
 	friend class ActorFactory;
+	friend class ComponentStore;
+
+	ComponentHandle m_poolHandle;
 
 protected:
-	StrongActorPtr m_pOwner;
+	// Non-owning: the actor owns its components and detaches them when it is destroyed.
+	Actor* m_pOwner = nullptr;
 
 public:
 	virtual ~ActorComponent();
@@ -19,15 +26,25 @@ public:
 	virtual bool VInit(TiXmlElement* pData) = 0;
 	virtual void VPostInit();
 	virtual void VUpdate(float deltaMs);
+	// Components that override VUpdate return true so ComponentStore puts their type in the per-frame update loop.
+	virtual bool VRequiresUpdate() const;
 	virtual void VOnChanged();
 
 	virtual TiXmlElement* VGenerateXml() = 0;
 
+	// Binary counterpart of VGenerateXml/VInit used by actor archives. The caller length prefixes the payload, so a
+	// component only handles its own fields; version is the archive schema the payload was written with.
+	virtual void VSerializeBinary(BinaryWriter& out) const;
+	virtual bool VDeserializeBinary(BinaryReader& in, uint32_t version);
+
+	// Copies an initialized, ownerless component so actor prototypes can be stamped out without re-running VInit; empty when unsupported.
+	virtual StrongActorComponentPtr VClone() const;
+
 	virtual ComponentId VGetId() const;
 	virtual const std::string& VGetName() const = 0;
 	static ComponentId GetIdFromName(const std::string& componentStr);
 
-	void SetOwner(StrongActorPtr pOwner);
-	StrongActorPtr GetOwner();
+	void SetOwner(Actor* pOwner);
+	Actor* GetOwner();
 	ActorId GetOwnerId();
 };
\ No newline at end of file
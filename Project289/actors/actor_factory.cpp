@@ -13,6 +13,12 @@ unsigned int ActorFactory::GetNextActorId() {
     return ++m_lastActorId;
 }
 
+void ActorFactory::ObserveActorId(ActorId actorId) {
+    // Ids loaded from an archive must never be handed out again
+    ActorId lastActorId = m_lastActorId.load();
+    while (lastActorId < actorId && !m_lastActorId.compare_exchange_weak(lastActorId, actorId)) {}
+}
+
 ActorFactory::ActorFactory() {
     m_lastActorId = 0;
 
@@ -27,34 +33,45 @@ ActorFactory::ActorFactory() {
 }
 
 std::shared_ptr<Actor> ActorFactory::CreateActor(const char* actorResource, TiXmlElement* overrides, const DirectX::XMFLOAT4X4* pinitialTransform, const ActorId serversActorId) {
+    std::vector<std::shared_ptr<ActorComponent>> changedComponents;
+    std::shared_ptr<Actor> pActor = BuildActor(actorResource, overrides, pinitialTransform, ReserveActorId(serversActorId), changedComponents);
+    if (pActor) {
+        FinishActor(pActor, changedComponents);
+    }
+    return pActor;
+}
 
-    TiXmlDocument xml;
-    xml.LoadFile(actorResource);
+ActorId ActorFactory::ReserveActorId(const ActorId serversActorId) {
+    if (serversActorId != INVALID_ACTOR_ID) {
+        return serversActorId;
+    }
+    return GetNextActorId();
+}
 
-    // Grab the root XML node
-    TiXmlElement* pRoot = xml.RootElement();
-    if (!pRoot) {
+std::shared_ptr<Actor> ActorFactory::BuildActor(const char* actorResource, TiXmlElement* overrides, const DirectX::XMFLOAT4X4* pinitialTransform, const ActorId actorId, std::vector<std::shared_ptr<ActorComponent>>& changedComponents) {
+    const ActorPrototype* pPrototype = GetPrototype(actorResource);
+    if (!pPrototype) {
         return std::shared_ptr<Actor>();
     }
+    TiXmlElement* pRoot = pPrototype->pRoot;
 
     // create the actor instance
-    ActorId nextActorId = serversActorId;
-    if (nextActorId == 0) {
-        nextActorId = GetNextActorId();
-    }
-    std::shared_ptr<Actor> pActor(new Actor(nextActorId));
+    std::shared_ptr<Actor> pActor = MakePooled<Actor>(actorId);
     if (!pActor->Init(pRoot)) {
         return std::shared_ptr<Actor>();
     }
+    pActor->SetResourceName(actorResource);
 
-    bool initialTransformSet = false;
-
-    // Loop through each child element and load the component
-    for (TiXmlElement* pNode = pRoot->FirstChildElement(); pNode; pNode = pNode->NextSiblingElement()) {
-        std::shared_ptr<ActorComponent> pComponent(VCreateComponent(pNode));
+    // Copy each prototype component. A component type without VClone, say one made by a subclass factory, gets an
+    // empty clone and is initialized from the template XML instead
+    for (const ActorPrototype::ComponentPrototype& componentPrototype : pPrototype->components) {
+        std::shared_ptr<ActorComponent> pComponent = componentPrototype.pTemplate->VClone();
+        if (!pComponent) {
+            pComponent = VCreateComponent(componentPrototype.pData);
+        }
         if (pComponent) {
             pActor->AddComponent(pComponent);
-            pComponent->SetOwner(pActor);
+            pComponent->SetOwner(pActor.get());
         }
         else {
             // If an error occurs, we kill the actor and bail.  We could keep going, but the actor is will only be 
@@ -65,7 +82,7 @@ std::shared_ptr<Actor> ActorFactory::CreateActor(const char* actorResource, TiXm
     }
 
     if (overrides) {
-        ModifyActor(pActor, overrides);
+        ApplyOverrides(pActor, overrides, changedComponents);
     }
 
     // This is a bit of a hack to get the initial transform of the transform component set before the 
@@ -75,10 +92,114 @@ std::shared_ptr<Actor> ActorFactory::CreateActor(const char* actorResource, TiXm
         pTransformComponent->SetPosition4x4f(*pinitialTransform);
     }
 
+    return pActor;
+}
+
+void ActorFactory::FinishActor(const std::shared_ptr<Actor>& pActor, const std::vector<std::shared_ptr<ActorComponent>>& changedComponents) {
+    // added post press to ensure that components that need it have
+    // Events generated that can notify subsystems when changes happen.
+    // This was done to have SceneNode derived classes respond to RenderComponent
+    // changes.
+    for (const std::shared_ptr<ActorComponent>& pComponent : changedComponents) {
+        pComponent->VOnChanged();
+    }
+
     // Now that the actor has been fully created, run the post init phase
     pActor->PostInit();
+}
 
-    return pActor;
+std::shared_ptr<Actor> ActorFactory::BuildActorFromBinary(BinaryReader& in, uint32_t version, std::vector<std::shared_ptr<ActorComponent>>& changedComponents) {
+    BinaryReader record(nullptr, 0u);
+    if (!in.ReadBlock(record)) {
+        return std::shared_ptr<Actor>();
+    }
+
+    ActorId actorId = static_cast<ActorId>(record.ReadVarint());
+    std::string resource = record.ReadString();
+    std::string name = record.ReadString();
+    if (!record.IsGood() || actorId == INVALID_ACTOR_ID) {
+        return std::shared_ptr<Actor>();
+    }
+    ObserveActorId(actorId);
+
+    std::shared_ptr<Actor> pActor = BuildActor(resource.c_str(), nullptr, nullptr, actorId, changedComponents);
+    if (!pActor) {
+        return std::shared_ptr<Actor>();
+    }
+    pActor->SetName(std::move(name));
+
+    uint64_t componentCount = record.ReadVarint();
+    for (uint64_t i = 0u; i < componentCount; ++i) {
+        ComponentId componentId = record.ReadU32();
+        BinaryReader payload(nullptr, 0u);
+        if (!record.ReadBlock(payload)) {
+            return std::shared_ptr<Actor>();
+        }
+
+        // Components the template no longer has are skipped, the block length lets the rest of the record load
+        std::shared_ptr<ActorComponent> pComponent = MakeStrongPtr(pActor->GetComponent<ActorComponent>(componentId));
+        if (!pComponent) {
+            continue;
+        }
+        if (!pComponent->VDeserializeBinary(payload, version) || !payload.IsGood()) {
+            return std::shared_ptr<Actor>();
+        }
+        changedComponents.push_back(pComponent);
+    }
+
+    return record.IsGood() ? pActor : std::shared_ptr<Actor>();
+}
+
+const ActorPrototype* ActorFactory::GetPrototype(const std::string& actorResource) {
+    {
+        std::lock_guard<std::mutex> lock(m_prototypesMutex);
+        auto findIt = m_prototypes.find(actorResource);
+        if (findIt != m_prototypes.end()) {
+            return findIt->second.get();
+        }
+    }
+
+    // Built outside the lock so loader threads can parse different templates at once; if two threads race on
+    // the same template the first one inserted wins and the other copy is dropped.
+    std::unique_ptr<ActorPrototype> pPrototype = BuildPrototype(actorResource);
+    if (!pPrototype) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(m_prototypesMutex);
+    return m_prototypes.emplace(actorResource, std::move(pPrototype)).first->second.get();
+}
+
+void ActorFactory::ClearPrototypes() {
+    std::lock_guard<std::mutex> lock(m_prototypesMutex);
+    m_prototypes.clear();
+}
+
+std::unique_ptr<ActorPrototype> ActorFactory::BuildPrototype(const std::string& actorResource) {
+    std::unique_ptr<ActorPrototype> pPrototype = std::make_unique<ActorPrototype>();
+    if (!pPrototype->document.LoadFile(actorResource.c_str())) {
+        return nullptr;
+    }
+
+    TiXmlElement* pRoot = pPrototype->document.RootElement();
+    if (!pRoot) {
+        return nullptr;
+    }
+    pPrototype->pRoot = pRoot;
+
+    // Every component is initialized once here, so a template that fails validation is rejected before any actor exists.
+    for (TiXmlElement* pNode = pRoot->FirstChildElement(); pNode; pNode = pNode->NextSiblingElement()) {
+        std::shared_ptr<ActorComponent> pComponent = VCreateComponent(pNode);
+        if (!pComponent) {
+            return nullptr;
+        }
+
+        ActorPrototype::ComponentPrototype componentPrototype;
+        componentPrototype.pData = pNode;
+        componentPrototype.pTemplate = std::move(pComponent);
+        pPrototype->components.push_back(std::move(componentPrototype));
+    }
+
+    return pPrototype;
 }
 
 std::shared_ptr<ActorComponent> ActorFactory::VCreateComponent(TiXmlElement* pData) {
@@ -111,6 +232,14 @@ std::shared_ptr<Actor> ActorFactory::CreateActor(const std::string& actorResourc
 }
 
 void ActorFactory::ModifyActor(std::shared_ptr<Actor> pActor, TiXmlElement* overrides) {
+    std::vector<std::shared_ptr<ActorComponent>> changedComponents;
+    ApplyOverrides(pActor, overrides, changedComponents);
+    for (const std::shared_ptr<ActorComponent>& pComponent : changedComponents) {
+        pComponent->VOnChanged();
+    }
+}
+
+void ActorFactory::ApplyOverrides(const std::shared_ptr<Actor>& pActor, TiXmlElement* overrides, std::vector<std::shared_ptr<ActorComponent>>& changedComponents) {
     // Loop through each child element and load the component
     if (overrides->Attribute("name")) {
         pActor->SetName(overrides->Attribute("name"));
@@ -120,19 +249,14 @@ void ActorFactory::ModifyActor(std::shared_ptr<Actor> pActor, TiXmlElement* over
         std::shared_ptr<ActorComponent> pComponent = MakeStrongPtr(pActor->GetComponent<ActorComponent>(componentId));
         if (pComponent) {
             pComponent->VInit(pNode);
-
-            // added post press to ensure that components that need it have
-            // Events generated that can notify subsystems when changes happen.
-            // This was done to have SceneNode derived classes respond to RenderComponent
-            // changes.
-            pComponent->VOnChanged();
+            changedComponents.push_back(pComponent);
         }
         else {
             pComponent = VCreateComponent(pNode);
             if (pComponent) {
                 pActor->AddComponent(pComponent);
-                pComponent->SetOwner(pActor);
+                pComponent->SetOwner(pActor.get());
             }
         }
     }
-}
\ No newline at end of file
+}
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <atomic>
 #include <map>
+#include <mutex>
 #include <string>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 #include <DirectXMath.h>
 
 #include "../tools/tinyxml/tinyxml.h"
@@ -10,9 +14,25 @@
 #include "actor_component.h"
 #include "../tools/generic_object_factory.h"
 #include "../tools/memory_utility.h"
+#include "../tools/object_pool.h"
+
+// A template parsed once: every component is kept initialized and ownerless for each spawn to clone, the XML stays
+// alive for the actor attributes and for component types whose VClone returns nothing.
+struct ActorPrototype {
+    struct ComponentPrototype {
+        TiXmlElement* pData;
+        StrongActorComponentPtr pTemplate;
+    };
+
+    TiXmlDocument document;
+    TiXmlElement* pRoot = nullptr;
+    std::vector<ComponentPrototype> components;
+};
 
 class ActorFactory {
-    ActorId m_lastActorId;
+    std::atomic<ActorId> m_lastActorId;
+    std::mutex m_prototypesMutex;
+    std::unordered_map<std::string, std::unique_ptr<ActorPrototype>> m_prototypes;
 
 protected:
     GenericObjectFactory<ActorComponent, ComponentId> m_componentFactory;
@@ -25,8 +45,24 @@ public:
     std::shared_ptr<Actor> CreateActor(const std::string& actorResource, TiXmlElement* overrides, DirectX::FXMMATRIX initialTransform, const ActorId serversActorId);
     void ModifyActor(std::shared_ptr<Actor> pActor, TiXmlElement* overrides);
 
+    // Two phase creation for loader threads: BuildActor is safe to call concurrently and fires no events,
+    // FinishActor must run on the main thread and sends the change notifications and PostInit.
+    ActorId ReserveActorId(const ActorId serversActorId);
+    std::shared_ptr<Actor> BuildActor(const char* actorResource, TiXmlElement* overrides, const DirectX::XMFLOAT4X4* initialTransform, const ActorId actorId, std::vector<std::shared_ptr<ActorComponent>>& changedComponents);
+    void FinishActor(const std::shared_ptr<Actor>& pActor, const std::vector<std::shared_ptr<ActorComponent>>& changedComponents);
+
+    // Reads one record written by Actor::ToBinary: the actor is stamped from its template and the saved component
+    // payloads are applied over it. Finish it with FinishActor like any other built actor.
+    std::shared_ptr<Actor> BuildActorFromBinary(BinaryReader& in, uint32_t version, std::vector<std::shared_ptr<ActorComponent>>& changedComponents);
+
+    const ActorPrototype* GetPrototype(const std::string& actorResource);
+    void ClearPrototypes();
+
     virtual std::shared_ptr<ActorComponent> VCreateComponent(TiXmlElement* pData);
 
 private:
     ActorId GetNextActorId();
+    void ObserveActorId(ActorId actorId);
+    std::unique_ptr<ActorPrototype> BuildPrototype(const std::string& actorResource);
+    void ApplyOverrides(const std::shared_ptr<Actor>& pActor, TiXmlElement* overrides, std::vector<std::shared_ptr<ActorComponent>>& changedComponents);
 };
\ No newline at end of file
@@ -0,0 +1,35 @@
+#include "actor_memory_report.h"
+#include "actor.h"
+#include "component_store.h"
+
+#include <algorithm>
+
+ActorMemoryReport GetActorMemoryReport(const ComponentStore& store) {
+	ActorMemoryReport report;
+	report.actorPool = GetObjectPool<Actor>().GetStats();
+	report.liveActors = report.actorPool.liveObjects;
+
+	for (const ObjectPoolStats& stats : ObjectPool::GetAllStats()) {
+		report.bytesInUse += stats.bytesInUse;
+		report.bytesReserved += stats.bytesReserved;
+	}
+
+	store.ForEachPool([&report](const ComponentPool& pool) {
+		report.componentPools.push_back({ pool.GetName(), pool.Size(), pool.GetBytesReserved() });
+		report.liveComponents += pool.Size();
+		report.bytesReserved += pool.GetBytesReserved();
+	});
+	std::sort(report.componentPools.begin(), report.componentPools.end(), [](const ComponentPoolReport& a, const ComponentPoolReport& b) { return a.name < b.name; });
+
+	return report;
+}
+
+std::ostream& operator<<(std::ostream& os, const ActorMemoryReport& report) {
+	os << "Actors: " << report.liveActors << " live, " << report.actorPool.bytesInUse << " bytes\n";
+	os << "Components: " << report.liveComponents << " live\n";
+	for (const ComponentPoolReport& pool : report.componentPools) {
+		os << pool.name << ": " << pool.liveComponents << " live, " << pool.bytesReserved << " bytes reserved in the store\n";
+	}
+	os << "Total: " << report.bytesInUse << " bytes in use, " << report.bytesReserved << " bytes reserved\n";
+	return os;
+}
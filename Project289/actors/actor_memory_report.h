@@ -0,0 +1,30 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "../tools/object_pool.h"
+
+class ComponentStore;
+
+struct ComponentPoolReport {
+	std::string name;
+	size_t liveComponents = 0u;
+	size_t bytesReserved = 0u;
+};
+
+// Snapshot of the actor pool and the component store, meant for soak tests that check memory stays flat under
+// spawn/destroy churn. Components are counted per type from the store's pools, so types that are not allocated from
+// an ObjectPool show up too; the byte totals add the object pools to the store's index arrays.
+struct ActorMemoryReport {
+	size_t liveActors = 0u;
+	ObjectPoolStats actorPool;
+	size_t liveComponents = 0u;
+	std::vector<ComponentPoolReport> componentPools;
+	size_t bytesInUse = 0u;
+	size_t bytesReserved = 0u;
+};
+
+ActorMemoryReport GetActorMemoryReport(const ComponentStore& store);
+std::ostream& operator<<(std::ostream& os, const ActorMemoryReport& report);
@@ -35,6 +35,15 @@ TiXmlElement* BaseRenderComponent::VGenerateXml() {
 	return pBaseElement;
 }
 
+void BaseRenderComponent::VSerializeBinary(BinaryWriter& out) const {
+	out.WriteFloat4(m_color);
+}
+
+bool BaseRenderComponent::VDeserializeBinary(BinaryReader& in, uint32_t version) {
+	m_color = in.ReadFloat4();
+	return in.IsGood();
+}
+
 const DirectX::XMFLOAT4& BaseRenderComponent::GetColor() const {
 	return m_color;
 }
@@ -24,6 +24,8 @@ public:
     virtual void VPostInit() override;
     virtual void VOnChanged() override;
     virtual TiXmlElement* VGenerateXml() override;
+    virtual void VSerializeBinary(BinaryWriter& out) const override;
+    virtual bool VDeserializeBinary(BinaryReader& in, uint32_t version) override;
 
     const DirectX::XMFLOAT4& GetColor() const;
     void SetColor(DirectX::XMFLOAT4 color);
@@ -0,0 +1,95 @@
+#include "component_pool.h"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+ComponentPool::ComponentPool(std::string name, bool requiresUpdate) : m_name(std::move(name)), m_walkDepth(0u), m_requiresUpdate(requiresUpdate) {}
+
+ComponentHandle ComponentPool::Add(ActorComponent* pComponent) {
+	uint32_t slot;
+	if (!m_freeSlots.empty()) {
+		slot = m_freeSlots.back();
+		m_freeSlots.pop_back();
+	}
+	else {
+		slot = static_cast<uint32_t>(m_slots.size());
+		m_slots.emplace_back();
+	}
+
+	m_slots[slot].denseIndex = static_cast<uint32_t>(m_dense.size());
+	m_dense.push_back({ pComponent, slot });
+
+	return { slot, m_slots[slot].generation };
+}
+
+bool ComponentPool::Remove(ComponentHandle handle) {
+	if (!Get(handle)) {
+		return false;
+	}
+
+	Slot& slot = m_slots[handle.index];
+	uint32_t denseIndex = slot.denseIndex;
+	++slot.generation;
+	m_freeSlots.push_back(handle.index);
+
+	if (m_walkDepth > 0u) {
+		m_dense[denseIndex].pComponent = nullptr;
+		m_holes.push_back(denseIndex);
+	}
+	else {
+		SwapRemove(denseIndex);
+	}
+	return true;
+}
+
+ActorComponent* ComponentPool::Get(ComponentHandle handle) const {
+	if (handle.index >= m_slots.size() || m_slots[handle.index].generation != handle.generation) {
+		return nullptr;
+	}
+	return m_dense[m_slots[handle.index].denseIndex].pComponent;
+}
+
+void ComponentPool::Clear() {
+	for (const Entry& entry : m_dense) {
+		if (entry.pComponent) {
+			++m_slots[entry.slot].generation;
+			m_freeSlots.push_back(entry.slot);
+		}
+	}
+	m_dense.clear();
+	m_holes.clear();
+}
+
+size_t ComponentPool::Size() const {
+	return m_dense.size() - m_holes.size();
+}
+
+bool ComponentPool::RequiresUpdate() const {
+	return m_requiresUpdate;
+}
+
+const std::string& ComponentPool::GetName() const {
+	return m_name;
+}
+
+size_t ComponentPool::GetBytesReserved() const {
+	return m_dense.capacity() * sizeof(Entry) + m_slots.capacity() * sizeof(Slot) + (m_freeSlots.capacity() + m_holes.capacity()) * sizeof(uint32_t);
+}
+
+void ComponentPool::SwapRemove(uint32_t denseIndex) {
+	if (denseIndex + 1u < m_dense.size()) {
+		m_dense[denseIndex] = m_dense.back();
+		m_slots[m_dense[denseIndex].slot].denseIndex = denseIndex;
+	}
+	m_dense.pop_back();
+}
+
+void ComponentPool::FillHoles() {
+	// Highest first, everything above the hole being filled is then live, so the entry moved into it is never a hole
+	std::sort(m_holes.begin(), m_holes.end(), std::greater<uint32_t>());
+	for (uint32_t denseIndex : m_holes) {
+		SwapRemove(denseIndex);
+	}
+	m_holes.clear();
+}
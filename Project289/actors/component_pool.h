@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class ActorComponent;
+
+struct ComponentHandle {
+	uint32_t index = UINT32_MAX;
+	uint32_t generation = 0u;
+
+	bool IsValid() const { return index != UINT32_MAX; }
+};
+
+// Dense array of every live component of one type. Handles are generation checked and point at a slot that tracks
+// the component's dense index, so Remove moves the last entry into the gap in O(1) and the array never has holes.
+// While ForEach is walking the pool a removed entry is only cleared, a swap would make the walk skip the moved entry
+// or visit it twice; the gaps are filled once the outermost walk ends. Components added during a walk are visited by it.
+class ComponentPool {
+	struct Slot {
+		uint32_t denseIndex = 0u;
+		uint32_t generation = 0u;
+	};
+
+	struct Entry {
+		ActorComponent* pComponent;
+		uint32_t slot;
+	};
+
+	std::vector<Entry> m_dense;
+	std::vector<Slot> m_slots;
+	std::vector<uint32_t> m_freeSlots;
+	std::vector<uint32_t> m_holes;
+	std::string m_name;
+	uint32_t m_walkDepth;
+	bool m_requiresUpdate;
+
+public:
+	ComponentPool(std::string name, bool requiresUpdate);
+
+	ComponentHandle Add(ActorComponent* pComponent);
+	bool Remove(ComponentHandle handle);
+	ActorComponent* Get(ComponentHandle handle) const;
+
+	// Drops every component and invalidates all handles; the pool itself stays, so outstanding refs resolve to nullptr.
+	void Clear();
+
+	size_t Size() const;
+	bool RequiresUpdate() const;
+	const std::string& GetName() const;
+	// Capacity of the dense and slot arrays, the components themselves are allocated by their actors.
+	size_t GetBytesReserved() const;
+
+	template <class ComponentType, class Fn>
+	void ForEach(Fn&& fn) {
+		++m_walkDepth;
+		for (size_t i = 0u; i < m_dense.size(); ++i) {
+			ActorComponent* pComponent = m_dense[i].pComponent;
+			if (pComponent) {
+				fn(*static_cast<ComponentType*>(pComponent));
+			}
+		}
+		if (--m_walkDepth == 0u && !m_holes.empty()) {
+			FillHoles();
+		}
+	}
+
+private:
+	void SwapRemove(uint32_t denseIndex);
+	void FillHoles();
+};
@@ -0,0 +1,65 @@
+#include "component_store.h"
+
+// A handle left over from a store that was replaced may still match a slot here, so membership is checked by pointer.
+void ComponentStore::AddActor(Actor& actor) {
+	for (const auto& [id, pComponent] : actor.GetComponents()) {
+		ComponentPool& pool = FindOrCreatePool(*pComponent);
+		if (pool.Get(pComponent->m_poolHandle) == pComponent.get()) {
+			continue;
+		}
+		pComponent->m_poolHandle = pool.Add(pComponent.get());
+	}
+}
+
+void ComponentStore::RemoveActor(Actor& actor) {
+	for (const auto& [id, pComponent] : actor.GetComponents()) {
+		ComponentPool* pPool = GetPool(id);
+		if (pPool && pPool->Get(pComponent->m_poolHandle) == pComponent.get()) {
+			pPool->Remove(pComponent->m_poolHandle);
+		}
+		pComponent->m_poolHandle = ComponentHandle();
+	}
+}
+
+void ComponentStore::Clear() {
+	for (const auto& [id, pPool] : m_pools) {
+		pPool->ForEach<ActorComponent>([](ActorComponent& component) { component.m_poolHandle = ComponentHandle(); });
+		pPool->Clear();
+	}
+}
+
+void ComponentStore::Update(float deltaMs) {
+	// The pool count is re-read every step, a VUpdate may spawn an actor whose component type adds a new update pool.
+	// Spawns and destroys within one pool are handled by the pool's walk.
+	for (size_t poolIndex = 0u; poolIndex < m_updatePools.size(); ++poolIndex) {
+		m_updatePools[poolIndex]->ForEach<ActorComponent>([deltaMs](ActorComponent& component) { component.VUpdate(deltaMs); });
+	}
+}
+
+ComponentPool* ComponentStore::GetPool(ComponentId id) const {
+	auto findIt = m_pools.find(id);
+	if (findIt != m_pools.end()) {
+		return findIt->second.get();
+	}
+	return nullptr;
+}
+
+size_t ComponentStore::GetComponentCount() const {
+	size_t count = 0;
+	for (const auto& [id, pPool] : m_pools) {
+		count += pPool->Size();
+	}
+	return count;
+}
+
+ComponentPool& ComponentStore::FindOrCreatePool(const ActorComponent& component) {
+	ComponentId id = component.VGetId();
+	std::shared_ptr<ComponentPool>& pPool = m_pools[id];
+	if (!pPool) {
+		pPool = std::make_shared<ComponentPool>(component.VGetName(), component.VRequiresUpdate());
+		if (pPool->RequiresUpdate()) {
+			m_updatePools.push_back(pPool.get());
+		}
+	}
+	return *pPool;
+}
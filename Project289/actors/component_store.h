@@ -0,0 +1,80 @@
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "actor_component.h"
+#include "component_pool.h"
+
+// Cached, non-owning reference to a pooled component. Get() returns nullptr once the actor has been destroyed, the
+// store cleared or the store itself destroyed or replaced, so scene nodes and physics can hold one across frames
+// instead of looking the component up by name. The pool is held weakly and the handle generation checked in it.
+template <class ComponentType>
+class ComponentRef {
+	std::weak_ptr<ComponentPool> m_pPool;
+	ComponentHandle m_handle;
+
+public:
+	ComponentRef() = default;
+	ComponentRef(std::weak_ptr<ComponentPool> pPool, ComponentHandle handle) : m_pPool(std::move(pPool)), m_handle(handle) {}
+
+	ComponentType* Get() const {
+		std::shared_ptr<ComponentPool> pPool = m_pPool.lock();
+		return pPool ? static_cast<ComponentType*>(pPool->Get(m_handle)) : nullptr;
+	}
+
+	void Reset() {
+		m_pPool.reset();
+		m_handle = ComponentHandle();
+	}
+};
+
+// Per-type component pools for every actor owned by the game logic. Actor keeps its lookup API on top of this,
+// while per-frame work walks the pools: only types that override VUpdate get a pool in the update list.
+// Pools are held by shared_ptr so the ComponentRefs made from them can hold them weakly and see the store go away.
+class ComponentStore {
+	std::unordered_map<ComponentId, std::shared_ptr<ComponentPool>> m_pools;
+	std::vector<ComponentPool*> m_updatePools;
+
+public:
+	void AddActor(Actor& actor);
+	void RemoveActor(Actor& actor);
+	void Clear();
+
+	void Update(float deltaMs);
+
+	ComponentPool* GetPool(ComponentId id) const;
+	size_t GetComponentCount() const;
+
+	template <class ComponentType, class Fn>
+	void ForEach(Fn&& fn) const {
+		ComponentPool* pPool = GetPool(ComponentType::sk_ComponentId);
+		if (pPool) {
+			pPool->ForEach<ComponentType>(std::forward<Fn>(fn));
+		}
+	}
+
+	template <class Fn>
+	void ForEachPool(Fn&& fn) const {
+		for (const auto& [id, pPool] : m_pools) {
+			fn(static_cast<const ComponentPool&>(*pPool));
+		}
+	}
+
+	template <class ComponentType>
+	ComponentRef<ComponentType> MakeRef(Actor& actor) const {
+		ComponentType* pComponent = actor.GetComponentFast<ComponentType>();
+		if (!pComponent || !pComponent->m_poolHandle.IsValid()) {
+			return ComponentRef<ComponentType>();
+		}
+		auto findIt = m_pools.find(ComponentType::sk_ComponentId);
+		if (findIt == m_pools.end()) {
+			return ComponentRef<ComponentType>();
+		}
+		return ComponentRef<ComponentType>(findIt->second, pComponent->m_poolHandle);
+	}
+
+private:
+	ComponentPool& FindOrCreatePool(const ActorComponent& component);
+};
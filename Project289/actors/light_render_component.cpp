@@ -1,4 +1,5 @@
 #include "light_render_component.h"
+#include "../tools/object_pool.h"
 #include "../nodes/d3d_light_node_11.h"
 #include "../engine/engine.h"
 
@@ -8,6 +9,39 @@ const std::string& LightRenderComponent::VGetName() const {
 	return g_Name;
 }
 
+StrongActorComponentPtr LightRenderComponent::VClone() const {
+	return MakePooled<LightRenderComponent>(*this);
+}
+
+void LightRenderComponent::VSerializeBinary(BinaryWriter& out) const {
+	BaseRenderComponent::VSerializeBinary(out);
+	out.WriteU8(static_cast<uint8_t>(m_Props.m_LightType));
+	out.WriteFloat4(m_Props.m_Ambient);
+	out.WriteFloat4(m_Props.m_Diffuse);
+	out.WriteFloat4(m_Props.m_Specular);
+	for (float attenuation : m_Props.m_Attenuation) {
+		out.WriteFloat(attenuation);
+	}
+	out.WriteFloat(m_Props.m_Range);
+	out.WriteFloat(m_Props.m_Spot);
+}
+
+bool LightRenderComponent::VDeserializeBinary(BinaryReader& in, uint32_t version) {
+	if (!BaseRenderComponent::VDeserializeBinary(in, version)) {
+		return false;
+	}
+	m_Props.m_LightType = static_cast<LightType>(in.ReadU8());
+	m_Props.m_Ambient = in.ReadFloat4();
+	m_Props.m_Diffuse = in.ReadFloat4();
+	m_Props.m_Specular = in.ReadFloat4();
+	for (float& attenuation : m_Props.m_Attenuation) {
+		attenuation = in.ReadFloat();
+	}
+	m_Props.m_Range = in.ReadFloat();
+	m_Props.m_Spot = in.ReadFloat();
+	return in.IsGood();
+}
+
 LightRenderComponent::LightRenderComponent() {}
 
 const LightProperties& LightRenderComponent::GetLight() const {
@@ -128,6 +162,8 @@ std::shared_ptr<SceneNode> LightRenderComponent::VCreateSceneNode() {
 	if (pTransformComponent) {
 		BaseRenderComponent* weakThis(this);
 		switch (Engine::GetRendererImpl()) {
+			// The light node keeps no device objects, headless uses it as is
+			case Renderer::Renderer_Headless:
 			case Renderer::Renderer_D3D11: {
 				return std::shared_ptr<SceneNode>(new D3DLightNode11(weakThis, m_Props, pTransformComponent->GetTransform(), DirectX::XMMatrixIdentity(), true));
 			}
@@ -13,7 +13,11 @@ class LightRenderComponent : public BaseRenderComponent {
 
 public:
     static const std::string g_Name;
+    static constexpr ComponentId sk_ComponentId = Fnv1a32("LightRenderComponent");
     virtual const std::string& VGetName() const override;
+    virtual StrongActorComponentPtr VClone() const override;
+    virtual void VSerializeBinary(BinaryWriter& out) const override;
+    virtual bool VDeserializeBinary(BinaryReader& in, uint32_t version) override;
 
     LightRenderComponent();
 
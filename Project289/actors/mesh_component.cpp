@@ -1,4 +1,5 @@
 #include "mesh_component.h"
+#include "../tools/object_pool.h"
 
 const std::string MeshComponent::g_Name = "MeshComponent";
 
@@ -16,8 +17,28 @@ const std::string& MeshComponent::VGetName() const {
     return MeshComponent::g_Name;
 }
 
-const aiScene* MeshComponent::GetScene() {
-	return m_scene;
+StrongActorComponentPtr MeshComponent::VClone() const {
+	return MakePooled<MeshComponent>(*this);
+}
+
+void MeshComponent::VSerializeBinary(BinaryWriter& out) const {
+	out.WriteString(m_resource_name);
+}
+
+bool MeshComponent::VDeserializeBinary(BinaryReader& in, uint32_t version) {
+	std::string fileName = in.ReadString();
+	if (!in.IsGood() || fileName.empty()) {
+		return false;
+	}
+	// The template already loaded its mesh, only a swapped model goes back to the cache
+	if (fileName == m_resource_name) {
+		return true;
+	}
+	return SetResource(fileName);
+}
+
+const std::shared_ptr<const MeshAsset>& MeshComponent::GetAsset() {
+	return m_pAsset;
 }
 
 const std::string& MeshComponent::GetResourceName() {
@@ -34,22 +55,24 @@ bool MeshComponent::Init(TiXmlElement* pData) {
 	if (fileName.empty()) {
 		return false;
 	}
+	return SetResource(fileName);
+}
+
+bool MeshComponent::SetResource(const std::string& fileName) {
 	m_resource_name = fileName;
 	std::filesystem::path p(fileName);
 	m_resource_directory = p.parent_path().string();
 	if (fileName == "NoObj") {
+		m_pAsset.reset();
 		return true;
 	}
 	return LoadModel(p);
 }
 
 bool MeshComponent::LoadModel(const std::filesystem::path& fileName) {
-    m_scene = m_importer.ReadFile(fileName.string(), aiProcess_Triangulate | aiProcess_CalcTangentSpace | aiProcess_ConvertToLeftHanded);
-	//m_scene = m_importer.ReadFile(fileName.string(), aiProcess_Triangulate | aiProcess_CalcTangentSpace | aiProcess_MakeLeftHanded | aiProcess_FlipUVs);
-	//m_scene = m_importer.ReadFile(fileName.string(), aiProcess_Triangulate | aiProcess_CalcTangentSpace | aiProcess_MakeLeftHanded | aiProcess_FlipUVs);
-    if (!m_scene) { return false; }
-
-    return true;
+	// Every instance of a model shares the one import held by the cache
+	m_pAsset = MeshAssetCache::Get().Load(fileName.string());
+	return m_pAsset != nullptr;
 }
 
 TiXmlElement* MeshComponent::VGenerateXml() {
@@ -1,28 +1,30 @@
 #pragma once
 
 #include <filesystem>
+#include <memory>
 #include <string>
 
 #include <DirectXMath.h>
 
-#include <assimp/Importer.hpp>
-#include <assimp/postprocess.h>
-#include <assimp/scene.h>
-
 #include "actor_component.h"
+#include "../graphics/mesh_asset_cache.h"
 #include "../graphics/vertex.h"
 
 class MeshComponent : public ActorComponent {
 public:
 	static const std::string g_Name;
+	static constexpr ComponentId sk_ComponentId = Fnv1a32("MeshComponent");
 
 	MeshComponent();
 	MeshComponent(TiXmlElement* pData);
 
 	virtual bool VInit(TiXmlElement* pData) override;
 	virtual const std::string& VGetName() const override;
+	virtual StrongActorComponentPtr VClone() const override;
+	virtual void VSerializeBinary(BinaryWriter& out) const override;
+	virtual bool VDeserializeBinary(BinaryReader& in, uint32_t version) override;
 
-	const aiScene* GetScene();
+	const std::shared_ptr<const MeshAsset>& GetAsset();
 
 	const std::string& GetResourceName();
 	const std::string& GetResourceDirecory();
@@ -31,10 +33,10 @@ private:
 	std::string m_resource_name;
 	std::string m_resource_directory;
 
-	Assimp::Importer m_importer;
-	const aiScene* m_scene;
+	std::shared_ptr<const MeshAsset> m_pAsset;
 
 	bool Init(TiXmlElement* pData);
+	bool SetResource(const std::string& fileName);
 	bool LoadModel(const std::filesystem::path& fileName);
 
 	virtual TiXmlElement* VGenerateXml() override;
@@ -1,19 +1,53 @@
 #include "mesh_render_component.h"
+#include "../tools/object_pool.h"
 
 #include "transform_component.h"
 #include "mesh_component.h"
 #include "../tools/memory_utility.h"
 #include "../nodes/d3d_11_mesh.h"
+#include "../nodes/recording_mesh.h"
 #include "../engine/engine.h"
 #include "../engine/d3d_renderer11.h"
 
+#include <algorithm>
+#include <cmath>
+
 const std::string MeshRenderComponent::g_Name = "MeshRenderComponent";
 int MeshRenderComponent::m_last_mesh_id = 0;
+std::unordered_map<std::string, uint64_t> MeshRenderComponent::m_instance_keys;
+std::mutex MeshRenderComponent::m_instance_keys_mutex;
 
 const std::string& MeshRenderComponent::VGetName() const {
 	return g_Name;
 }
 
+StrongActorComponentPtr MeshRenderComponent::VClone() const {
+	return MakePooled<MeshRenderComponent>(*this);
+}
+
+void MeshRenderComponent::VSerializeBinary(BinaryWriter& out) const {
+	BaseRenderComponent::VSerializeBinary(out);
+	out.WriteString(m_pixelShaderResource);
+	out.WriteString(m_vertexShaderResource);
+	out.WriteString(m_instancedVertexShaderResource);
+	out.WriteBool(m_occluder);
+}
+
+bool MeshRenderComponent::VDeserializeBinary(BinaryReader& in, uint32_t version) {
+	if (!BaseRenderComponent::VDeserializeBinary(in, version)) {
+		return false;
+	}
+	m_pixelShaderResource = in.ReadString();
+	m_vertexShaderResource = in.ReadString();
+	if (version >= 2u) {
+		m_instancedVertexShaderResource = in.ReadString();
+	}
+	if (version >= 3u) {
+		m_occluder = in.ReadBool();
+	}
+	return in.IsGood();
+}
+
 MeshRenderComponent::MeshRenderComponent() {}
 
 const std::string& MeshRenderComponent::GetPixelShaderResource() {
@@ -24,6 +58,14 @@ const std::string& MeshRenderComponent::GetVertexShaderResource() {
 	return m_vertexShaderResource;
 }
 
+const std::string& MeshRenderComponent::GetInstancedVertexShaderResource() {
+	return m_instancedVertexShaderResource;
+}
+
+bool MeshRenderComponent::IsOccluder() const {
+	return m_occluder;
+}
+
 const std::vector<D3D11_INPUT_ELEMENT_DESC>& MeshRenderComponent::GetLayout() {
 	return m_vs_layout;
 }
@@ -32,6 +74,23 @@ MeshHolder& MeshRenderComponent::GetMesh(int key){
 	return m_meshes[key];
 }
 
+uint64_t MeshRenderComponent::GetInstanceKey(int key) {
+	if (m_instancedVertexShaderResource.empty()) {
+		return 0u;
+	}
+
+	// The holders keep their asset alive, so a part address is not reused while a mesh drawing it exists. Keys are
+	// handed out in order instead of hashed, two different meshes can never be merged into one draw
+	const MeshHolder& mesh = m_meshes[key];
+	std::string name = std::to_string(reinterpret_cast<uintptr_t>(mesh.pPart)) + "|" + m_vertexShaderResource + "|" + m_pixelShaderResource + "|" + m_instancedVertexShaderResource;
+	std::lock_guard<std::mutex> lock(m_instance_keys_mutex);
+	auto it = m_instance_keys.find(name);
+	if (it == m_instance_keys.end()) {
+		it = m_instance_keys.emplace(std::move(name), static_cast<uint64_t>(m_instance_keys.size()) + 1u).first;
+	}
+	return it->second;
+}
+
 bool MeshRenderComponent::VDelegateInit(TiXmlElement* pData) {
 	TiXmlElement* pPixelShader = pData->FirstChildElement("PixelShader");
 	if (pPixelShader) {
@@ -43,6 +102,17 @@ bool MeshRenderComponent::VDelegateInit(TiXmlElement* pData) {
 		m_vertexShaderResource = pVertexShader->FirstChild()->Value();
 	}
 
+	TiXmlElement* pInstancedVertexShader = pData->FirstChildElement("InstancedVertexShader");
+	if (pInstancedVertexShader) {
+		m_instancedVertexShaderResource = pInstancedVertexShader->FirstChild()->Value();
+	}
+
+	TiXmlElement* pOccluder = pData->FirstChildElement("Occluder");
+	if (pOccluder && pOccluder->FirstChild()) {
+		std::string value = pOccluder->FirstChild()->Value();
+		m_occluder = value == "true" || value == "1";
+	}
+
 	m_vs_layout = {
 		{"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
 		{"COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
@@ -63,93 +133,72 @@ std::shared_ptr<SceneNode> MeshRenderComponent::VCreateSceneNode() {
 	m_resource_directory = pMeshComponent->GetResourceDirecory();
 	
 	std::shared_ptr<SceneNode> root_node(new SceneNode(this, RenderPass::RenderPass_Actor, &pTransformComponent->GetTransform4x4f()));
-	const aiScene* pScene = pMeshComponent->GetScene();
-	ProcessNode(pScene->mRootNode, pScene, root_node);
+	const std::shared_ptr<const MeshAsset>& pAsset = pMeshComponent->GetAsset();
+	if (pAsset) {
+		ProcessNode(pAsset, 0u, root_node);
+	}
 
 	return root_node;
 }
 
 void MeshRenderComponent::VCreateInheritedXmlElements(TiXmlElement* pBaseElement) {}
 
-void MeshRenderComponent::ProcessNode(aiNode* node, const aiScene* scene, std::shared_ptr<SceneNode> parent) {
-	DirectX::XMMATRIX node_transform_matrix = DirectX::XMMatrixTranspose(DirectX::XMMATRIX(&node->mTransformation.a1));
-	for (UINT i = 0; i < node->mNumMeshes; ++i) {
-		aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-		parent->VAddChild(ProcessMesh(mesh, scene, node_transform_matrix));
+void MeshRenderComponent::ProcessNode(const std::shared_ptr<const MeshAsset>& pAsset, uint32_t nodeIndex, std::shared_ptr<SceneNode> parent) {
+	const BakedMeshNode& node = pAsset->GetNode(nodeIndex);
+	DirectX::XMMATRIX node_transform_matrix = DirectX::XMLoadFloat4x4(reinterpret_cast<const DirectX::XMFLOAT4X4*>(node.transform));
+	for (UINT i = 0; i < node.meshCount; ++i) {
+		parent->VAddChild(ProcessMesh(pAsset, pAsset->GetNodeMesh(node, i), node_transform_matrix));
 	}
-	for (UINT i = 0; i < node->mNumChildren; ++i) {
+	for (UINT i = 0; i < node.childCount; ++i) {
 		ActorId owner = this->m_pOwner->GetId();
 		//std::shared_ptr<SceneNode> n = std::make_shared<SceneNode>(this, RenderPass::RenderPass_Actor, node_transform_matrix, DirectX::XMMatrixIdentity(), false);
 		std::shared_ptr<SceneNode> n = std::make_shared<SceneNode>(nullptr, RenderPass::RenderPass_Actor, node_transform_matrix, DirectX::XMMatrixIdentity(), false);
+		// Children first, VAddChild grows the parent radius from the radius the child has at that point
+		ProcessNode(pAsset, node.childBegin + i, n);
 		parent->VAddChild(n);
-		ProcessNode(node->mChildren[i], scene, n);
 	}
 }
 
-std::shared_ptr<SceneNode> MeshRenderComponent::ProcessMesh(aiMesh* mesh, const aiScene* scene, DirectX::FXMMATRIX nodeMatrix) {
-	std::vector<Vertex> vertices;
-	std::vector<DWORD> indices;
-
-	for (UINT i = 0; i < mesh->mNumVertices; ++i) {
-		Vertex vertex;
-		vertex.color = { 0.7f, 0.1f, 0.6f, 1.0f };
-		vertex.pos = { mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z };
-		vertex.normal = { mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z };
-		vertex.tg = { mesh->mTangents[i].x, mesh->mTangents[i].y, mesh->mTangents[i].z };
-		if (mesh->mTextureCoords[0]) {
-			vertex.uv = { (float)mesh->mTextureCoords[0][i].x, (float)mesh->mTextureCoords[0][i].y };
-		}
-		vertices.push_back(vertex);
-	}
-	for (UINT i = 0; i < mesh->mNumFaces; ++i) {
-		aiFace face = mesh->mFaces[i];
-		for (UINT j = 0; j < face.mNumIndices; ++j) {
-			indices.push_back(face.mIndices[j]);
-		}
-	}
+std::shared_ptr<SceneNode> MeshRenderComponent::ProcessMesh(const std::shared_ptr<const MeshAsset>& pAsset, uint32_t partIndex, DirectX::FXMMATRIX nodeMatrix) {
+	const BakedMeshPart& part = pAsset->GetPart(partIndex);
 
-	aiMaterial* material = scene->mMaterials[mesh->mMaterialIndex];
-	D3DRenderer11* renderer = static_cast<D3DRenderer11*>(g_pApp->GetRenderer());
-	std::vector<MaterialTexture> diffuseTextures = LoadMaterialTexures(renderer->GetDevice(), material, aiTextureType::aiTextureType_DIFFUSE, scene);
 	DirectX::XMFLOAT4X4 nodeTransformMatrix4x4f;
 	DirectX::XMStoreFloat4x4(&nodeTransformMatrix4x4f, nodeMatrix);
-	m_meshes[++m_last_mesh_id] = { std::move(vertices), std::move(indices), std::move(diffuseTextures), nodeTransformMatrix4x4f };
-
-	std::shared_ptr<D3D11Mesh> result = std::make_shared<D3D11Mesh>(m_last_mesh_id, this, nodeMatrix, DirectX::XMMatrixIdentity(), true);
-	return result;
-}
 
-TextureStorageType MeshRenderComponent::DetermineTextureStorageType(const aiScene* pScene, aiMaterial* pMat, unsigned int index, aiTextureType textureType) {
-	if (pMat->GetTextureCount(textureType) == 0) {
-		return TextureStorageType::None;
-	}
-
-	aiString path;
-	pMat->GetTexture(textureType, index, &path);
-	std::string texturePath = path.C_Str();
-	if (texturePath[0] == '*') {
-		if (pScene->mTextures[0]->mHeight == 0) {
-			return TextureStorageType::EmbeddedIndexCompressed;
+	std::shared_ptr<SceneNode> pMesh;
+	switch (Engine::GetRendererImpl()) {
+		case Renderer::Renderer_D3D11: {
+			D3DRenderer11* renderer = static_cast<D3DRenderer11*>(g_pApp->GetRenderer());
+			std::vector<MaterialTexture> diffuseTextures = LoadMaterialTexures(renderer->GetDevice(), *pAsset, pAsset->GetMaterial(part.materialIndex));
+			m_meshes[++m_last_mesh_id] = { pAsset, &part, std::move(diffuseTextures), nodeTransformMatrix4x4f };
+			pMesh = std::make_shared<D3D11Mesh>(m_last_mesh_id, this, nodeMatrix, DirectX::XMMatrixIdentity(), true);
 		}
-		else {
-			return TextureStorageType::EmbeddedIndexNonCompressed;
+		break;
+		case Renderer::Renderer_Headless: {
+			// No device to upload textures to
+			m_meshes[++m_last_mesh_id] = { pAsset, &part, std::vector<MaterialTexture>(), nodeTransformMatrix4x4f };
+			pMesh = std::make_shared<RecordingMesh>(m_last_mesh_id, this, nodeMatrix, DirectX::XMMatrixIdentity(), true);
 		}
+		break;
 	}
-
-	if (auto pTex = pScene->GetEmbeddedTexture(texturePath.c_str())) {
-		if (pTex->mHeight == 0) {
-			return TextureStorageType::EmbeddedCompressed;
-		}
-		else {
-			return TextureStorageType::EmbeddedNonCompressed;
-		}
+	if (pMesh) {
+		pMesh->SetRadius(GetBoundingRadius(part, nodeMatrix));
 	}
-
-	return TextureStorageType::Disk;
+	return pMesh;
 }
 
-int MeshRenderComponent::GetTextureIndex(aiString* pString) {
-	return atoi(&pString->C_Str()[1]);
+float MeshRenderComponent::GetBoundingRadius(const BakedMeshPart& part, DirectX::FXMMATRIX nodeMatrix) {
+	// Farthest box corner from the mesh origin, scaled by the largest axis scale of the node
+	DirectX::XMFLOAT3 corner(
+		std::max(std::fabs(part.boundsMin[0]), std::fabs(part.boundsMax[0])),
+		std::max(std::fabs(part.boundsMin[1]), std::fabs(part.boundsMax[1])),
+		std::max(std::fabs(part.boundsMin[2]), std::fabs(part.boundsMax[2]))
+	);
+	float scale = std::max(std::max(
+		DirectX::XMVectorGetX(DirectX::XMVector3Length(nodeMatrix.r[0])),
+		DirectX::XMVectorGetX(DirectX::XMVector3Length(nodeMatrix.r[1]))),
+		DirectX::XMVectorGetX(DirectX::XMVector3Length(nodeMatrix.r[2])));
+	return DirectX::XMVectorGetX(DirectX::XMVector3Length(DirectX::XMLoadFloat3(&corner))) * scale;
 }
 
 DirectX::XMMATRIX MeshRenderComponent::InverseTranspose(DirectX::CXMMATRIX M) {
@@ -166,49 +215,27 @@ DirectX::XMMATRIX MeshRenderComponent::Inverse(DirectX::CXMMATRIX M) {
 	return XMMatrixInverse(&det, A);
 }
 
-std::vector<MaterialTexture> MeshRenderComponent::LoadMaterialTexures(ID3D11Device* device, aiMaterial* pMaterial, aiTextureType textureType, const aiScene* pScene) {
+std::vector<MaterialTexture> MeshRenderComponent::LoadMaterialTexures(ID3D11Device* device, const MeshAsset& asset, const BakedMeshMaterial& material) {
 	std::vector<MaterialTexture> materialTextures;
-	TextureStorageType storeType = TextureStorageType::Invalid;
-	unsigned int textureCount = pMaterial->GetTextureCount(textureType);
-	if (textureCount == 0) {
-		storeType = TextureStorageType::None;
-		aiColor3D aiColor(0.0f, 0.0f, 0.0f);
-		switch (textureType) {
-			case aiTextureType_DIFFUSE: {
-				pMaterial->Get(AI_MATKEY_COLOR_DIFFUSE, aiColor);
-				if (aiColor.IsBlack()) {
-					materialTextures.push_back(MaterialTexture(device, MaterialColors::UnloadedTextureColor, textureType));
-				}
-				else {
-					materialTextures.push_back(MaterialTexture(device, MaterialColor(aiColor.r * 255, aiColor.g * 255, aiColor.b * 255), textureType));
-				}
+	switch (material.source) {
+		case BakedMaterialSource::Color: {
+			if (material.color[0] == 0.0f && material.color[1] == 0.0f && material.color[2] == 0.0f) {
+				materialTextures.push_back(MaterialTexture(device, MaterialColors::UnloadedTextureColor, aiTextureType::aiTextureType_DIFFUSE));
 			}
-			break;
-		}
-	}
-	else {
-		for (UINT i = 0u; i < textureCount; ++i) {
-			aiString path;
-			pMaterial->GetTexture(textureType, i, &path);
-			TextureStorageType store_type = DetermineTextureStorageType(pScene, pMaterial, i, textureType);
-			switch (store_type) {
-				case TextureStorageType::EmbeddedIndexCompressed: {
-					int index = GetTextureIndex(&path);
-					materialTextures.push_back(MaterialTexture(device, reinterpret_cast<uint8_t*>(pScene->mTextures[index]->pcData), pScene->mTextures[index]->mWidth, textureType));
-				}
-				break;
-				case TextureStorageType::EmbeddedCompressed: {
-					const aiTexture* pTexture = pScene->GetEmbeddedTexture(path.C_Str());
-					materialTextures.push_back(MaterialTexture(device, reinterpret_cast<uint8_t*>(pTexture->pcData), pTexture->mWidth, textureType));
-				}
-				break;
-				case TextureStorageType::Disk: {
-					std::string fileName = path.C_Str();
-					materialTextures.push_back(MaterialTexture(device, fileName, textureType));
-				}
-				break;
+			else {
+				materialTextures.push_back(MaterialTexture(device, MaterialColor(material.color[0] * 255, material.color[1] * 255, material.color[2] * 255), aiTextureType::aiTextureType_DIFFUSE));
 			}
 		}
+		break;
+		case BakedMaterialSource::Embedded: {
+			materialTextures.push_back(MaterialTexture(device, asset.GetMaterialData(material), static_cast<size_t>(material.dataSize), aiTextureType::aiTextureType_DIFFUSE));
+		}
+		break;
+		case BakedMaterialSource::Disk: {
+			std::string fileName(reinterpret_cast<const char*>(asset.GetMaterialData(material)), static_cast<size_t>(material.dataSize));
+			materialTextures.push_back(MaterialTexture(device, fileName, aiTextureType::aiTextureType_DIFFUSE));
+		}
+		break;
 	}
 
 	if (materialTextures.size() == 0u) {
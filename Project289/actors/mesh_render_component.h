@@ -5,11 +5,10 @@
 #include <utility>
 #include <vector>
 #include <unordered_map>
+#include <mutex>
 
 #include <DirectXMath.h>
 
-#include <assimp/material.h>
-#include <assimp/scene.h>
 #include <WICTextureLoader.h>
 #include <DDSTextureLoader.h>
 
@@ -17,34 +16,58 @@
 #include "../bindable/vertex_constant_buffer_bindable.h"
 #include "../bindable/pixel_constant_buffer_bindable.h"
 #include "../graphics/material_texture.h"
+#include "../graphics/mesh_asset_cache.h"
 #include "../graphics/constant_buffer_types.h"
 #include "../graphics/vertex.h"
 
+// Geometry is borrowed from the shared MeshAsset, the holder keeps the asset alive while the mesh node exists.
 struct MeshHolder {
-    std::vector<Vertex> vertices;
-    std::vector<DWORD> indices;
+    std::shared_ptr<const MeshAsset> pAsset;
+    const BakedMeshPart* pPart;
     std::vector<MaterialTexture> textures;
     DirectX::XMFLOAT4X4 transform;
+
+    const Vertex* GetVertices() const { return pAsset->GetVertices(*pPart); }
+    size_t GetVertexCount() const { return pPart->vertexCount; }
+    const DWORD* GetIndices() const { return pAsset->GetIndices(*pPart); }
+    size_t GetIndexCount() const { return pPart->indexCount; }
+    const MeshBvh& GetBvh() const { return pAsset->GetBvh(*pPart); }
 };
 
 class MeshRenderComponent : public BaseRenderComponent {
     std::string m_pixelShaderResource;
     std::string m_vertexShaderResource;
+    // Optional, meshes with an instanced vertex shader can be merged into instanced draws.
+    std::string m_instancedVertexShaderResource;
+    // Meshes of an occluder are drawn into the scene's software depth buffer and can hide other actors.
+    bool m_occluder = false;
     std::string m_resource_directory;
 
     std::vector<D3D11_INPUT_ELEMENT_DESC> m_vs_layout;
     std::unordered_map<int, MeshHolder> m_meshes;
     static int m_last_mesh_id;
 
+    static std::unordered_map<std::string, uint64_t> m_instance_keys;
+    static std::mutex m_instance_keys_mutex;
+
 public:
     static const std::string g_Name;
+    static constexpr ComponentId sk_ComponentId = Fnv1a32("MeshRenderComponent");
     virtual const std::string& VGetName() const;
+    virtual StrongActorComponentPtr VClone() const override;
+    virtual void VSerializeBinary(BinaryWriter& out) const override;
+    virtual bool VDeserializeBinary(BinaryReader& in, uint32_t version) override;
 
     MeshRenderComponent();
     const std::string& GetPixelShaderResource();
     const std::string& GetVertexShaderResource();
+    const std::string& GetInstancedVertexShaderResource();
+    bool IsOccluder() const;
     const std::vector<D3D11_INPUT_ELEMENT_DESC>& GetLayout();
     MeshHolder& GetMesh(int key);
+    // Same key for every mesh drawing the same part of the same asset with the same shaders, in any actor. Zero
+    // when there is no instanced vertex shader.
+    uint64_t GetInstanceKey(int key);
 
 protected:
     virtual bool VDelegateInit(TiXmlElement* pData) override;
@@ -52,13 +75,13 @@ protected:
 
     virtual void VCreateInheritedXmlElements(TiXmlElement* pBaseElement) override;
 
-    TextureStorageType DetermineTextureStorageType(const aiScene* pScene, aiMaterial* pMat, unsigned int index, aiTextureType textureType);
-    int GetTextureIndex(aiString* pString);
     static DirectX::XMMATRIX InverseTranspose(DirectX::CXMMATRIX M);
     static DirectX::XMMATRIX Inverse(DirectX::CXMMATRIX M);
+    // Radius around the mesh node origin that holds the part's bounds.
+    static float GetBoundingRadius(const BakedMeshPart& part, DirectX::FXMMATRIX nodeMatrix);
 
-    std::vector<MaterialTexture> LoadMaterialTexures(ID3D11Device* device, aiMaterial* pMaterial, aiTextureType textureType, const aiScene* pScene);
+    std::vector<MaterialTexture> LoadMaterialTexures(ID3D11Device* device, const MeshAsset& asset, const BakedMeshMaterial& material);
 
-    void ProcessNode(aiNode* node, const aiScene* scene, std::shared_ptr<SceneNode> parent);
-    std::shared_ptr<SceneNode> ProcessMesh(aiMesh* mesh, const aiScene* scene, DirectX::FXMMATRIX nodeMatrix);
+    void ProcessNode(const std::shared_ptr<const MeshAsset>& pAsset, uint32_t nodeIndex, std::shared_ptr<SceneNode> parent);
+    std::shared_ptr<SceneNode> ProcessMesh(const std::shared_ptr<const MeshAsset>& pAsset, uint32_t partIndex, DirectX::FXMMATRIX nodeMatrix);
 };
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "particle_component.h"
+#include "../tools/object_pool.h"
 #include "../engine/engine.h"
 #include "transform_component.h"
 #include "../events/evt_data_new_particle_component.h"
@@ -11,6 +12,27 @@ const std::string& ParticleComponent::VGetName() const {
 	return ParticleComponent::g_Name;
 }
 
+StrongActorComponentPtr ParticleComponent::VClone() const {
+	return MakePooled<ParticleComponent>(*this);
+}
+
+void ParticleComponent::VSerializeBinary(BinaryWriter& out) const {
+	out.WriteFloat(m_particle.getInverseMass());
+	out.WriteFloat(m_particle.getDamping());
+	out.WriteFloat(m_particle.getRadius());
+	out.WriteFloat3(m_particle.getVelocity3f());
+	out.WriteFloat3(m_particle.getAcceleration3f());
+}
+
+bool ParticleComponent::VDeserializeBinary(BinaryReader& in, uint32_t version) {
+	m_particle.setInverseMass(in.ReadFloat());
+	m_particle.setDamping(in.ReadFloat());
+	m_particle.setRadius(in.ReadFloat());
+	m_particle.setVelocity3f(in.ReadFloat3());
+	m_particle.setAcceleration3f(in.ReadFloat3());
+	return in.IsGood();
+}
+
 ParticleComponent::ParticleComponent() {
     m_particle.setPosition(0.0f, 0.0f, 0.0f);
     m_particle.setVelocity(0.0f, 0.0f, 0.0f);
@@ -19,10 +41,13 @@ ParticleComponent::ParticleComponent() {
     m_particle.setDamping(0.9f);
     m_particle.setRadius(1.0f);
     m_pGamePhysics = nullptr;
+    m_inPhysicsWorld = false;
 }
 
 ParticleComponent::~ParticleComponent() {
-    m_pGamePhysics->VRemoveParticle(&m_particle);
+    if (m_inPhysicsWorld) {
+        m_pGamePhysics->VRemoveParticle(&m_particle);
+    }
 }
 
 TiXmlElement* ParticleComponent::VGenerateXml() {
@@ -85,6 +110,7 @@ void ParticleComponent::VPostInit() {
 
     std::shared_ptr<EvtData_New_Particle_Component> pEvent(new EvtData_New_Particle_Component(m_pOwner->GetId(), &m_particle));
     IEventManager::Get()->VTriggerEvent(pEvent);
+    m_inPhysicsWorld = true;
 }
 
 void ParticleComponent::VUpdate(float deltaMs) {}
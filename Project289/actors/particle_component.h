@@ -14,6 +14,7 @@ using namespace std::literals;
 class ParticleComponent : public ActorComponent {
 public:
     static const std::string g_Name;
+    static constexpr ComponentId sk_ComponentId = Fnv1a32("ParticleComponent");
     virtual const std::string& VGetName() const override;
 
 public:
@@ -23,6 +24,9 @@ public:
     virtual TiXmlElement* VGenerateXml() override;
 
     virtual bool VInit(TiXmlElement* pData) override;
+    virtual StrongActorComponentPtr VClone() const override;
+    virtual void VSerializeBinary(BinaryWriter& out) const override;
+    virtual bool VDeserializeBinary(BinaryReader& in, uint32_t version) override;
     virtual void VPostInit() override;
     virtual void VUpdate(float deltaMs) override;
 
@@ -32,4 +36,6 @@ public:
 protected:
     Particle m_particle;
     IEnginePhysics* m_pGamePhysics;
+    // Set once VPostInit hands the particle to physics; prototypes and fresh clones of them never get there.
+    bool m_inPhysicsWorld;
 };
\ No newline at end of file
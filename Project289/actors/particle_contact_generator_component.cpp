@@ -1,4 +1,5 @@
 #include "particle_contact_generator_component.h"
+#include "../tools/object_pool.h"
 #include "../events/evt_data_new_particle_contact_generator.h"
 #include "../events/i_event_manager.h"
 
@@ -8,6 +9,27 @@ const std::string& ParticleContactGeneratorComponent::VGetName() const {
 	return ParticleContactGeneratorComponent::g_Name;
 }
 
+StrongActorComponentPtr ParticleContactGeneratorComponent::VClone() const {
+	return MakePooled<ParticleContactGeneratorComponent>(*this);
+}
+
+void ParticleContactGeneratorComponent::VSerializeBinary(BinaryWriter& out) const {
+	out.WriteString(m_contact_generator_type_name);
+	out.WriteFloat(m_ground_level);
+	out.WriteFloat(m_restitution);
+	out.WriteFloat3(m_anchor);
+	out.WriteString(m_particle_name_to_link);
+}
+
+bool ParticleContactGeneratorComponent::VDeserializeBinary(BinaryReader& in, uint32_t version) {
+	m_contact_generator_type_name = in.ReadString();
+	m_ground_level = in.ReadFloat();
+	m_restitution = in.ReadFloat();
+	m_anchor = in.ReadFloat3();
+	m_particle_name_to_link = in.ReadString();
+	return in.IsGood();
+}
+
 ParticleContactGeneratorComponent::ParticleContactGeneratorComponent() {
 	m_contact_generator_type_name = "NoName";
 	m_ground_level = 0.0f;
@@ -19,6 +19,7 @@ using namespace std::literals;
 class ParticleContactGeneratorComponent : public ActorComponent {
 public:
     static const std::string g_Name;
+    static constexpr ComponentId sk_ComponentId = Fnv1a32("ParticleContactGeneratorComponent");
     virtual const std::string& VGetName() const override;
 
 public:
@@ -28,6 +29,9 @@ public:
     virtual TiXmlElement* VGenerateXml() override;
 
     virtual bool VInit(TiXmlElement* pData) override;
+    virtual StrongActorComponentPtr VClone() const override;
+    virtual void VSerializeBinary(BinaryWriter& out) const override;
+    virtual bool VDeserializeBinary(BinaryReader& in, uint32_t version) override;
     virtual void VPostInit() override;
     virtual void VUpdate(float deltaMs) override;
 
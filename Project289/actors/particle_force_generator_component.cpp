@@ -1,4 +1,5 @@
 #include "particle_force_generator_component.h"
+#include "../tools/object_pool.h"
 #include "../events/evt_data_new_particle_force_generator.h"
 #include "../events/i_event_manager.h"
 #include "transform_component.h"
@@ -11,6 +12,21 @@ const std::string& ParticleForceGeneratorComponent::VGetName() const {
     return ParticleForceGeneratorComponent::g_Name;
 }
 
+StrongActorComponentPtr ParticleForceGeneratorComponent::VClone() const {
+    return MakePooled<ParticleForceGeneratorComponent>(*this);
+}
+
+void ParticleForceGeneratorComponent::VSerializeBinary(BinaryWriter& out) const {
+    out.WriteString(m_force_generator_type_name);
+    out.WriteFloat(m_gravity);
+}
+
+bool ParticleForceGeneratorComponent::VDeserializeBinary(BinaryReader& in, uint32_t version) {
+    m_force_generator_type_name = in.ReadString();
+    m_gravity = in.ReadFloat();
+    return in.IsGood();
+}
+
 ParticleForceGeneratorComponent::ParticleForceGeneratorComponent() {
     m_gravity = 9.8f;
 }
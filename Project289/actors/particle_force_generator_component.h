@@ -15,6 +15,7 @@ using namespace std::literals;
 class ParticleForceGeneratorComponent : public ActorComponent {
 public:
     static const std::string g_Name;
+    static constexpr ComponentId sk_ComponentId = Fnv1a32("ParticleForceGeneratorComponent");
     virtual const std::string& VGetName() const override;
 
 public:
@@ -24,6 +25,9 @@ public:
     virtual TiXmlElement* VGenerateXml() override;
 
     virtual bool VInit(TiXmlElement* pData) override;
+    virtual StrongActorComponentPtr VClone() const override;
+    virtual void VSerializeBinary(BinaryWriter& out) const override;
+    virtual bool VDeserializeBinary(BinaryReader& in, uint32_t version) override;
     virtual void VPostInit() override;
     virtual void VUpdate(float deltaMs) override;
 
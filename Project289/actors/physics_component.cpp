@@ -1,4 +1,5 @@
 #include "physics_component.h"
+#include "../tools/object_pool.h"
 #include "../engine/engine.h"
 #include "transform_component.h"
 
@@ -11,6 +12,37 @@ const std::string& PhysicsComponent::VGetName() const {
 	return PhysicsComponent::g_Name;
 }
 
+StrongActorComponentPtr PhysicsComponent::VClone() const {
+	return MakePooled<PhysicsComponent>(*this);
+}
+
+void PhysicsComponent::VSerializeBinary(BinaryWriter& out) const {
+	out.WriteFloat(m_acceleration);
+	out.WriteFloat(m_angularAcceleration);
+	out.WriteFloat(m_maxVelocity);
+	out.WriteFloat(m_maxAngularVelocity);
+	out.WriteString(m_shape);
+	out.WriteString(m_density);
+	out.WriteString(m_material);
+	out.WriteFloat3(m_RigidBodyLocation);
+	out.WriteFloat3(m_RigidBodyOrientation);
+	out.WriteFloat3(m_RigidBodyScale);
+}
+
+bool PhysicsComponent::VDeserializeBinary(BinaryReader& in, uint32_t version) {
+	m_acceleration = in.ReadFloat();
+	m_angularAcceleration = in.ReadFloat();
+	m_maxVelocity = in.ReadFloat();
+	m_maxAngularVelocity = in.ReadFloat();
+	m_shape = in.ReadString();
+	m_density = in.ReadString();
+	m_material = in.ReadString();
+	m_RigidBodyLocation = in.ReadFloat3();
+	m_RigidBodyOrientation = in.ReadFloat3();
+	m_RigidBodyScale = in.ReadFloat3();
+	return in.IsGood();
+}
+
 PhysicsComponent::PhysicsComponent() {
 	m_RigidBodyLocation = DirectX::XMFLOAT3(0.f, 0.f, 0.f);
 	m_RigidBodyOrientation = DirectX::XMFLOAT3(0.f, 0.f, 0.f);
@@ -20,10 +52,16 @@ PhysicsComponent::PhysicsComponent() {
 	m_angularAcceleration = 0;
 	m_maxVelocity = DEFAULT_MAX_VELOCITY;
 	m_maxAngularVelocity = DEFAULT_MAX_ANGULAR_VELOCITY;
+
+	m_pGamePhysics = nullptr;
+	m_physicsActorId = INVALID_ACTOR_ID;
 }
 
 PhysicsComponent::~PhysicsComponent() {
-	m_pGamePhysics->VRemoveActorParticle(m_pOwner->GetId());
+	// Prototype instances never reach VPostInit, so they have no actor to remove.
+	if (m_physicsActorId != INVALID_ACTOR_ID) {
+		m_pGamePhysics->VRemoveActorParticle(m_physicsActorId);
+	}
 }
 
 TiXmlElement* PhysicsComponent::VGenerateXml() {
@@ -100,6 +138,7 @@ bool PhysicsComponent::VInit(TiXmlElement* pData) {
 
 void PhysicsComponent::VPostInit() {
     if (m_pOwner)     {
+        m_physicsActorId = m_pOwner->GetId();
         /*if (m_shape == "Sphere") 		{
             m_pGamePhysics->VAddSphere((float)m_RigidBodyScale.x, m_pOwner, m_density, m_material);
         }
@@ -142,6 +181,10 @@ void PhysicsComponent::VUpdate(float deltaMs) {
     }
 }
 
+bool PhysicsComponent::VRequiresUpdate() const {
+    return true;
+}
+
 void PhysicsComponent::ApplyForce3f(const DirectX::XMFLOAT3& direction, float forceNewtons) {
     //m_pGamePhysics->VApplyForce(DirectX::XMLoadFloat3(&direction), forceNewtons, m_pOwner->GetId());
 }
@@ -13,6 +13,7 @@ using namespace std::literals;
 class PhysicsComponent : public ActorComponent {
 public:
     static const std::string g_Name;
+    static constexpr ComponentId sk_ComponentId = Fnv1a32("PhysicsComponent");
     virtual const std::string& VGetName() const override;
 
 public:
@@ -22,8 +23,12 @@ public:
     virtual TiXmlElement* VGenerateXml() override;
 
     virtual bool VInit(TiXmlElement* pData) override;
+    virtual StrongActorComponentPtr VClone() const override;
+    virtual void VSerializeBinary(BinaryWriter& out) const override;
+    virtual bool VDeserializeBinary(BinaryReader& in, uint32_t version) override;
     virtual void VPostInit() override;
     virtual void VUpdate(float deltaMs) override;
+    virtual bool VRequiresUpdate() const override;
 
     void ApplyForce3f(const DirectX::XMFLOAT3& direction, float forceNewtons);
     void ApplyForce(DirectX::FXMVECTOR direction, float forceNewtons);
@@ -62,4 +67,6 @@ protected:
     DirectX::XMFLOAT3 m_RigidBodyScale;
 
     IEnginePhysics* m_pGamePhysics;
+    // Actor whose particle this component drops from physics, kept because the owner is cleared before destruction.
+    ActorId m_physicsActorId;
 };
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "transform_component.h"
+#include "../tools/object_pool.h"
 
 #include "../tools/string_utility.h"
 
@@ -23,6 +24,28 @@ const std::string& TransformComponent::VGetName() const {
     return g_Name;
 }
 
+StrongActorComponentPtr TransformComponent::VClone() const {
+    return MakePooled<TransformComponent>(*this);
+}
+
+void TransformComponent::VSerializeBinary(BinaryWriter& out) const {
+    out.WriteFloat4x4(m_transform);
+    out.WriteFloat4(m_forward);
+    out.WriteFloat4(m_up);
+    out.WriteFloat4(m_right);
+    out.WriteFloat4(m_scale);
+}
+
+bool TransformComponent::VDeserializeBinary(BinaryReader& in, uint32_t version) {
+    ++m_revision;
+    m_transform = in.ReadFloat4x4();
+    m_forward = in.ReadFloat4();
+    m_up = in.ReadFloat4();
+    m_right = in.ReadFloat4();
+    m_scale = in.ReadFloat4();
+    return in.IsGood();
+}
+
 TiXmlElement* TransformComponent::VGenerateXml() {
     TiXmlElement* pBaseElement = new TiXmlElement(VGetName().c_str());
 
@@ -47,6 +70,10 @@ TiXmlElement* TransformComponent::VGenerateXml() {
     return pBaseElement;
 }
 
+uint32_t TransformComponent::GetRevision() const {
+    return m_revision;
+}
+
 const DirectX::XMFLOAT4X4& TransformComponent::GetTransform4x4f() const {
     return m_transform;
 }
@@ -56,10 +83,12 @@ DirectX::XMMATRIX TransformComponent::GetTransform() const {
 }
 
 void TransformComponent::SetTransform(const DirectX::XMFLOAT4X4& newTransform) {
+    ++m_revision;
     m_transform = newTransform;
 }
 
 void TransformComponent::SetTransform(const DirectX::FXMMATRIX& newTransform) {
+    ++m_revision;
     DirectX::XMStoreFloat4x4(&m_transform, newTransform);
 }
 
@@ -84,6 +113,7 @@ DirectX::XMVECTOR TransformComponent::GetScale() const {
 }
 
 void TransformComponent::SetPosition3f(const DirectX::XMFLOAT3& pos) {
+    ++m_revision;
     m_transform._41 = pos.x;
     m_transform._42 = pos.y;
     m_transform._43 = pos.z;
@@ -91,6 +121,7 @@ void TransformComponent::SetPosition3f(const DirectX::XMFLOAT3& pos) {
 }
 
 void TransformComponent::SetPosition4f(const DirectX::XMFLOAT4& pos) {
+    ++m_revision;
     m_transform._41 = pos.x;
     m_transform._42 = pos.y;
     m_transform._43 = pos.z;
@@ -98,6 +129,7 @@ void TransformComponent::SetPosition4f(const DirectX::XMFLOAT4& pos) {
 }
 
 void TransformComponent::SetPosition4x4f(const DirectX::XMFLOAT4X4& pos) {
+    ++m_revision;
     m_transform._41 = pos._41;
     m_transform._42 = pos._42;
     m_transform._43 = pos._43;
@@ -105,6 +137,7 @@ void TransformComponent::SetPosition4x4f(const DirectX::XMFLOAT4X4& pos) {
 }
 
 void TransformComponent::SetPosition3(const DirectX::FXMVECTOR& pos) {
+    ++m_revision;
     DirectX::XMFLOAT3 temp;
     DirectX::XMStoreFloat3(&temp, pos);
     m_transform._41 = temp.x;
@@ -114,6 +147,7 @@ void TransformComponent::SetPosition3(const DirectX::FXMVECTOR& pos) {
 }
 
 void TransformComponent::SetPosition4(const DirectX::FXMVECTOR& pos) {
+    ++m_revision;
     DirectX::XMFLOAT4 temp;
     DirectX::XMStoreFloat4(&temp, pos);
     m_transform._41 = temp.x;
@@ -203,6 +237,7 @@ DirectX::XMVECTOR TransformComponent::GetRight() const {
 }
 
 bool TransformComponent::Init(TiXmlElement* pData) {
+    ++m_revision;
     DirectX::XMFLOAT3 position;
     TiXmlElement* pPositionElement = pData->FirstChildElement("Position");
     if (pPositionElement) {
@@ -16,8 +16,11 @@ private:
 
     DirectX::XMFLOAT4 m_scale;
 
+    uint32_t m_revision = 0u;
+
 public:
     static const std::string g_Name;
+    static constexpr ComponentId sk_ComponentId = Fnv1a32("TransformComponent");
 
     TransformComponent();
     TransformComponent(TiXmlElement* pData);
@@ -25,6 +28,12 @@ public:
     virtual bool VInit(TiXmlElement* pData) override;
     virtual const std::string& VGetName() const override;
     virtual TiXmlElement* VGenerateXml() override;
+    virtual StrongActorComponentPtr VClone() const override;
+    virtual void VSerializeBinary(BinaryWriter& out) const override;
+    virtual bool VDeserializeBinary(BinaryReader& in, uint32_t version) override;
+
+    // Bumped whenever the matrix changes, scene nodes compare it instead of copying the transform every frame.
+    uint32_t GetRevision() const;
 
     // transform functions
     const DirectX::XMFLOAT4X4& GetTransform4x4f() const;
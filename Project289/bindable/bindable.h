@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <d3d11.h>
 #include <wrl.h>
 
@@ -19,8 +21,13 @@ enum class BindableType {
 	vertex_shader
 };
 
+constexpr size_t BindableTypeCount = static_cast<size_t>(BindableType::vertex_shader) + 1u;
+
 class Bindable {
 public:
 	virtual void Bind(ID3D11DeviceContext* deviceContext) = 0;
+	// Identifies the GPU object this binds. Bindables with the same id in the same slot are interchangeable, which
+	// lets the render queue skip the bind when the previous draw already set that state.
+	virtual uint64_t GetStateId() const { return reinterpret_cast<uintptr_t>(this); }
 	virtual ~Bindable() = default;
 };
\ No newline at end of file
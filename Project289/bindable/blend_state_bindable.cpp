@@ -20,3 +20,7 @@ void BlendStateBindable::Bind(ID3D11DeviceContext* deviceContext) {
 	float blendFactor[] = { 0.0f, 0.0f, 0.0f, 0.0f };
 	deviceContext->OMSetBlendState(m_blendState.Get(), blendFactor, 0xffffffff);
 }
+
+uint64_t BlendStateBindable::GetStateId() const {
+	return reinterpret_cast<uintptr_t>(m_blendState.Get());
+}
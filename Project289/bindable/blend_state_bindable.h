@@ -12,6 +12,7 @@ public:
 	BlendStateBindable(ID3D11Device* device);
 	BlendStateBindable(ID3D11Device* device, const D3D11_BLEND_DESC& blendDesc);
 	void Bind(ID3D11DeviceContext* deviceContext) override;
+	uint64_t GetStateId() const override;
 
 protected:
 	Microsoft::WRL::ComPtr<ID3D11BlendState> m_blendState;
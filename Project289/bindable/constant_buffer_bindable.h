@@ -7,8 +7,23 @@
 #include "../tools/memory_utility.h"
 #include "../tools/com_exception.h"
 
+// Layout independent part of a constant buffer, so a renderer can upload bytes without knowing the struct.
+class ConstantBufferBindableBase : public Bindable {
+public:
+	void UpdateBytes(ID3D11DeviceContext* deviceContext, const void* pData, size_t size) {
+		D3D11_MAPPED_SUBRESOURCE msr;
+		HRESULT hr = deviceContext->Map(pConstantBuffer.Get(), 0u, D3D11_MAP_WRITE_DISCARD, 0u, &msr);
+		COM_ERROR_IF_FAILED(hr, "Failed to update constant buffer");
+		memcpy(msr.pData, pData, size);
+		deviceContext->Unmap(pConstantBuffer.Get(), 0u);
+	}
+
+protected:
+	Microsoft::WRL::ComPtr<ID3D11Buffer> pConstantBuffer;
+};
+
 template <typename T>
-class ConstantBufferBindable : public Bindable {
+class ConstantBufferBindable : public ConstantBufferBindableBase {
 public:
 	ConstantBufferBindable(ID3D11Device* device, const T& consts) {
 		D3D11_BUFFER_DESC cbd;
@@ -38,13 +53,6 @@ public:
 	}
 
 	void Update(ID3D11DeviceContext* deviceContext, const T& consts) {
-		D3D11_MAPPED_SUBRESOURCE msr;
-		HRESULT hr = deviceContext->Map(pConstantBuffer.Get(), 0u, D3D11_MAP_WRITE_DISCARD, 0u, &msr);
-		COM_ERROR_IF_FAILED(hr, "Failed to update constant buffer");
-		memcpy(msr.pData, &consts, sizeof(consts));
-		deviceContext->Unmap(pConstantBuffer.Get(), 0u);
+		UpdateBytes(deviceContext, &consts, sizeof(consts));
 	}
-
-protected:
-	Microsoft::WRL::ComPtr<ID3D11Buffer> pConstantBuffer;
 };
\ No newline at end of file
@@ -32,3 +32,7 @@ DepthStencilStateBindable::DepthStencilStateBindable(ID3D11Device* device, const
 void DepthStencilStateBindable::Bind(ID3D11DeviceContext* deviceContext) {
 	deviceContext->OMSetDepthStencilState(m_depthStencilState.Get(), 1);
 }
+
+uint64_t DepthStencilStateBindable::GetStateId() const {
+	return reinterpret_cast<uintptr_t>(m_depthStencilState.Get());
+}
@@ -12,6 +12,7 @@ public:
 	DepthStencilStateBindable(ID3D11Device* device);
 	DepthStencilStateBindable(ID3D11Device* device, const D3D11_DEPTH_STENCIL_DESC& depthStencilDesc);
 	void Bind(ID3D11DeviceContext* deviceContext) override;
+	uint64_t GetStateId() const override;
 
 protected:
 	Microsoft::WRL::ComPtr<ID3D11DepthStencilState>	m_depthStencilState;
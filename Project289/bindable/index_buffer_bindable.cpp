@@ -1,6 +1,8 @@
 #include "index_buffer_bindable.h"
 
-IndexBufferBindable::IndexBufferBindable(ID3D11Device* device, const std::vector<DWORD>& indices) : count((UINT)indices.size()) {
+IndexBufferBindable::IndexBufferBindable(ID3D11Device* device, const std::vector<DWORD>& indices) : IndexBufferBindable(device, indices.data(), indices.size()) {}
+
+IndexBufferBindable::IndexBufferBindable(ID3D11Device* device, const DWORD* pIndices, size_t indexCount) : count((UINT)indexCount) {
 
 	D3D11_BUFFER_DESC ibd = {};
 	ibd.BindFlags = D3D11_BIND_INDEX_BUFFER;
@@ -11,7 +13,7 @@ IndexBufferBindable::IndexBufferBindable(ID3D11Device* device, const std::vector
 	ibd.StructureByteStride = sizeof(DWORD);
 
 	D3D11_SUBRESOURCE_DATA isd = {};
-	isd.pSysMem = indices.data();
+	isd.pSysMem = pIndices;
 
 	HRESULT hr = device->CreateBuffer(&ibd, &isd, &pIndexBuffer);
 	COM_ERROR_IF_FAILED(hr, "Failed to create index buffer");
@@ -21,6 +23,10 @@ void IndexBufferBindable::Bind(ID3D11DeviceContext* deviceContext) {
 	deviceContext->IASetIndexBuffer(pIndexBuffer.Get(), DXGI_FORMAT_R32_UINT, 0u);
 }
 
+uint64_t IndexBufferBindable::GetStateId() const {
+	return reinterpret_cast<uintptr_t>(pIndexBuffer.Get());
+}
+
 UINT IndexBufferBindable::GetCount() const {
 	return count;
 }
\ No newline at end of file
@@ -11,8 +11,10 @@
 class IndexBufferBindable : public Bindable {
 public:
 	IndexBufferBindable(ID3D11Device* device, const std::vector<DWORD>& indices);
+	IndexBufferBindable(ID3D11Device* device, const DWORD* pIndices, size_t indexCount);
 
 	void Bind(ID3D11DeviceContext* deviceContext) override;
+	uint64_t GetStateId() const override;
 	UINT GetCount() const;
 
 protected:
@@ -54,4 +54,8 @@ InputLayoutBindable::InputLayoutBindable(ID3D11Device* device, const std::vector
 
 void InputLayoutBindable::Bind(ID3D11DeviceContext* deviceContext) noexcept {
 	deviceContext->IASetInputLayout(pInputLayout.Get());
+}
+
+uint64_t InputLayoutBindable::GetStateId() const {
+	return reinterpret_cast<uintptr_t>(pInputLayout.Get());
 }
\ No newline at end of file
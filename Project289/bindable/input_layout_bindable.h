@@ -13,6 +13,7 @@ public:
 	InputLayoutBindable(ID3D11Device* device, ID3DBlob* pVertexShaderBytecode);
 	InputLayoutBindable(ID3D11Device* device, const std::vector<D3D11_INPUT_ELEMENT_DESC>& layout, ID3DBlob* pVertexShaderBytecode);
 	void Bind(ID3D11DeviceContext* deviceContext) noexcept override;
+	uint64_t GetStateId() const override;
 
 protected:
 	Microsoft::WRL::ComPtr<ID3D11InputLayout> pInputLayout;
@@ -0,0 +1,11 @@
+#include "null_bindable.h"
+
+NullBindable::NullBindable() : m_state_id(reinterpret_cast<uintptr_t>(this)) {}
+
+NullBindable::NullBindable(uint64_t stateId) : m_state_id(stateId) {}
+
+void NullBindable::Bind(ID3D11DeviceContext* deviceContext) {}
+
+uint64_t NullBindable::GetStateId() const {
+	return m_state_id;
+}
\ No newline at end of file
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <d3d11.h>
+#include <wrl.h>
+
+#include "bindable.h"
+
+// Bindable without a GPU object, used when there is no device. It only carries a state id, so draws still batch the
+// way the real bindables would.
+class NullBindable : public Bindable {
+public:
+	// Unique state, like a buffer or a shader created per mesh.
+	NullBindable();
+	// Shared state, like the state objects D3D11 hands out once per description.
+	explicit NullBindable(uint64_t stateId);
+	void Bind(ID3D11DeviceContext* deviceContext) override;
+	uint64_t GetStateId() const override;
+protected:
+	uint64_t m_state_id;
+};
\ No newline at end of file
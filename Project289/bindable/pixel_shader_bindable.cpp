@@ -9,6 +9,10 @@ void PixelShaderBindable::Bind(ID3D11DeviceContext* deviceContext) {
 	deviceContext->PSSetShader(m_pPixelShader, nullptr, 0u);
 }
 
+uint64_t PixelShaderBindable::GetStateId() const {
+	return reinterpret_cast<uintptr_t>(m_pPixelShader);
+}
+
 ID3DBlob* PixelShaderBindable::GetBytecode() const {
 	return m_pBytecodeBlob;
 }
\ No newline at end of file
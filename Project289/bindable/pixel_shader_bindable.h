@@ -14,6 +14,7 @@ class PixelShaderBindable : public Bindable {
 public:
 	PixelShaderBindable(ID3D11Device* device, ID3DBlob* pBytecodeBlob, ID3D11PixelShader* pPixelShader);
 	void Bind(ID3D11DeviceContext* deviceContext) override;
+	uint64_t GetStateId() const override;
 	ID3DBlob* GetBytecode() const;
 
 protected:
@@ -26,3 +26,7 @@ RasterizerStateBindable::RasterizerStateBindable(ID3D11Device* device, const D3D
 void RasterizerStateBindable::Bind(ID3D11DeviceContext* deviceContext) {
 	deviceContext->RSSetState(m_rasterState.Get());
 }
+
+uint64_t RasterizerStateBindable::GetStateId() const {
+	return reinterpret_cast<uintptr_t>(m_rasterState.Get());
+}
@@ -12,6 +12,7 @@ public:
 	RasterizerStateBindable(ID3D11Device* device);
 	RasterizerStateBindable(ID3D11Device* device, const D3D11_RASTERIZER_DESC& rasterDesc);
 	void Bind(ID3D11DeviceContext* deviceContext) override;
+	uint64_t GetStateId() const override;
 
 protected:
 	Microsoft::WRL::ComPtr<ID3D11RasterizerState> m_rasterState;
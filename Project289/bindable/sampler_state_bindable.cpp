@@ -28,4 +28,8 @@ SamplerStateBindable::SamplerStateBindable(ID3D11Device* device, const 	D3D11_SA
 
 void SamplerStateBindable::Bind(ID3D11DeviceContext* deviceContext) {
 	deviceContext->PSSetSamplers(0, 1, m_sampleState.GetAddressOf());
+}
+
+uint64_t SamplerStateBindable::GetStateId() const {
+	return reinterpret_cast<uintptr_t>(m_sampleState.Get());
 }
\ No newline at end of file
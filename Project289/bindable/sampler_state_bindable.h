@@ -12,6 +12,7 @@ public:
 	SamplerStateBindable(ID3D11Device* device);
 	SamplerStateBindable(ID3D11Device* device, const D3D11_SAMPLER_DESC& samplerDesc);
 	void Bind(ID3D11DeviceContext* deviceContext) override;
+	uint64_t GetStateId() const override;
 protected:
 	Microsoft::WRL::ComPtr<ID3D11SamplerState> m_sampleState;
 };
\ No newline at end of file
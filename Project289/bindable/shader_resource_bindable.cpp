@@ -6,4 +6,8 @@ ShaderResourceBindable::ShaderResourceBindable(ID3D11Device* device, ID3D11Shade
 
 void ShaderResourceBindable::Bind(ID3D11DeviceContext* deviceContext) {
 	deviceContext->PSSetShaderResources(m_startSlot, 1, &srv);
+}
+
+uint64_t ShaderResourceBindable::GetStateId() const {
+	return reinterpret_cast<uintptr_t>(srv);
 }
\ No newline at end of file
@@ -12,6 +12,7 @@ public:
 	ShaderResourceBindable(ID3D11Device* device, ID3D11ShaderResourceView* srv);
 	ShaderResourceBindable(ID3D11Device* device, ID3D11ShaderResourceView* srv, unsigned int startSlot);
 	void Bind(ID3D11DeviceContext* deviceContext) override;
+	uint64_t GetStateId() const override;
 protected:
 	ID3D11ShaderResourceView* srv;
 	unsigned int m_startSlot;
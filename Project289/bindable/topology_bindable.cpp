@@ -4,4 +4,8 @@ TopologyBindable::TopologyBindable(ID3D11Device* device, D3D11_PRIMITIVE_TOPOLOG
 
 void TopologyBindable::Bind(ID3D11DeviceContext* deviceContext) {
 	deviceContext->IASetPrimitiveTopology(type);
+}
+
+uint64_t TopologyBindable::GetStateId() const {
+	return static_cast<uint64_t>(type);
 }
\ No newline at end of file
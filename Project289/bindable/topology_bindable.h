@@ -10,6 +10,7 @@ class TopologyBindable : public Bindable {
 public:
 	TopologyBindable(ID3D11Device* device, D3D11_PRIMITIVE_TOPOLOGY type);
 	void Bind(ID3D11DeviceContext* deviceContext) override;
+	uint64_t GetStateId() const override;
 protected:
 	D3D11_PRIMITIVE_TOPOLOGY type;
 };
\ No newline at end of file
@@ -3,4 +3,8 @@
 void VertexBufferBindable::Bind(ID3D11DeviceContext* deviceContext) {
 	const UINT offset = 0u;
 	deviceContext->IASetVertexBuffers(0u, 1u, pVertexBuffer.GetAddressOf(), &stride, &offset);
+}
+
+uint64_t VertexBufferBindable::GetStateId() const {
+	return reinterpret_cast<uintptr_t>(pVertexBuffer.Get());
 }
\ No newline at end of file
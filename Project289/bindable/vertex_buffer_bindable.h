@@ -12,22 +12,26 @@ class VertexBufferBindable : public Bindable {
 public:
 
 	template<class V>
-	VertexBufferBindable(ID3D11Device* device, const std::vector<V>& vertices) : stride(sizeof(V)) {
+	VertexBufferBindable(ID3D11Device* device, const std::vector<V>& vertices) : VertexBufferBindable(device, vertices.data(), vertices.size()) {}
+
+	// Uploads straight from memory the caller owns, e.g. a mapped baked mesh
+	template<class V>
+	VertexBufferBindable(ID3D11Device* device, const V* pVertices, size_t count) : stride(sizeof(V)) {
 		D3D11_BUFFER_DESC bd = {};
 		bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
 		bd.Usage = D3D11_USAGE_DEFAULT;
 		bd.CPUAccessFlags = 0u;
 		bd.MiscFlags = 0u;
-		bd.ByteWidth = UINT(sizeof(V) * vertices.size());
+		bd.ByteWidth = UINT(sizeof(V) * count);
 		bd.StructureByteStride = sizeof(V);
 		D3D11_SUBRESOURCE_DATA sd = {};
-		sd.pSysMem = vertices.data();
+		sd.pSysMem = pVertices;
 
-		HRESULT hr = device->CreateBuffer(&bd, &sd, &pVertexBuffer);
 		COM_ERROR_IF_FAILED(device->CreateBuffer(&bd, &sd, &pVertexBuffer), "Failed to create vertex buffer");
 	}
 
 	void Bind(ID3D11DeviceContext* deviceContext) override;
+	uint64_t GetStateId() const override;
 
 protected:
 	UINT stride;
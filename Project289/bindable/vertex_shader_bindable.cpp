@@ -9,6 +9,10 @@ void VertexShaderBindable::Bind(ID3D11DeviceContext* deviceContext) {
 	deviceContext->VSSetShader(m_pVertexShader, nullptr, 0u);
 }
 
+uint64_t VertexShaderBindable::GetStateId() const {
+	return reinterpret_cast<uintptr_t>(m_pVertexShader);
+}
+
 ID3DBlob* VertexShaderBindable::GetBytecode() const {
 	return m_pBytecodeBlob;
 }
\ No newline at end of file
@@ -13,6 +13,7 @@ class VertexShaderBindable : public Bindable {
 public:
 	VertexShaderBindable(ID3D11Device* device, ID3DBlob* pBytecodeBlob, ID3D11VertexShader* pVertexShader);
 	void Bind(ID3D11DeviceContext* deviceContext) override;
+	uint64_t GetStateId() const override;
 	ID3DBlob* GetBytecode() const;
 
 protected:
@@ -0,0 +1,41 @@
+// vertex_shader.hlsl with the per object transforms read from the instance buffer, indexed by SV_InstanceID.
+cbuffer perFrameBuffer : register(b1) {
+	float4x4 viewProjMatrix;
+};
+
+struct InstanceData {
+	float4x4 worldMatrix;
+	float4x4 invWorldMatrix;
+};
+
+StructuredBuffer<InstanceData> instances : register(t0);
+
+struct VS_INPUT {
+	float3 pos : POSITION;
+	float4 color : COLOR;
+	float2 uv : TEXCOORD;
+	float3 normal : NORMAL;
+	float3 tg : TANGENT;
+	uint instanceId : SV_InstanceID;
+};
+
+struct VS_OUTPUT {
+	float4 pos : SV_POSITION;
+	float3 color : COLOR;
+	float2 uv : TEXCOORD;
+	float3 normal : NORMAL;
+	float3 worldPos : WORLD_POSITION;
+};
+
+VS_OUTPUT main(VS_INPUT input) {
+	InstanceData instance = instances[input.instanceId];
+	float4 worldPos = mul(float4(input.pos, 1.0f), instance.worldMatrix);
+
+	VS_OUTPUT output;
+	output.pos = mul(worldPos, viewProjMatrix);
+	output.color = input.color;
+	output.uv = input.uv;
+	output.normal = mul(float4(input.normal, 0.0f), instance.invWorldMatrix);
+	output.worldPos = worldPos;
+	return output;
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include "archive_benchmark.h"
+#include "benchmark_stage.h"
+#include "engine.h"
+#include "../events/i_event_manager.h"
+#include "../tools/binary_stream.h"
+#include "../tools/tinyxml/tinyxml.h"
+
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+namespace {
+	void ReportStage(std::ostringstream& out, const BenchmarkStage& stage, int count, int repeats) {
+		double avg = stage.total / repeats;
+		out << stage.name << ": avg " << avg << " ms, min " << stage.min << " ms, max " << stage.max << " ms, " << (avg > 0.0 ? count * 1000.0 / avg : 0.0) << " actors/s\n";
+	}
+}
+
+std::string BenchmarkArchive(const std::string& actorResource, int count, int repeats) {
+	BaseEngineLogic* pGame = g_pApp->GetGameLogic();
+	std::ostringstream out;
+	out << std::fixed << std::setprecision(3);
+
+	std::vector<ActorId> ids;
+	ids.reserve(static_cast<size_t>(count));
+	for (int i = 0; i < count; ++i) {
+		StrongActorPtr pActor = pGame->VCreateActor(actorResource, nullptr, DirectX::XMMatrixTranslation(static_cast<float>(i % 100), 0.0f, static_cast<float>(i / 100)));
+		if (!pActor) {
+			out << "failed to create " << actorResource << "\n";
+			return out.str();
+		}
+		ids.push_back(pActor->GetId());
+	}
+	out << actorResource << ", actors: " << count << ", repeats: " << repeats << "\n";
+
+	BenchmarkStage xmlSave{ "xml save" };
+	BenchmarkStage xmlLoad{ "xml load" };
+	BenchmarkStage binarySave{ "binary save" };
+	BenchmarkStage binaryLoad{ "binary load" };
+	std::vector<std::string> xml(ids.size());
+	BinaryWriter writer;
+
+	for (int repeat = 0; repeat < repeats; ++repeat) {
+		gameTimePoint start = gameClock::now();
+		for (size_t i = 0u; i < ids.size(); ++i) {
+			xml[i] = pGame->GetActorXml(ids[i]);
+		}
+		xmlSave.Add(ElapsedMs(start, gameClock::now()), repeat);
+
+		// Each actor is replaced under its own id, the same as LoadActorsBinary does
+		start = gameClock::now();
+		for (size_t i = 0u; i < ids.size(); ++i) {
+			TiXmlDocument document;
+			document.Parse(xml[i].c_str());
+			TiXmlElement* pRoot = document.RootElement();
+			if (!pRoot) {
+				continue;
+			}
+			pGame->VDestroyActor(ids[i]);
+			pGame->VCreateActor(pRoot->Attribute("resource"), pRoot, nullptr, ids[i]);
+		}
+		xmlLoad.Add(ElapsedMs(start, gameClock::now()), repeat);
+		IEventManager::Get()->VUpdate();
+
+		writer.Clear();
+		start = gameClock::now();
+		pGame->SaveActorsBinary(writer);
+		binarySave.Add(ElapsedMs(start, gameClock::now()), repeat);
+
+		BinaryReader reader(writer.GetData(), writer.GetSize());
+		start = gameClock::now();
+		if (!pGame->LoadActorsBinary(reader)) {
+			out << "binary load failed\n";
+			return out.str();
+		}
+		binaryLoad.Add(ElapsedMs(start, gameClock::now()), repeat);
+		IEventManager::Get()->VUpdate();
+	}
+
+	size_t xmlBytes = 0u;
+	for (const std::string& actorXml : xml) {
+		xmlBytes += actorXml.size();
+	}
+
+	for (const BenchmarkStage* pStage : { &xmlSave, &xmlLoad, &binarySave, &binaryLoad }) {
+		ReportStage(out, *pStage, count, repeats);
+	}
+	out << "xml: " << xmlBytes << " bytes, binary: " << writer.GetSize() << " bytes\n";
+	return out.str();
+}
\ No newline at end of file
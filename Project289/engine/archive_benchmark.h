@@ -0,0 +1,9 @@
+#pragma once
+
+#include <string>
+
+// Spawns count actors from the template into the game logic and times saving and reloading all of them repeats times
+// as per actor XML, the way GetActorXml and VCreateActor with overrides would round trip them, and through the binary
+// archive of SaveActorsBinary and LoadActorsBinary. Reports actors per second and archive sizes. Needs an initialized
+// engine.
+std::string BenchmarkArchive(const std::string& actorResource, int count, int repeats);
\ No newline at end of file
@@ -7,13 +7,14 @@
 #include "../events/evt_data_environment_loaded.h"
 #include "../events/evt_data_move_actor.h"
 #include "../actors/actor_factory.h"
+#include "../actors/actor_archive.h"
 #include "i_engine_view.h"
 #include "engine.h"
 
 BaseEngineLogic::BaseEngineLogic() {
 	m_last_actor_id = 0;
 	m_life_time = 0;
-	m_process_manager = std::make_unique<ProcessManager>();
+	m_process_manager = std::make_unique<ProcessManager>(g_pApp ? g_pApp->GetJobSystem() : nullptr);
 	m_random.Randomize();
 	m_state = BaseEngineState::BGS_Initializing;
 	m_render_diagnostics = false;
@@ -24,6 +25,8 @@ BaseEngineLogic::BaseEngineLogic() {
 
 	m_level_manager = std::make_unique<LevelManager>();
 	m_level_manager->Initialize();
+
+	m_component_store = std::make_unique<ComponentStore>();
 }
 
 BaseEngineLogic::~BaseEngineLogic() {
@@ -31,6 +34,7 @@ BaseEngineLogic::~BaseEngineLogic() {
 		m_game_views.pop_front();
 	}
 
+	m_component_store->Clear();
 	for (auto it = m_actors.begin(); it != m_actors.end(); ++it) {
 		it->second->Destroy();
 	}
@@ -77,6 +81,7 @@ StrongActorPtr BaseEngineLogic::VCreateActor(const std::string& actorResource, T
 	StrongActorPtr pActor = m_actor_factory->CreateActor(actorResource, overrides, initialTransform, serversActorId);
 	if (pActor) {
 		m_actors.insert(std::make_pair(pActor->GetId(), pActor));
+		m_component_store->AddActor(*pActor);
 		if (pActor->GetName() != "NoName") { m_actors_names.insert(std::make_pair(pActor->GetName(), pActor)); }
 		return pActor;
 	}
@@ -91,6 +96,7 @@ void BaseEngineLogic::VDestroyActor(const ActorId actorId) {
 
 	auto findIt = m_actors.find(actorId);
 	if (findIt != m_actors.end()) {
+		m_component_store->RemoveActor(*findIt->second);
 		findIt->second->Destroy();
 		if (findIt->second->GetName() != "NoName") {
 			m_actors_names.erase(findIt->second->GetName());
@@ -121,6 +127,7 @@ void BaseEngineLogic::VModifyActor(const ActorId actorId, TiXmlElement* override
 	auto findIt = m_actors.find(actorId);
 	if (findIt != m_actors.end()) {
 		m_actor_factory->ModifyActor(findIt->second, overrides);
+		m_component_store->AddActor(*findIt->second);
 	}
 }
 
@@ -137,32 +144,54 @@ std::string BaseEngineLogic::GetActorXml(const ActorId id) {
 	return std::string();
 }
 
-const LevelManager* BaseEngineLogic::GetLevelManager() {
-	return m_level_manager.get();
+void BaseEngineLogic::SaveActorsBinary(BinaryWriter& out) {
+	WriteActorArchiveHeader(out, static_cast<uint32_t>(m_actors.size()));
+	for (auto it = m_actors.begin(); it != m_actors.end(); ++it) {
+		it->second->ToBinary(out);
+	}
 }
 
-bool BaseEngineLogic::VLoadGame(const char* levelResource) {
-	TiXmlDocument xml;
-	xml.LoadFile(levelResource);
-
-	TiXmlElement* pRoot = xml.RootElement();
-	if (!pRoot) {
+bool BaseEngineLogic::LoadActorsBinary(BinaryReader& in) {
+	uint32_t version = 0u;
+	uint32_t actorCount = 0u;
+	if (!m_actor_factory || !ReadActorArchiveHeader(in, version, actorCount)) {
 		return false;
 	}
 
-	TiXmlElement* pActorsNode = pRoot->FirstChildElement("Actors");
-	if (pActorsNode) {
-		for (TiXmlElement* pNode = pActorsNode->FirstChildElement(); pNode; pNode = pNode->NextSiblingElement()) {
-			const char* actorResource = pNode->Attribute("resource");
+	std::vector<StrongActorComponentPtr> changedComponents;
+	for (uint32_t i = 0u; i < actorCount && in.IsGood(); ++i) {
+		changedComponents.clear();
+		StrongActorPtr pActor = m_actor_factory->BuildActorFromBinary(in, version, changedComponents);
+		if (!pActor) {
+			continue;
+		}
 
-			StrongActorPtr pActor = VCreateActor(actorResource, pNode, nullptr);
-			if (pActor) {
-				std::shared_ptr<EvtData_New_Actor> pNewActorEvent(new EvtData_New_Actor(pActor->GetId()));
-				IEventManager::Get()->VQueueEvent(pNewActorEvent);
-			}
+		// The old actor has to be gone before PostInit registers the new one under the same id
+		if (m_actors.find(pActor->GetId()) != m_actors.end()) {
+			VDestroyActor(pActor->GetId());
 		}
+		m_actor_factory->FinishActor(pActor, changedComponents);
+		CommitLoadedActor(pActor);
 	}
 
+	return in.IsGood();
+}
+
+const LevelManager* BaseEngineLogic::GetLevelManager() {
+	return m_level_manager.get();
+}
+
+ComponentStore* BaseEngineLogic::GetComponentStore() {
+	return m_component_store.get();
+}
+
+bool BaseEngineLogic::VLoadGame(const char* levelResource) {
+	LevelLoader loader(m_actor_factory.get(), g_pApp ? g_pApp->GetJobSystem() : nullptr);
+	if (!LoadLevelActors(loader, levelResource)) {
+		return false;
+	}
+	TiXmlElement* pRoot = loader.GetRoot();
+
 	for (auto it = m_game_views.begin(); it != m_game_views.end(); ++it) {
 		std::shared_ptr<IEngineView> pView = *it;
 		if (pView->VGetType() == EngineViewType::GameView_Human) {
@@ -180,26 +209,11 @@ bool BaseEngineLogic::VLoadGame(const char* levelResource) {
 }
 
 bool BaseEngineLogic::VLoadGame(const char* levelResource, std::shared_ptr<HumanView> pHumanView) {
-	TiXmlDocument xml;
-	xml.LoadFile(levelResource);
-
-	TiXmlElement* pRoot = xml.RootElement();
-	if (!pRoot) {
+	LevelLoader loader(m_actor_factory.get(), g_pApp ? g_pApp->GetJobSystem() : nullptr);
+	if (!LoadLevelActors(loader, levelResource)) {
 		return false;
 	}
-
-	TiXmlElement* pActorsNode = pRoot->FirstChildElement("Actors");
-	if (pActorsNode) {
-		for (TiXmlElement* pNode = pActorsNode->FirstChildElement(); pNode; pNode = pNode->NextSiblingElement()) {
-			const char* actorResource = pNode->Attribute("resource");
-
-			StrongActorPtr pActor = VCreateActor(actorResource, pNode, nullptr);
-			if (pActor) {
-				std::shared_ptr<EvtData_New_Actor> pNewActorEvent(new EvtData_New_Actor(pActor->GetId()));
-				IEventManager::Get()->VQueueEvent(pNewActorEvent);
-			}
-		}
-	}
+	TiXmlElement* pRoot = loader.GetRoot();
 
 	pHumanView->LoadGame(pRoot);
 	if (!VLoadGameDelegate(pRoot)) { return false; }
@@ -236,9 +250,7 @@ void BaseEngineLogic::VOnUpdate(float time, float elapsedTime) {
 		(*it)->VOnUpdate(elapsedTime);
 	}
 
-	for (ActorMap::const_iterator it = m_actors.begin(); it != m_actors.end(); ++it)     {
-		it->second->Update(elapsedTime);
-	}
+	m_component_store->Update(elapsedTime);
 }
 
 void BaseEngineLogic::VChangeState(BaseEngineState newState) {
@@ -279,6 +291,29 @@ bool BaseEngineLogic::VLoadGameDelegate(TiXmlElement* pLevelData) {
 	return true;
 }
 
+bool BaseEngineLogic::LoadLevelActors(LevelLoader& loader, const char* levelResource) {
+	if (!loader.Open(levelResource)) {
+		return false;
+	}
+
+	loader.Wait();
+	while (loader.HasUncommitted()) {
+		CommitLoadedActor(loader.CommitNext());
+	}
+	return true;
+}
+
+void BaseEngineLogic::CommitLoadedActor(StrongActorPtr pActor) {
+	if (!pActor) { return; }
+
+	m_actors.insert(std::make_pair(pActor->GetId(), pActor));
+	m_component_store->AddActor(*pActor);
+	if (pActor->GetName() != "NoName") { m_actors_names.insert(std::make_pair(pActor->GetName(), pActor)); }
+
+	std::shared_ptr<EvtData_New_Actor> pNewActorEvent(new EvtData_New_Actor(pActor->GetId()));
+	IEventManager::Get()->VQueueEvent(pNewActorEvent);
+}
+
 void BaseEngineLogic::MoveActorDelegate(IEventDataPtr pEventData) {
 	std::shared_ptr<EvtData_Move_Actor> pCastEventData = std::static_pointer_cast<EvtData_Move_Actor>(pEventData);
 	VMoveActor(pCastEventData->GetId(), pCastEventData->GetMatrix());
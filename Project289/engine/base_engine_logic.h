@@ -7,6 +7,7 @@
 #include <DirectXMath.h>
 
 #include "../actors/actor.h"
+#include "../actors/component_store.h"
 #include "level_manager.h"
 #include "i_engine_logic.h"
 #include "../processes/process_manager.h"
@@ -16,6 +17,7 @@
 #include "i_engine_physics.h"
 #include "../events/i_event_data.h"
 #include "human_view.h"
+#include "level_loader.h"
 
 class ActorFactory;
 class LevelManager;
@@ -24,6 +26,7 @@ typedef std::unordered_map<ActorId, StrongActorPtr> ActorMap;
 
 class BaseEngineLogic : IEngineLogic {
 	friend class Engine;
+	friend class LevelLoadProcess;
 
 protected:
 	float m_life_time;
@@ -33,6 +36,7 @@ protected:
 	std::unique_ptr<ActorFactory> m_actor_factory;
 	std::unique_ptr<IEnginePhysics> m_physics;
 	std::unique_ptr<LevelManager> m_level_manager;
+	std::unique_ptr<ComponentStore> m_component_store;
 	MTRandom m_random;
 	ActorMap m_actors;
 	std::unordered_map<std::string, StrongActorPtr> m_actors_names;
@@ -68,7 +72,13 @@ public:
 
 	std::string GetActorXml(const ActorId id);
 
+	// Binary quick save of every live actor, see actors/actor_archive.h.
+	void SaveActorsBinary(BinaryWriter& out);
+	// Recreates the actors of an archive, live actors with a saved id are replaced.
+	bool LoadActorsBinary(BinaryReader& in);
+
 	const LevelManager* GetLevelManager();
+	ComponentStore* GetComponentStore();
 	virtual IEnginePhysics* VGetGamePhysics() override;
 	virtual bool VLoadGame(const char* levelResource) override;
 	virtual bool VLoadGame(const char* levelResource, std::shared_ptr<HumanView> hv);
@@ -83,6 +93,9 @@ protected:
 	virtual std::unique_ptr<ActorFactory> VCreateActorFactory();
 	virtual bool VLoadGameDelegate(TiXmlElement* pLevelData);
 
+	bool LoadLevelActors(LevelLoader& loader, const char* levelResource);
+	void CommitLoadedActor(StrongActorPtr pActor);
+
 	void MoveActorDelegate(IEventDataPtr pEventData);
 	void RequestNewActorDelegate(IEventDataPtr pEventData);
 };
\ No newline at end of file
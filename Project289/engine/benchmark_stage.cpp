@@ -0,0 +1,11 @@
+#include "benchmark_stage.h"
+
+void BenchmarkStage::Add(double ms, int frame) {
+	total += ms;
+	if (frame == 0 || ms < min) { min = ms; }
+	if (frame == 0 || ms > max) { max = ms; }
+}
+
+double ElapsedMs(gameTimePoint from, gameTimePoint to) {
+	return std::chrono::duration<double, std::milli>(to - from).count();
+}
\ No newline at end of file
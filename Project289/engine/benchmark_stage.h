@@ -0,0 +1,17 @@
+#pragma once
+
+#include <string>
+
+#include "../tools/game_timer.h"
+
+// Milliseconds spent in one stage of the frame, over every frame of a run.
+struct BenchmarkStage {
+	std::string name;
+	double total = 0.0;
+	double min = 0.0;
+	double max = 0.0;
+
+	void Add(double ms, int frame);
+};
+
+double ElapsedMs(gameTimePoint from, gameTimePoint to);
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include "component_benchmark.h"
+#include "benchmark_stage.h"
+#include "../actors/actor.h"
+#include "../actors/actor_component.h"
+#include "../actors/component_store.h"
+#include "../tools/object_pool.h"
+
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+namespace {
+	// Integrates a velocity, about the work of a light per frame component.
+	class MoverComponent : public ActorComponent {
+	public:
+		float m_position[3] = { 0.0f, 0.0f, 0.0f };
+		float m_velocity[3] = { 1.0f, 0.5f, 0.25f };
+
+		virtual bool VInit(TiXmlElement* pData) override { return true; }
+		virtual TiXmlElement* VGenerateXml() override { return nullptr; }
+		virtual const std::string& VGetName() const override {
+			static const std::string name = "BenchmarkMover";
+			return name;
+		}
+		virtual bool VRequiresUpdate() const override { return true; }
+		virtual void VUpdate(float deltaMs) override {
+			for (int i = 0; i < 3; ++i) {
+				m_position[i] += m_velocity[i] * deltaMs;
+			}
+		}
+	};
+
+	// Data only, stays out of the update list.
+	class TagComponent : public ActorComponent {
+	public:
+		virtual bool VInit(TiXmlElement* pData) override { return true; }
+		virtual TiXmlElement* VGenerateXml() override { return nullptr; }
+		virtual const std::string& VGetName() const override {
+			static const std::string name = "BenchmarkTag";
+			return name;
+		}
+	};
+
+	StrongActorPtr MakeBenchmarkActor(ActorId id) {
+		StrongActorPtr pActor = std::make_shared<Actor>(id);
+		for (StrongActorComponentPtr pComponent : { StrongActorComponentPtr(MakePooled<MoverComponent>()), StrongActorComponentPtr(MakePooled<TagComponent>()) }) {
+			pComponent->SetOwner(pActor.get());
+			pActor->AddComponent(pComponent);
+		}
+		return pActor;
+	}
+}
+
+std::string BenchmarkComponentUpdate(int actorCount, int frameCount) {
+	const float frameSeconds = 1.0f / 60.0f;
+	ComponentStore store;
+	std::vector<StrongActorPtr> actors;
+	actors.reserve(static_cast<size_t>(actorCount));
+	ActorId nextId = 1u;
+	for (int i = 0; i < actorCount; ++i) {
+		actors.push_back(MakeBenchmarkActor(nextId++));
+		store.AddActor(*actors.back());
+	}
+
+	std::ostringstream out;
+	out << std::fixed << std::setprecision(3);
+	out << "actors: " << actorCount << ", frames: " << frameCount << ", one updating and one static component each\n";
+
+	BenchmarkStage perActor;
+	for (int frame = 0; frame < frameCount; ++frame) {
+		gameTimePoint start = gameClock::now();
+		for (const StrongActorPtr& pActor : actors) {
+			pActor->Update(frameSeconds);
+		}
+		perActor.Add(ElapsedMs(start, gameClock::now()), frame);
+	}
+	out << "per actor update ms avg " << (frameCount > 0 ? perActor.total / frameCount : 0.0) << ", min " << perActor.min << ", max " << perActor.max << "\n";
+
+	BenchmarkStage pooled;
+	for (int frame = 0; frame < frameCount; ++frame) {
+		gameTimePoint start = gameClock::now();
+		store.Update(frameSeconds);
+		pooled.Add(ElapsedMs(start, gameClock::now()), frame);
+	}
+	out << "component store update ms avg " << (frameCount > 0 ? pooled.total / frameCount : 0.0) << ", min " << pooled.min << ", max " << pooled.max << "\n";
+
+	// Spread over the array so the removals swap entries from the back into the middle of the pools
+	const size_t churnCount = actors.size() / 100u;
+	const size_t churnStride = churnCount > 0u ? actors.size() / churnCount : 1u;
+	BenchmarkStage churn;
+	BenchmarkStage churnUpdate;
+	for (int frame = 0; frame < frameCount; ++frame) {
+		gameTimePoint start = gameClock::now();
+		for (size_t i = frame % churnStride; i < actors.size() && churnCount > 0u; i += churnStride) {
+			store.RemoveActor(*actors[i]);
+			actors[i]->Destroy();
+			actors[i] = MakeBenchmarkActor(nextId++);
+			store.AddActor(*actors[i]);
+		}
+		gameTimePoint churnDone = gameClock::now();
+		store.Update(frameSeconds);
+		churn.Add(ElapsedMs(start, churnDone), frame);
+		churnUpdate.Add(ElapsedMs(churnDone, gameClock::now()), frame);
+	}
+	out << "1% respawned a frame: respawn ms avg " << (frameCount > 0 ? churn.total / frameCount : 0.0) << ", update ms avg "
+		<< (frameCount > 0 ? churnUpdate.total / frameCount : 0.0) << ", min " << churnUpdate.min << ", max " << churnUpdate.max << "\n";
+	out << store.GetComponentCount() << " components in the store\n";
+	return out.str();
+}
\ No newline at end of file
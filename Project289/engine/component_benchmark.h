@@ -0,0 +1,8 @@
+#pragma once
+
+#include <string>
+
+// Builds actorCount actors with one component that updates every frame and one that never does, then times
+// frameCount frames of the per actor Actor::Update walk, of ComponentStore::Update, and of ComponentStore::Update
+// with 1% of the actors destroyed and respawned every frame. CPU only, no engine needed.
+std::string BenchmarkComponentUpdate(int actorCount, int frameCount);
\ No newline at end of file
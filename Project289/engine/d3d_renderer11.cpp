@@ -1,6 +1,15 @@
 #include "d3d_renderer11.h"
+#include "../bindable/bindable.h"
+#include "../bindable/constant_buffer_bindable.h"
+#include "../graphics/constant_buffer_types.h"
 
-D3DRenderer11::D3DRenderer11() {}
+#include <algorithm>
+#include <cstring>
+
+D3DRenderer11::D3DRenderer11() : m_instance_capacity(0u), m_view_projection_dirty(true) {
+	DirectX::XMStoreFloat4x4(&m_view, DirectX::XMMatrixIdentity());
+	DirectX::XMStoreFloat4x4(&m_projection, DirectX::XMMatrixIdentity());
+}
 
 bool D3DRenderer11::Initialize(const RenderWindow& rw) {
 	if (!DirectX::XMVerifyCPUSupport()) { return false;	}
@@ -239,13 +248,25 @@ void D3DRenderer11::VSetWorldTransform(DirectX::FXMMATRIX m) {}
 
 void D3DRenderer11::VSetWorldTransform4x4(const DirectX::XMFLOAT4X4& m) {}
 
-void D3DRenderer11::VSetViewTransform(DirectX::FXMMATRIX m) {}
+void D3DRenderer11::VSetViewTransform(DirectX::FXMMATRIX m) {
+	DirectX::XMStoreFloat4x4(&m_view, m);
+	m_view_projection_dirty = true;
+}
 
-void D3DRenderer11::VSetViewTransform4x4(const DirectX::XMFLOAT4X4& m) {}
+void D3DRenderer11::VSetViewTransform4x4(const DirectX::XMFLOAT4X4& m) {
+	m_view = m;
+	m_view_projection_dirty = true;
+}
 
-void D3DRenderer11::VSetProjectionTransform(DirectX::FXMMATRIX m) {}
+void D3DRenderer11::VSetProjectionTransform(DirectX::FXMMATRIX m) {
+	DirectX::XMStoreFloat4x4(&m_projection, m);
+	m_view_projection_dirty = true;
+}
 
-void D3DRenderer11::VSetProjectionTransform4x4(const DirectX::XMFLOAT4X4& m) {}
+void D3DRenderer11::VSetProjectionTransform4x4(const DirectX::XMFLOAT4X4& m) {
+	m_projection = m;
+	m_view_projection_dirty = true;
+}
 
 std::shared_ptr<IRenderState> D3DRenderer11::VPrepareAlphaPass() {
 	return std::shared_ptr<IRenderState>();
@@ -253,4 +274,82 @@ std::shared_ptr<IRenderState> D3DRenderer11::VPrepareAlphaPass() {
 
 std::shared_ptr<IRenderState> D3DRenderer11::VPrepareSkyBoxPass() {
 	return std::shared_ptr<IRenderState>();
+}
+
+void D3DRenderer11::VBind(Bindable* pBindable) {
+	pBindable->Bind(m_device_context.Get());
+}
+
+void D3DRenderer11::VUpdateConstantBuffer(Bindable* pBuffer, const void* pData, size_t size) {
+	static_cast<ConstantBufferBindableBase*>(pBuffer)->UpdateBytes(m_device_context.Get(), pData, size);
+}
+
+void D3DRenderer11::VDrawIndexed(UINT indexCount) {
+	m_device_context->DrawIndexed(indexCount, 0u, 0u);
+}
+
+void D3DRenderer11::VDrawIndexedInstanced(UINT indexCount, const InstanceData* pInstances, UINT instanceCount) {
+	ReserveInstances(instanceCount);
+	UploadBytes(m_instance_buffer.Get(), pInstances, sizeof(InstanceData) * instanceCount);
+
+	if (m_view_projection_dirty) {
+		CB_VS_ViewProjection vp;
+		DirectX::XMStoreFloat4x4(&vp.viewProjMatrix, DirectX::XMMatrixTranspose(DirectX::XMMatrixMultiply(DirectX::XMLoadFloat4x4(&m_view), DirectX::XMLoadFloat4x4(&m_projection))));
+		UploadBytes(m_view_projection_buffer.Get(), &vp, sizeof(vp));
+		m_view_projection_dirty = false;
+	}
+
+	// Neither slot is tracked by the render queue's state cache, so they are set for every instanced draw
+	ID3D11ShaderResourceView* pInstanceView = m_instance_view.Get();
+	m_device_context->VSSetShaderResources(0u, 1u, &pInstanceView);
+	ID3D11Buffer* pViewProjection = m_view_projection_buffer.Get();
+	m_device_context->VSSetConstantBuffers(1u, 1u, &pViewProjection);
+	m_device_context->DrawIndexedInstanced(indexCount, instanceCount, 0u, 0, 0u);
+}
+
+void D3DRenderer11::ReserveInstances(UINT instanceCount) {
+	if (!m_view_projection_buffer) {
+		D3D11_BUFFER_DESC cbd = {};
+		cbd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+		cbd.Usage = D3D11_USAGE_DYNAMIC;
+		cbd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+		cbd.ByteWidth = sizeof(CB_VS_ViewProjection);
+		HRESULT hr = m_device->CreateBuffer(&cbd, nullptr, &m_view_projection_buffer);
+		COM_ERROR_IF_FAILED(hr, "Failed to create view projection buffer");
+		m_view_projection_dirty = true;
+	}
+	if (instanceCount <= m_instance_capacity) {
+		return;
+	}
+
+	// Doubling keeps a level whose instance counts creep up from recreating the buffer every frame
+	UINT capacity = std::max(std::max(instanceCount, m_instance_capacity * 2u), 64u);
+	D3D11_BUFFER_DESC bd = {};
+	bd.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+	bd.Usage = D3D11_USAGE_DYNAMIC;
+	bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+	bd.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+	bd.ByteWidth = sizeof(InstanceData) * capacity;
+	bd.StructureByteStride = sizeof(InstanceData);
+	m_instance_view.Reset();
+	m_instance_buffer.Reset();
+	HRESULT hr = m_device->CreateBuffer(&bd, nullptr, &m_instance_buffer);
+	COM_ERROR_IF_FAILED(hr, "Failed to create instance buffer");
+
+	D3D11_SHADER_RESOURCE_VIEW_DESC srvd = {};
+	srvd.Format = DXGI_FORMAT_UNKNOWN;
+	srvd.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+	srvd.Buffer.FirstElement = 0u;
+	srvd.Buffer.NumElements = capacity;
+	hr = m_device->CreateShaderResourceView(m_instance_buffer.Get(), &srvd, &m_instance_view);
+	COM_ERROR_IF_FAILED(hr, "Failed to create instance buffer view");
+	m_instance_capacity = capacity;
+}
+
+void D3DRenderer11::UploadBytes(ID3D11Buffer* pBuffer, const void* pData, size_t size) {
+	D3D11_MAPPED_SUBRESOURCE msr;
+	HRESULT hr = m_device_context->Map(pBuffer, 0u, D3D11_MAP_WRITE_DISCARD, 0u, &msr);
+	COM_ERROR_IF_FAILED(hr, "Failed to update buffer");
+	std::memcpy(msr.pData, pData, size);
+	m_device_context->Unmap(pBuffer, 0u);
 }
\ No newline at end of file
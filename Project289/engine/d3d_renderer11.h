@@ -39,6 +39,10 @@ public:
 	virtual void VSetProjectionTransform4x4(const DirectX::XMFLOAT4X4& m) override;
 	virtual std::shared_ptr<IRenderState> VPrepareAlphaPass() override;
 	virtual std::shared_ptr<IRenderState> VPrepareSkyBoxPass() override;
+	virtual void VBind(Bindable* pBindable) override;
+	virtual void VUpdateConstantBuffer(Bindable* pBuffer, const void* pData, size_t size) override;
+	virtual void VDrawIndexed(UINT indexCount) override;
+	virtual void VDrawIndexedInstanced(UINT indexCount, const InstanceData* pInstances, UINT instanceCount) override;
 
 	ID3D11Device* GetDevice();
 	ID3D11DeviceContext* GetDeviceContext();
@@ -66,4 +70,17 @@ protected:
 
 	std::unique_ptr<DirectX::SpriteBatch> m_sprite_batch;
 	std::unique_ptr<DirectX::SpriteFont> m_sprite_font;
+
+	// Instanced draws read their instances from t0 and the view projection from b1 of the vertex shader. The
+	// instance buffer is rewritten by every instanced draw and only grows.
+	Microsoft::WRL::ComPtr<ID3D11Buffer> m_instance_buffer;
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_instance_view;
+	UINT m_instance_capacity;
+	Microsoft::WRL::ComPtr<ID3D11Buffer> m_view_projection_buffer;
+	DirectX::XMFLOAT4X4 m_view;
+	DirectX::XMFLOAT4X4 m_projection;
+	bool m_view_projection_dirty;
+
+	void ReserveInstances(UINT instanceCount);
+	void UploadBytes(ID3D11Buffer* pBuffer, const void* pData, size_t size);
 };
\ No newline at end of file
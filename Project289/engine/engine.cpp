@@ -1,10 +1,7 @@
 #include "engine.h"
-#include "../events/evt_data_environment_loaded.h"
-#include "../events/evt_data_new_actor.h"
 #include "../events/evt_data_move_actor.h"
-#include "../events/evt_data_destroy_actor.h"
-#include "../events/evt_data_request_new_actor.h"
 #include "d3d_renderer11.h"
+#include "headless_renderer.h"
 #include "x_logic.h"
 #include "main_menu_ui.h"
 #include "main_menu_view.h"
@@ -46,6 +43,9 @@ bool Engine::Initialize(const RenderWindowConfig& cfg) {
 	if (!m_event_manager) {
 		return false;
 	}
+	m_event_manager->SetCoalescePolicy(EvtData_Move_Actor::sk_EventType, [](const IEventData& evt) -> uint64_t { return static_cast<const EvtData_Move_Actor&>(evt).GetId(); });
+
+	m_job_system = std::make_unique<JobSystem>();
 
 	m_game = VCreateGameAndView();
 	if (!m_game) {
@@ -55,6 +55,27 @@ bool Engine::Initialize(const RenderWindowConfig& cfg) {
 	return true;
 }
 
+bool Engine::InitializeHeadless(const EngineOptions& options) {
+	m_timer.Start();
+	m_options = options;
+	m_options.m_Renderer = Renderer::Renderer_Headless;
+
+	m_renderer = std::make_unique<HeadlessRenderer>();
+
+	m_event_manager = std::make_unique<EventManager>("GameCodeApp Event Mgr", true);
+	m_event_manager->SetCoalescePolicy(EvtData_Move_Actor::sk_EventType, [](const IEventData& evt) -> uint64_t { return static_cast<const EvtData_Move_Actor&>(evt).GetId(); });
+
+	m_job_system = std::make_unique<JobSystem>();
+
+	std::unique_ptr<XLogic> pGame = std::make_unique<XLogic>();
+	if (!pGame->Init()) {
+		return false;
+	}
+	m_game = std::move(pGame);
+
+	return true;
+}
+
 void Engine::Run() {
 	while (ProcessMessages()) {
 		if (!Update()) { break; };
@@ -191,7 +212,7 @@ const RenderWindow& Engine::GetRenderWindow() {
 }
 
 Renderer Engine::GetRendererImpl() {
-	return Renderer::Renderer_D3D11;
+	return g_pApp ? g_pApp->m_options.m_Renderer : Renderer::Renderer_D3D11;
 }
 
 std::unique_ptr<BaseEngineLogic> Engine::VCreateGameAndView() {
@@ -231,14 +252,6 @@ void Engine::RenderFrame() {
 	m_renderer->VPostRender();
 }
 
-void Engine::VRegisterEvents() {
-	REGISTER_EVENT(EvtData_Environment_Loaded);
-	REGISTER_EVENT(EvtData_New_Actor);
-	REGISTER_EVENT(EvtData_Move_Actor);
-	REGISTER_EVENT(EvtData_Destroy_Actor);
-	REGISTER_EVENT(EvtData_Request_New_Actor);
-}
-
 int Engine::Modal(std::shared_ptr<IScreenElement> pModalScreen, int defaultAnswer) {
 	auto pView = GetHumanView();
 	if (!pView) { return defaultAnswer;	}
@@ -255,6 +268,10 @@ IRenderer* Engine::GetRenderer() {
 	return m_renderer.get();
 }
 
+JobSystem* Engine::GetJobSystem() {
+	return m_job_system.get();
+}
+
 bool Engine::VLoadGame() {
 	return m_game->VLoadGame("MainMenu.xml");
 }
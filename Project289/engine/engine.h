@@ -11,6 +11,7 @@
 #include "renderer_enum.h"
 #include "i_renderer.h"
 #include "../events/event_manager.h"
+#include "../tools/job_system.h"
 #include "human_view.h"
 
 class Engine {
@@ -19,6 +20,8 @@ public:
 	virtual ~Engine();
 
 	bool Initialize(const RenderWindowConfig& cfg);
+	// No window, no device and no views: a HeadlessRenderer and the game logic, for benchmarks and tools.
+	bool InitializeHeadless(const EngineOptions& options);
 	void Run();
 	void AbortGame();
 	bool IsRunning();
@@ -37,6 +40,7 @@ public:
 
 	BaseEngineLogic* GetGameLogic();
 	IRenderer* GetRenderer();
+	JobSystem* GetJobSystem();
 	std::shared_ptr<HumanView> GetHumanView();
 	std::shared_ptr<HumanView> GetHumanViewByName(std::string name);
 	const GameTimer& GetTimer();
@@ -49,7 +53,6 @@ public:
 
 protected:
 	virtual std::unique_ptr<BaseEngineLogic> VCreateGameAndView();
-	virtual void VRegisterEvents();
 
 private:
 	bool m_is_running;
@@ -63,6 +66,7 @@ private:
 	GameTimer m_timer;
 
 	std::unique_ptr<EventManager> m_event_manager;
+	std::unique_ptr<JobSystem> m_job_system;
 	std::unique_ptr<IRenderer> m_renderer;
 
 	std::unique_ptr<BaseEngineLogic> m_game;
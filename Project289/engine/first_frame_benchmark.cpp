@@ -0,0 +1,73 @@
+#include "first_frame_benchmark.h"
+#include "benchmark_stage.h"
+#include "headless_renderer.h"
+#include "engine.h"
+#include "base_engine_state.h"
+#include "level_load_process.h"
+#include "../nodes/scene.h"
+#include "../nodes/camera_node.h"
+#include "../nodes/frustum.h"
+#include "../events/i_event_manager.h"
+
+#include <iomanip>
+#include <sstream>
+
+std::string BenchmarkFirstFrame(HeadlessRenderer* renderer, const std::string& levelResource, int maxFrames, float frameSeconds) {
+	// Same camera a HumanView starts with, the level's render components land in the scene as they are committed
+	Scene scene(renderer);
+	Frustum frustum;
+	frustum.Init(DirectX::XM_PI / 4.0f, 1.0f, 1.0f, 100.0f);
+	std::shared_ptr<CameraNode> camera = std::make_shared<CameraNode>(DirectX::XMMatrixIdentity(), frustum);
+	scene.AddChild(INVALID_ACTOR_ID, camera);
+	scene.SetCamera(camera);
+
+	BaseEngineLogic* pGame = g_pApp->GetGameLogic();
+	pGame->VChangeState(BaseEngineState::BGS_Running);
+
+	std::ostringstream out;
+	out << std::fixed << std::setprecision(3);
+	out << levelResource << "\n";
+
+	gameTimePoint start = gameClock::now();
+	std::shared_ptr<LevelLoadProcess> pLoad = std::make_shared<LevelLoadProcess>(levelResource, nullptr);
+	pGame->AttachProcess(pLoad);
+
+	BenchmarkStage loadingFrames;
+	loadingFrames.name = "frame while loading";
+	float time = 0.0f;
+	for (int frame = 0; frame < maxFrames; ++frame) {
+		gameTimePoint frameStart = gameClock::now();
+		time += frameSeconds;
+		IEventManager::Get()->VUpdate();
+		pGame->VOnUpdate(time, frameSeconds);
+		// Read before rendering, the frame after the level loaded event is the first one that shows the whole level
+		bool loaded = pLoad->GetState() == Process::State::SUCCEEDED;
+		double loadedMs = ElapsedMs(start, gameClock::now());
+
+		renderer->ResetStats();
+		scene.OnUpdate(frameSeconds);
+		renderer->VPreRender();
+		scene.OnRender();
+		renderer->VPostRender();
+		gameTimePoint frameEnd = gameClock::now();
+
+		if (loaded) {
+			const RenderStats& stats = renderer->GetStats();
+			out << "frames while loading: " << frame << "\n";
+			out << "level loaded event: " << loadedMs << " ms\n";
+			out << "first frame: " << ElapsedMs(start, frameEnd) << " ms, " << stats.draws << " draws\n";
+			if (frame > 0) {
+				out << loadingFrames.name << ": avg " << loadingFrames.total / frame << " ms, min " << loadingFrames.min << " ms, max " << loadingFrames.max << " ms\n";
+			}
+			return out.str();
+		}
+		if (pLoad->IsDead()) {
+			out << "load failed after " << frame + 1 << " frames\n";
+			return out.str();
+		}
+		loadingFrames.Add(ElapsedMs(frameStart, frameEnd), frame);
+	}
+
+	out << "not loaded after " << maxFrames << " frames\n";
+	return out.str();
+}
\ No newline at end of file
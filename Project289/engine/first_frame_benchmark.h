@@ -0,0 +1,10 @@
+#pragma once
+
+#include <string>
+
+class HeadlessRenderer;
+
+// Streams a level in through LevelLoadProcess while a scene keeps rendering each frame, the way the menu keeps drawing
+// during a real load, and reports the time from the start of the load to EvtData_Level_Loaded and to the first frame
+// rendered after it, plus the longest frame while loading. Needs an initialized engine; gives up after maxFrames.
+std::string BenchmarkFirstFrame(HeadlessRenderer* renderer, const std::string& levelResource, int maxFrames = 10000, float frameSeconds = 1.0f / 60.0f);
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include "headless_renderer.h"
+#include "../bindable/bindable.h"
+#include "../graphics/constant_buffer_types.h"
+
+HeadlessRenderer::HeadlessRenderer() : m_recording(false) {}
+
+bool HeadlessRenderer::Initialize(const RenderWindow& rw) {
+	return true;
+}
+
+void HeadlessRenderer::VSetBackgroundColor(BYTE bgA, BYTE bgR, BYTE bgG, BYTE bgB) {}
+
+void HeadlessRenderer::VSetBackgroundColor4f(float bgA, float bgR, float bgG, float bgB) {}
+
+HRESULT HeadlessRenderer::VOnRestore() {
+	return S_OK;
+}
+
+void HeadlessRenderer::VShutdown() {}
+
+bool HeadlessRenderer::VPreRender() {
+	return true;
+}
+
+bool HeadlessRenderer::VPostRender() {
+	return true;
+}
+
+void HeadlessRenderer::VCalcLighting(Lights* lights, int maximumLights) {}
+
+void HeadlessRenderer::VSetWorldTransform(DirectX::FXMMATRIX m) {}
+
+void HeadlessRenderer::VSetWorldTransform4x4(const DirectX::XMFLOAT4X4& m) {}
+
+void HeadlessRenderer::VSetViewTransform(DirectX::FXMMATRIX m) {}
+
+void HeadlessRenderer::VSetViewTransform4x4(const DirectX::XMFLOAT4X4& m) {}
+
+void HeadlessRenderer::VSetProjectionTransform(DirectX::FXMMATRIX m) {}
+
+void HeadlessRenderer::VSetProjectionTransform4x4(const DirectX::XMFLOAT4X4& m) {}
+
+std::shared_ptr<IRenderState> HeadlessRenderer::VPrepareAlphaPass() {
+	return std::shared_ptr<IRenderState>();
+}
+
+std::shared_ptr<IRenderState> HeadlessRenderer::VPrepareSkyBoxPass() {
+	return std::shared_ptr<IRenderState>();
+}
+
+void HeadlessRenderer::VBind(Bindable* pBindable) {
+	++m_stats.stateChanges;
+	if (m_recording) {
+		m_commands.push_back({ RenderCommandType::Bind, 0u, pBindable->GetStateId(), 0u });
+	}
+}
+
+void HeadlessRenderer::VUpdateConstantBuffer(Bindable* pBuffer, const void* pData, size_t size) {
+	++m_stats.constantBufferUpdates;
+	m_stats.constantBufferBytes += size;
+	if (m_recording) {
+		size_t offset = m_payload.size();
+		const uint8_t* pBytes = static_cast<const uint8_t*>(pData);
+		m_payload.insert(m_payload.end(), pBytes, pBytes + size);
+		m_commands.push_back({ RenderCommandType::UpdateConstantBuffer, static_cast<uint32_t>(size), pBuffer->GetStateId(), offset });
+	}
+}
+
+void HeadlessRenderer::VDrawIndexed(UINT indexCount) {
+	++m_stats.draws;
+	m_stats.indices += indexCount;
+	if (m_recording) {
+		m_commands.push_back({ RenderCommandType::DrawIndexed, indexCount, 0u, 0u });
+	}
+}
+
+void HeadlessRenderer::VDrawIndexedInstanced(UINT indexCount, const InstanceData* pInstances, UINT instanceCount) {
+	++m_stats.draws;
+	m_stats.indices += static_cast<uint64_t>(indexCount) * instanceCount;
+	m_stats.instances += instanceCount;
+	if (m_recording) {
+		size_t offset = m_payload.size();
+		const uint8_t* pBytes = reinterpret_cast<const uint8_t*>(pInstances);
+		m_payload.insert(m_payload.end(), pBytes, pBytes + sizeof(InstanceData) * instanceCount);
+		m_commands.push_back({ RenderCommandType::DrawIndexedInstanced, indexCount, instanceCount, offset });
+	}
+}
+
+const RenderStats& HeadlessRenderer::GetStats() const {
+	return m_stats;
+}
+
+void HeadlessRenderer::ResetStats() {
+	m_stats = RenderStats();
+}
+
+void HeadlessRenderer::SetRecording(bool recording) {
+	m_recording = recording;
+}
+
+bool HeadlessRenderer::IsRecording() const {
+	return m_recording;
+}
+
+const std::vector<RenderCommand>& HeadlessRenderer::GetCommands() const {
+	return m_commands;
+}
+
+const std::vector<uint8_t>& HeadlessRenderer::GetPayload() const {
+	return m_payload;
+}
+
+void HeadlessRenderer::ClearCommands() {
+	// Keeps the capacity, a frame after the first records without allocating
+	m_commands.clear();
+	m_payload.clear();
+}
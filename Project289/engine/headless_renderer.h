@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "i_renderer.h"
+
+struct RenderStats {
+	uint32_t stateChanges = 0u;
+	uint32_t constantBufferUpdates = 0u;
+	uint64_t constantBufferBytes = 0u;
+	uint32_t draws = 0u;
+	uint64_t indices = 0u;
+	// Instances drawn by instanced draws, each of which counts as one draw.
+	uint32_t instances = 0u;
+};
+
+enum class RenderCommandType : uint8_t {
+	Bind,
+	UpdateConstantBuffer,
+	DrawIndexed,
+	DrawIndexedInstanced
+};
+
+struct RenderCommand {
+	RenderCommandType type;
+	// Byte count of a constant buffer update, index count of a draw.
+	uint32_t size;
+	// State id of the bound or updated bindable, instance count of an instanced draw.
+	uint64_t stateId;
+	// Where the constant buffer bytes or the instance data start in the payload.
+	size_t payloadOffset;
+};
+
+// Renderer without a device. Binds, constant buffer updates and draws are counted and, while recording, appended
+// to an in memory command stream. Lets a level run without a window, for benchmarks and for inspecting what a
+// frame would have sent to the GPU.
+class HeadlessRenderer : public IRenderer {
+	RenderStats m_stats;
+	bool m_recording;
+	std::vector<RenderCommand> m_commands;
+	std::vector<uint8_t> m_payload;
+
+public:
+	HeadlessRenderer();
+
+	virtual bool Initialize(const RenderWindow& rw) override;
+
+	virtual void VSetBackgroundColor(BYTE bgA, BYTE bgR, BYTE bgG, BYTE bgB) override;
+	virtual void VSetBackgroundColor4f(float bgA, float bgR, float bgG, float bgB) override;
+	virtual HRESULT VOnRestore() override;
+	virtual void VShutdown() override;
+	virtual bool VPreRender() override;
+	virtual bool VPostRender() override;
+	virtual void VCalcLighting(Lights* lights, int maximumLights) override;
+	virtual void VSetWorldTransform(DirectX::FXMMATRIX m) override;
+	virtual void VSetWorldTransform4x4(const DirectX::XMFLOAT4X4& m) override;
+	virtual void VSetViewTransform(DirectX::FXMMATRIX m) override;
+	virtual void VSetViewTransform4x4(const DirectX::XMFLOAT4X4& m) override;
+	virtual void VSetProjectionTransform(DirectX::FXMMATRIX m) override;
+	virtual void VSetProjectionTransform4x4(const DirectX::XMFLOAT4X4& m) override;
+	virtual std::shared_ptr<IRenderState> VPrepareAlphaPass() override;
+	virtual std::shared_ptr<IRenderState> VPrepareSkyBoxPass() override;
+	virtual void VBind(Bindable* pBindable) override;
+	virtual void VUpdateConstantBuffer(Bindable* pBuffer, const void* pData, size_t size) override;
+	virtual void VDrawIndexed(UINT indexCount) override;
+	virtual void VDrawIndexedInstanced(UINT indexCount, const InstanceData* pInstances, UINT instanceCount) override;
+
+	const RenderStats& GetStats() const;
+	void ResetStats();
+
+	// Off by default, a counting only renderer is the cheapest way to time the CPU side of a frame.
+	void SetRecording(bool recording);
+	bool IsRecording() const;
+	const std::vector<RenderCommand>& GetCommands() const;
+	const std::vector<uint8_t>& GetPayload() const;
+	void ClearCommands();
+};
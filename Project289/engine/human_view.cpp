@@ -168,7 +168,7 @@ HumanView::~HumanView() {
 }
 
 HumanView::HumanView(IRenderer* renderer) {
-	m_process_manager = std::make_unique<ProcessManager>();
+	m_process_manager = std::make_unique<ProcessManager>(g_pApp ? g_pApp->GetJobSystem() : nullptr);
 
 	m_PointerRadius = 1;
 	m_view_id = 0xffffffff;
@@ -9,6 +9,9 @@
 #include "../nodes/light_node.h"
 #include "render_window.h"
 
+class Bindable;
+struct InstanceData;
+
 class IRenderer {
 public:
 	virtual bool Initialize(const RenderWindow& rw) = 0;
@@ -28,4 +31,12 @@ public:
 	virtual void VSetProjectionTransform4x4(const DirectX::XMFLOAT4X4& m) = 0;
 	virtual std::shared_ptr<IRenderState> VPrepareAlphaPass() = 0;
 	virtual std::shared_ptr<IRenderState> VPrepareSkyBoxPass() = 0;
+
+	// Draw submission used by the render queue, kept behind the interface so a headless renderer can count it.
+	virtual void VBind(Bindable* pBindable) = 0;
+	virtual void VUpdateConstantBuffer(Bindable* pBuffer, const void* pData, size_t size) = 0;
+	virtual void VDrawIndexed(UINT indexCount) = 0;
+	// Draws instanceCount copies of the bound mesh, the instance data is uploaded for the draw and read by the
+	// instanced vertex shader together with the view and projection last set on the renderer.
+	virtual void VDrawIndexedInstanced(UINT indexCount, const InstanceData* pInstances, UINT instanceCount) = 0;
 };
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include "level_load_process.h"
+#include "base_engine_logic.h"
+#include "human_view.h"
+#include "engine.h"
+#include "../events/i_event_manager.h"
+#include "../events/evt_data_level_loaded.h"
+
+#include <chrono>
+
+LevelLoadProcess::LevelLoadProcess(std::string levelResource, std::shared_ptr<HumanView> pHumanView, float commitBudgetMs) : m_levelResource(std::move(levelResource)), m_pHumanView(std::move(pHumanView)), m_commitBudgetMs(commitBudgetMs), m_committed(false), m_listening(false) {}
+
+LevelLoadProcess::~LevelLoadProcess() {
+	if (m_listening) {
+		IEventManager::Get()->VRemoveListener({ connect_arg<&LevelLoadProcess::LevelLoadedDelegate>, this }, EvtData_Level_Loaded::sk_EventType);
+	}
+}
+
+float LevelLoadProcess::GetProgress() const {
+	return m_pLoader ? m_pLoader->GetProgress() : 0.0f;
+}
+
+void LevelLoadProcess::VOnInit() {
+	Process::VOnInit();
+
+	BaseEngineLogic* pLogic = g_pApp->GetGameLogic();
+	m_pLoader = std::make_unique<LevelLoader>(pLogic->m_actor_factory.get(), g_pApp->GetJobSystem());
+	if (!m_pLoader->Open(m_levelResource.c_str())) {
+		Fail();
+		return;
+	}
+	m_listening = IEventManager::Get()->VAddListener({ connect_arg<&LevelLoadProcess::LevelLoadedDelegate>, this }, EvtData_Level_Loaded::sk_EventType);
+}
+
+void LevelLoadProcess::VOnUpdate(float deltaMs) {
+	if (m_committed || !m_pLoader->Update()) {
+		return;
+	}
+
+	BaseEngineLogic* pLogic = g_pApp->GetGameLogic();
+	const auto start = std::chrono::steady_clock::now();
+	while (m_pLoader->HasUncommitted()) {
+		pLogic->CommitLoadedActor(m_pLoader->CommitNext());
+		std::chrono::duration<float, std::milli> spent = std::chrono::steady_clock::now() - start;
+		if (spent.count() >= m_commitBudgetMs) {
+			return;
+		}
+	}
+
+	if (!pLogic->VLoadGameDelegate(m_pLoader->GetRoot())) {
+		Fail();
+		return;
+	}
+	// Low priority, so the new actor events queued by the commits above are all delivered first
+	m_committed = true;
+	std::shared_ptr<EvtData_Level_Loaded> pEvent(new EvtData_Level_Loaded(m_levelResource));
+	IEventManager::Get()->VQueueEvent(pEvent, EventPriority::LOW);
+}
+
+void LevelLoadProcess::LevelLoadedDelegate(IEventDataPtr pEventData) {
+	std::shared_ptr<EvtData_Level_Loaded> pCastEventData = std::static_pointer_cast<EvtData_Level_Loaded>(pEventData);
+	if (!m_committed || !IsAlive() || pCastEventData->GetLevelResource() != m_levelResource) {
+		return;
+	}
+
+	if (m_pHumanView && !m_pHumanView->LoadGame(m_pLoader->GetRoot())) {
+		Fail();
+		return;
+	}
+	Succeed();
+}
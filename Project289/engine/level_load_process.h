@@ -0,0 +1,36 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "../processes/process.h"
+#include "../events/i_event_data.h"
+#include "level_loader.h"
+
+class HumanView;
+
+// Loads a level over several frames: the actors are built on the job system while the current view keeps
+// drawing, then committed to the game logic in slices of at most commitBudgetMs per frame. After the last commit it
+// queues EvtData_Level_Loaded and only loads the view and succeeds once that event arrives, so the view never draws a
+// level whose commit events are still in flight.
+class LevelLoadProcess : public Process {
+public:
+	LevelLoadProcess(std::string levelResource, std::shared_ptr<HumanView> pHumanView, float commitBudgetMs = 4.0f);
+	virtual ~LevelLoadProcess();
+
+	float GetProgress() const;
+
+protected:
+	virtual void VOnInit() override;
+	virtual void VOnUpdate(float deltaMs) override;
+
+private:
+	void LevelLoadedDelegate(IEventDataPtr pEventData);
+
+	std::string m_levelResource;
+	std::shared_ptr<HumanView> m_pHumanView;
+	float m_commitBudgetMs;
+	std::unique_ptr<LevelLoader> m_pLoader;
+	bool m_committed;
+	bool m_listening;
+};
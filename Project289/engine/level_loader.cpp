@@ -0,0 +1,162 @@
+#include "level_loader.h"
+#include "../actors/actor_factory.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+LevelLoader::LevelLoader(ActorFactory* pActorFactory, JobSystem* pJobSystem) : m_pActorFactory(pActorFactory), m_pJobSystem(pJobSystem), m_pRoot(nullptr), m_stage(Stage::Idle), m_templatesBuilt(0u), m_actorsBuilt(0u), m_nextCommit(0u) {}
+
+LevelLoader::~LevelLoader() {
+	// Jobs in flight point at the entries, they have to finish before the loader goes away
+	if (m_pJobSystem && !m_counter.IsDone()) {
+		m_pJobSystem->Wait(m_counter);
+	}
+}
+
+bool LevelLoader::Open(const char* levelResource) {
+	if (m_stage != Stage::Idle || !m_pActorFactory) {
+		return false;
+	}
+
+	if (!m_document.LoadFile(levelResource)) {
+		return false;
+	}
+	m_pRoot = m_document.RootElement();
+	if (!m_pRoot) {
+		return false;
+	}
+
+	// Ids are handed out here rather than on the workers so a level always gets the same ids
+	std::unordered_set<std::string> uniqueTemplates;
+	TiXmlElement* pActorsNode = m_pRoot->FirstChildElement("Actors");
+	if (pActorsNode) {
+		for (TiXmlElement* pNode = pActorsNode->FirstChildElement(); pNode; pNode = pNode->NextSiblingElement()) {
+			const char* actorResource = pNode->Attribute("resource");
+			if (!actorResource) {
+				continue;
+			}
+
+			Entry entry;
+			entry.resource = actorResource;
+			entry.pOverrides = pNode;
+			entry.actorId = m_pActorFactory->ReserveActorId(INVALID_ACTOR_ID);
+			m_entries.push_back(std::move(entry));
+
+			if (uniqueTemplates.insert(actorResource).second) {
+				m_templates.push_back(actorResource);
+			}
+		}
+	}
+
+	StartTemplates();
+	return true;
+}
+
+bool LevelLoader::Update() {
+	if (m_stage == Stage::Idle || m_stage == Stage::Built) {
+		return m_stage == Stage::Built;
+	}
+
+	// Without worker threads nobody else drains the queue, so the caller does the work here
+	if (m_pJobSystem && m_pJobSystem->GetWorkerCount() == 0u) {
+		m_pJobSystem->Wait(m_counter);
+	}
+
+	if (m_stage == Stage::Templates && m_counter.IsDone()) {
+		StartActors();
+	}
+	if (m_stage == Stage::Actors && m_counter.IsDone()) {
+		m_stage = Stage::Built;
+	}
+	return m_stage == Stage::Built;
+}
+
+void LevelLoader::Wait() {
+	while (m_stage == Stage::Templates || m_stage == Stage::Actors) {
+		if (m_pJobSystem) {
+			m_pJobSystem->Wait(m_counter);
+		}
+		Update();
+	}
+}
+
+bool LevelLoader::IsBuilt() const {
+	return m_stage == Stage::Built;
+}
+
+bool LevelLoader::HasUncommitted() const {
+	return m_stage == Stage::Built && m_nextCommit < m_entries.size();
+}
+
+StrongActorPtr LevelLoader::CommitNext() {
+	if (!HasUncommitted()) {
+		return StrongActorPtr();
+	}
+
+	Entry& entry = m_entries[m_nextCommit++];
+	StrongActorPtr pActor = std::move(entry.pActor);
+	if (pActor) {
+		m_pActorFactory->FinishActor(pActor, entry.changedComponents);
+	}
+	entry.changedComponents.clear();
+	return pActor;
+}
+
+float LevelLoader::GetProgress() const {
+	if (m_stage == Stage::Idle) {
+		return 0.0f;
+	}
+
+	// Templates, builds and commits are weighted equally per item
+	size_t total = m_templates.size() + m_entries.size() * 2u;
+	if (total == 0u) {
+		return 1.0f;
+	}
+	size_t done = m_templatesBuilt.load(std::memory_order_relaxed) + m_actorsBuilt.load(std::memory_order_relaxed) + m_nextCommit;
+	return std::min(1.0f, static_cast<float>(done) / static_cast<float>(total));
+}
+
+TiXmlElement* LevelLoader::GetRoot() {
+	return m_pRoot;
+}
+
+void LevelLoader::StartTemplates() {
+	m_stage = Stage::Templates;
+	if (!m_pJobSystem) {
+		for (size_t i = 0u; i < m_templates.size(); ++i) {
+			BuildTemplate(i);
+		}
+		return;
+	}
+
+	for (size_t i = 0u; i < m_templates.size(); ++i) {
+		m_pJobSystem->Submit([this, i]() { BuildTemplate(i); }, m_counter);
+	}
+}
+
+void LevelLoader::StartActors() {
+	m_stage = Stage::Actors;
+	if (!m_pJobSystem) {
+		BuildActors(0u, m_entries.size());
+		return;
+	}
+
+	for (size_t begin = 0u; begin < m_entries.size(); begin += sk_ActorBatchSize) {
+		size_t end = std::min(begin + sk_ActorBatchSize, m_entries.size());
+		m_pJobSystem->Submit([this, begin, end]() { BuildActors(begin, end); }, m_counter);
+	}
+}
+
+void LevelLoader::BuildTemplate(size_t index) {
+	// A template that fails to parse is left out of the cache, its actors fail in BuildActors
+	m_pActorFactory->GetPrototype(m_templates[index]);
+	m_templatesBuilt.fetch_add(1u, std::memory_order_relaxed);
+}
+
+void LevelLoader::BuildActors(size_t begin, size_t end) {
+	for (size_t i = begin; i < end; ++i) {
+		Entry& entry = m_entries[i];
+		entry.pActor = m_pActorFactory->BuildActor(entry.resource.c_str(), entry.pOverrides, nullptr, entry.actorId, entry.changedComponents);
+		m_actorsBuilt.fetch_add(1u, std::memory_order_relaxed);
+	}
+}
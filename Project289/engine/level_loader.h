@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../actors/actor.h"
+#include "../tools/job_system.h"
+#include "../tools/tinyxml/tinyxml.h"
+
+class ActorFactory;
+
+// Staged level loading: Open parses the level and reserves actor ids in level order, the templates and then the
+// actors are built on the job system, and CommitNext hands finished actors back one at a time on the calling thread.
+// Nothing built by the workers is visible to the rest of the engine until it is committed.
+class LevelLoader {
+public:
+	LevelLoader(ActorFactory* pActorFactory, JobSystem* pJobSystem);
+	~LevelLoader();
+
+	LevelLoader(const LevelLoader&) = delete;
+	LevelLoader& operator=(const LevelLoader&) = delete;
+
+	bool Open(const char* levelResource);
+
+	// Advances the build stages without blocking, returns true once every actor is built.
+	bool Update();
+	void Wait();
+	bool IsBuilt() const;
+
+	bool HasUncommitted() const;
+	// Runs the main thread half of creation for the next actor in level order; empty if that actor failed to build.
+	StrongActorPtr CommitNext();
+
+	float GetProgress() const;
+	TiXmlElement* GetRoot();
+
+private:
+	enum class Stage {
+		Idle,
+		Templates,
+		Actors,
+		Built
+	};
+
+	struct Entry {
+		std::string resource;
+		TiXmlElement* pOverrides;
+		ActorId actorId;
+		StrongActorPtr pActor;
+		std::vector<StrongActorComponentPtr> changedComponents;
+	};
+
+	static constexpr size_t sk_ActorBatchSize = 8u;
+
+	void StartTemplates();
+	void StartActors();
+	void BuildTemplate(size_t index);
+	void BuildActors(size_t begin, size_t end);
+
+	ActorFactory* m_pActorFactory;
+	JobSystem* m_pJobSystem;
+
+	TiXmlDocument m_document;
+	TiXmlElement* m_pRoot;
+	std::vector<std::string> m_templates;
+	std::vector<Entry> m_entries;
+
+	Stage m_stage;
+	JobCounter m_counter;
+	std::atomic<size_t> m_templatesBuilt;
+	std::atomic<size_t> m_actorsBuilt;
+	size_t m_nextCommit;
+};
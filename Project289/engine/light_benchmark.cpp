@@ -0,0 +1,56 @@
+#include "light_benchmark.h"
+#include "benchmark_stage.h"
+#include "../nodes/light_clusters.h"
+
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <vector>
+
+std::string BenchmarkLightClusters(int lightCount, int frameCount) {
+	// Same projection as the scene benchmark camera, lights spread through the view volume
+	const float fov = DirectX::XM_PI / 4.0f;
+	const float farClip = 100.0f;
+	LightClusters clusters;
+	clusters.SetProjection(fov, 1.0f, 1.0f, farClip);
+
+	std::mt19937 rng(289u);
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> depth(1.0f, farClip);
+	std::uniform_real_distribution<float> range(1.0f, 10.0f);
+	std::vector<SpotLight> lights(static_cast<size_t>(lightCount));
+	for (size_t i = 0u; i < lights.size(); ++i) {
+		SpotLight& light = lights[i];
+		float z = depth(rng);
+		light = SpotLight();
+		light.Position = DirectX::XMFLOAT3(unit(rng) * z * 0.5f, unit(rng) * z * 0.5f, z);
+		light.Range = range(rng);
+		// Every fourth light is a spot
+		if (i % 4u == 0u) {
+			light.Direction = DirectX::XMFLOAT3(unit(rng), unit(rng), unit(rng));
+			light.Spot = 8.0f;
+		}
+	}
+
+	DirectX::XMFLOAT4X4 view;
+	DirectX::XMStoreFloat4x4(&view, DirectX::XMMatrixIdentity());
+	BenchmarkStage build;
+	build.name = "build";
+	for (int frame = 0; frame < frameCount; ++frame) {
+		gameTimePoint start = gameClock::now();
+		clusters.Build(lights, view);
+		build.Add(ElapsedMs(start, gameClock::now()), frame);
+	}
+
+	size_t occupied = 0u;
+	for (const ClusterRange& clusterRange : clusters.GetRanges()) {
+		occupied += clusterRange.count > 0u ? 1u : 0u;
+	}
+
+	std::ostringstream out;
+	out << std::fixed << std::setprecision(3);
+	out << "lights: " << lightCount << ", frames: " << frameCount << ", clusters: " << LightClusters::sk_ClusterCount << "\n";
+	out << "build ms avg " << (frameCount > 0 ? build.total / frameCount : 0.0) << ", min " << build.min << ", max " << build.max << "\n";
+	out << clusters.GetAssignmentCount() << " assignments, " << occupied << " clusters with lights\n";
+	return out.str();
+}
\ No newline at end of file
@@ -0,0 +1,7 @@
+#pragma once
+
+#include <string>
+
+// Bins lightCount random point and spot lights in front of the default camera into the light clusters frameCount
+// times, CPU only, and reports the time per build and the cluster assignments.
+std::string BenchmarkLightClusters(int lightCount, int frameCount);
\ No newline at end of file
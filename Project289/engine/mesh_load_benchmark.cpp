@@ -0,0 +1,58 @@
+#include "mesh_load_benchmark.h"
+#include "benchmark_stage.h"
+#include "../graphics/mesh_asset_cache.h"
+#include "../graphics/mesh_baker.h"
+
+#include <iomanip>
+#include <sstream>
+
+std::string BenchmarkMeshLoad(const std::vector<std::string>& sources, int repeats) {
+	std::ostringstream out;
+	out << std::fixed << std::setprecision(3);
+	out << "repeats: " << repeats << "\n";
+
+	double importTotal = 0.0;
+	double bakedTotal = 0.0;
+	for (const std::string& source : sources) {
+		std::string bakedPath = GetBakedMeshPath(source);
+		if (!BakeMeshFile(source, bakedPath)) {
+			out << source << ": failed to bake\n";
+			continue;
+		}
+
+		BenchmarkStage importStage;
+		importStage.name = "import";
+		BenchmarkStage bakedStage;
+		bakedStage.name = "baked";
+		size_t bytes = 0u;
+		bool failed = false;
+		for (int i = 0; i < repeats && !failed; ++i) {
+			std::vector<uint8_t> image;
+			gameTimePoint start = gameClock::now();
+			bool imported = BakeMesh(source, image);
+			importStage.Add(ElapsedMs(start, gameClock::now()), i);
+
+			start = gameClock::now();
+			std::shared_ptr<const MeshAsset> pAsset = MeshAssetCache::Get().Load(bakedPath);
+			bakedStage.Add(ElapsedMs(start, gameClock::now()), i);
+			failed = !imported || !pAsset;
+			bytes = pAsset ? pAsset->GetByteSize() : 0u;
+		}
+		if (failed) {
+			out << source << ": failed to load\n";
+			continue;
+		}
+
+		out << source << ", " << bytes << " bytes baked\n";
+		for (const BenchmarkStage* pStage : { &importStage, &bakedStage }) {
+			out << "  " << pStage->name << ": avg " << pStage->total / repeats << " ms, min " << pStage->min << " ms, max " << pStage->max << " ms\n";
+		}
+		importTotal += importStage.total;
+		bakedTotal += bakedStage.total;
+	}
+
+	if (repeats > 0 && bakedTotal > 0.0) {
+		out << "all models, one load each: import " << importTotal / repeats << " ms, baked " << bakedTotal / repeats << " ms, " << importTotal / bakedTotal << "x\n";
+	}
+	return out.str();
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Loads each model repeats times both ways a level can get it: imported through Assimp and flattened in memory, and
+// mapped from its baked .bmesh through MeshAssetCache, which the benchmark bakes first. Every load is cold as far as
+// the cache goes, the asset is released before the next one; the OS file cache is warm after the first pass.
+std::string BenchmarkMeshLoad(const std::vector<std::string>& sources, int repeats);
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include "occlusion_benchmark.h"
+#include "benchmark_stage.h"
+#include "../nodes/occlusion_culler.h"
+#include "../tools/job_system.h"
+
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <vector>
+
+namespace {
+	// Unit cube around the origin, two triangles a face.
+	void MakeCube(std::vector<Vertex>& vertices, std::vector<DWORD>& indices) {
+		for (int corner = 0; corner < 8; ++corner) {
+			vertices.emplace_back(DirectX::XMFLOAT3((corner & 1) ? 0.5f : -0.5f, (corner & 2) ? 0.5f : -0.5f, (corner & 4) ? 0.5f : -0.5f));
+		}
+		const DWORD faces[6][4] = { { 0, 1, 3, 2 }, { 4, 6, 7, 5 }, { 0, 4, 5, 1 }, { 2, 3, 7, 6 }, { 0, 2, 6, 4 }, { 1, 5, 7, 3 } };
+		for (const DWORD (&face)[4] : faces) {
+			indices.insert(indices.end(), { face[0], face[1], face[2], face[0], face[2], face[3] });
+		}
+	}
+}
+
+std::string BenchmarkOcclusion(int boxCount, int frameCount) {
+	// Same projection as the scene benchmark camera
+	DirectX::XMFLOAT4X4 viewProjection;
+	DirectX::XMStoreFloat4x4(&viewProjection, DirectX::XMMatrixPerspectiveFovLH(DirectX::XM_PI / 4.0f, 1.0f, 1.0f, 100.0f));
+	OcclusionCuller culler;
+	culler.SetViewProjection(viewProjection);
+
+	std::vector<Vertex> vertices;
+	std::vector<DWORD> indices;
+	MakeCube(vertices, indices);
+
+	// Staggered walls across the view, boxes spread through the rest of the view volume
+	std::mt19937 rng(289u);
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> depth(3.0f, 90.0f);
+	std::uniform_real_distribution<float> size(0.3f, 4.0f);
+	std::vector<OccluderMesh> occluders;
+	for (int i = 0; i < 12; ++i) {
+		float z = 15.0f + i * 4.0f;
+		OccluderMesh occluder = { vertices.data(), vertices.size(), indices.data(), indices.size() };
+		DirectX::XMStoreFloat4x4(&occluder.world, DirectX::XMMatrixScaling(6.0f + unit(rng) * 2.0f, 8.0f, 1.5f) * DirectX::XMMatrixTranslation(unit(rng) * z * 0.4f, unit(rng) * 2.0f, z));
+		occluders.push_back(occluder);
+	}
+	std::vector<Aabb> boxes(static_cast<size_t>(boxCount));
+	for (Aabb& box : boxes) {
+		float z = depth(rng);
+		float x = unit(rng) * z * 0.4f;
+		float y = unit(rng) * z * 0.4f;
+		float half = size(rng) * 0.5f;
+		box.m_Min = DirectX::XMFLOAT3(x - half, y - half, z - half);
+		box.m_Max = DirectX::XMFLOAT3(x + half, y + half, z + half);
+	}
+
+	std::ostringstream out;
+	out << std::fixed << std::setprecision(3);
+	out << "boxes: " << boxCount << ", occluders: " << occluders.size() << ", frames: " << frameCount << ", depth buffer: "
+		<< OcclusionCuller::sk_Width << "x" << OcclusionCuller::sk_Height << "\n";
+
+	JobSystem jobSystem;
+	JobSystem* const runs[2] = { nullptr, &jobSystem };
+	std::vector<uint8_t> occluded;
+	for (JobSystem* pJobSystem : runs) {
+		BenchmarkStage rasterize;
+		BenchmarkStage test;
+		for (int frame = 0; frame < frameCount; ++frame) {
+			culler.Rasterize(occluders, pJobSystem);
+			culler.TestBoxes(boxes, occluded, pJobSystem);
+			rasterize.Add(culler.GetStats().rasterizeMs, frame);
+			test.Add(culler.GetStats().testMs, frame);
+		}
+		const OcclusionStats& stats = culler.GetStats();
+		out << (pJobSystem ? "job system (" + std::to_string(pJobSystem->GetWorkerCount()) + " workers)" : std::string("calling thread")) << ": "
+			<< stats.occluded << " of " << stats.tested << " boxes occluded, " << stats.triangles << " triangles drawn\n";
+		out << "  rasterize ms avg " << (frameCount > 0 ? rasterize.total / frameCount : 0.0) << ", min " << rasterize.min << ", max " << rasterize.max << "\n";
+		out << "  test ms avg " << (frameCount > 0 ? test.total / frameCount : 0.0) << ", min " << test.min << ", max " << test.max << "\n";
+	}
+	return out.str();
+}
\ No newline at end of file
@@ -0,0 +1,7 @@
+#pragma once
+
+#include <string>
+
+// Draws a row of synthetic wall occluders into the occlusion depth buffer and tests boxCount random boxes in front of
+// the default camera against it frameCount times, CPU only, on the calling thread and then on a job system.
+std::string BenchmarkOcclusion(int boxCount, int frameCount);
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include "process_benchmark.h"
+#include "benchmark_stage.h"
+#include "../processes/process_manager.h"
+#include "../processes/delay_process.h"
+#include "../processes/count_process.h"
+
+#include <climits>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+	// Stays in the running bucket and costs one empty update a frame.
+	class IdleProcess : public Process {
+	protected:
+		virtual void VOnUpdate(float deltaMs) override {}
+	};
+}
+
+std::string BenchmarkProcesses(int processCount, int frameCount) {
+	const float frameSeconds = 1.0f / 60.0f;
+	std::ostringstream out;
+	out << std::fixed << std::setprecision(3);
+	out << "processes: " << processCount << ", frames: " << frameCount << "\n";
+
+	// The delays never run out during the benchmark, with a callback a DelayProcess ticks every frame like every
+	// process did before the sleep heap
+	for (int sleeping = 1; sleeping >= 0; --sleeping) {
+		ProcessManager processManager;
+		unsigned int ticks = 0u;
+		for (int i = 0; i < processCount; ++i) {
+			if (i % 100 == 0) {
+				processManager.AttachProcess(std::make_shared<CountProcess>(UINT_MAX, [&ticks](unsigned int) { ++ticks; }));
+			}
+			else if (i % 10 == 0) {
+				processManager.AttachProcess(std::make_shared<IdleProcess>());
+			}
+			else if (sleeping) {
+				processManager.AttachProcess(std::make_shared<DelayProcess>(1000.0f));
+			}
+			else {
+				processManager.AttachProcess(std::make_shared<DelayProcess>(1000.0f, [](float, float, float) { return true; }));
+			}
+		}
+		// The first update initializes everything and parks the sleepers
+		processManager.UpdateProcesses(frameSeconds);
+
+		BenchmarkStage update;
+		for (int frame = 0; frame < frameCount; ++frame) {
+			gameTimePoint start = gameClock::now();
+			processManager.UpdateProcesses(frameSeconds);
+			update.Add(ElapsedMs(start, gameClock::now()), frame);
+		}
+		out << (sleeping ? "delays sleeping" : "delays ticking") << ": " << processManager.GetActiveProcessCount() << " active, "
+			<< processManager.GetSleepingProcessCount() << " sleeping, " << ticks << " counter ticks\n";
+		out << "  update ms avg " << (frameCount > 0 ? update.total / frameCount : 0.0) << ", min " << update.min << ", max " << update.max << "\n";
+	}
+	return out.str();
+}
\ No newline at end of file
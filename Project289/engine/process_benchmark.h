@@ -0,0 +1,7 @@
+#pragma once
+
+#include <string>
+
+// Runs processCount processes for frameCount frames, 90% DelayProcesses, 9% processes that do nothing and 1% counters,
+// once with the delays sleeping in the timer heap and once with every delay ticking each frame.
+std::string BenchmarkProcesses(int processCount, int frameCount);
\ No newline at end of file
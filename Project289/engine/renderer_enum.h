@@ -6,5 +6,6 @@ enum class Renderer {
 	Renderer_D3D11,
 	Renderer_D3D12,
 	Renderer_OpenGL,
-	Renderer_Vulkan
+	Renderer_Vulkan,
+	Renderer_Headless
 };
\ No newline at end of file
@@ -0,0 +1,155 @@
+#include "scene_benchmark.h"
+#include "engine.h"
+#include "base_engine_state.h"
+#include "../nodes/scene.h"
+#include "../nodes/camera_node.h"
+#include "../nodes/frustum.h"
+#include "../events/i_event_manager.h"
+#include "../tools/game_timer.h"
+
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+	enum BenchmarkStageIndex {
+		Stage_Events,
+		Stage_Logic,
+		Stage_SceneUpdate,
+		Stage_Transforms,
+		Stage_Cull,
+		Stage_Occlusion,
+		Stage_Lighting,
+		Stage_Traversal,
+		Stage_Submit,
+		Stage_Alpha,
+		Stage_Frame,
+		Stage_Count
+	};
+
+	// Occlusion runs inside the cull stage and is already counted in it, the indent marks it as a sub-stage
+	const char* const StageNames[Stage_Count] = {
+		"events", "logic", "scene update", "transforms", "cull", "  occlusion", "lighting", "traversal", "submit", "alpha", "frame"
+	};
+}
+
+SceneBenchmark::SceneBenchmark(HeadlessRenderer* renderer) : m_renderer(renderer), m_frames(0), m_last_frame_commands(0u) {
+	m_scene = std::make_unique<Scene>(renderer);
+
+	// Same camera a HumanView starts with
+	Frustum frustum;
+	frustum.Init(DirectX::XM_PI / 4.0f, 1.0f, 1.0f, 100.0f);
+	m_camera = std::make_shared<CameraNode>(DirectX::XMMatrixIdentity(), frustum);
+	m_scene->AddChild(INVALID_ACTOR_ID, m_camera);
+	m_scene->SetCamera(m_camera);
+
+	m_stages.resize(Stage_Count);
+	for (int i = 0; i < Stage_Count; ++i) {
+		m_stages[i].name = StageNames[i];
+	}
+}
+
+SceneBenchmark::~SceneBenchmark() {}
+
+bool SceneBenchmark::LoadLevel(const std::string& levelResource) {
+	// The scene already listens for new render components, so the level's nodes land in it while loading
+	BaseEngineLogic* pGame = g_pApp->GetGameLogic();
+	if (!pGame->VLoadGame(levelResource.c_str())) {
+		return false;
+	}
+	pGame->VChangeState(BaseEngineState::BGS_Running);
+	m_scene->OnRestore();
+	return true;
+}
+
+int SceneBenchmark::SpawnActors(const std::string& actorResource, int count, float spacing) {
+	BaseEngineLogic* pGame = g_pApp->GetGameLogic();
+	int side = static_cast<int>(std::ceil(std::cbrt(static_cast<float>(count))));
+	float half = (side - 1) * spacing * 0.5f;
+	// Far enough down the view that the nearest layer fits in the 45 degree frustum
+	float nearZ = half / std::tan(DirectX::XM_PI / 8.0f) + spacing;
+
+	int spawned = 0;
+	for (int i = 0; i < count; ++i) {
+		float x = (i % side) * spacing - half;
+		float y = ((i / side) % side) * spacing - half;
+		float z = nearZ + (i / (side * side)) * spacing;
+		if (pGame->VCreateActor(actorResource, nullptr, DirectX::XMMatrixTranslation(x, y, z))) {
+			++spawned;
+		}
+	}
+	return spawned;
+}
+
+void SceneBenchmark::SetInstancing(bool enabled) {
+	m_scene->GetRenderQueue().SetInstancing(enabled);
+}
+
+void SceneBenchmark::SetOcclusionCulling(bool enabled) {
+	m_scene->SetOcclusionCulling(enabled);
+}
+
+void SceneBenchmark::Run(int frameCount, float frameSeconds) {
+	BaseEngineLogic* pGame = g_pApp->GetGameLogic();
+	m_renderer->SetRecording(true);
+	// A benchmark can run more than once, min and max restart with frame 0
+	for (BenchmarkStage& stage : m_stages) {
+		stage.total = 0.0;
+	}
+
+	float time = 0.0f;
+	for (int frame = 0; frame < frameCount; ++frame) {
+		m_renderer->ResetStats();
+		m_renderer->ClearCommands();
+		time += frameSeconds;
+
+		gameTimePoint start = gameClock::now();
+		IEventManager::Get()->VUpdate();
+		gameTimePoint eventsDone = gameClock::now();
+		pGame->VOnUpdate(time, frameSeconds);
+		gameTimePoint logicDone = gameClock::now();
+		m_scene->OnUpdate(frameSeconds);
+		gameTimePoint updateDone = gameClock::now();
+		m_renderer->VPreRender();
+		m_scene->OnRender();
+		m_renderer->VPostRender();
+		gameTimePoint renderDone = gameClock::now();
+
+		const SceneRenderTimings& timings = m_scene->GetRenderTimings();
+		m_stages[Stage_Events].Add(ElapsedMs(start, eventsDone), frame);
+		m_stages[Stage_Logic].Add(ElapsedMs(eventsDone, logicDone), frame);
+		m_stages[Stage_SceneUpdate].Add(ElapsedMs(logicDone, updateDone), frame);
+		m_stages[Stage_Transforms].Add(timings.transforms, frame);
+		m_stages[Stage_Cull].Add(timings.cull, frame);
+		m_stages[Stage_Occlusion].Add(timings.occlusion, frame);
+		m_stages[Stage_Lighting].Add(timings.lighting, frame);
+		m_stages[Stage_Traversal].Add(timings.traversal, frame);
+		m_stages[Stage_Submit].Add(timings.submit, frame);
+		m_stages[Stage_Alpha].Add(timings.alpha, frame);
+		m_stages[Stage_Frame].Add(ElapsedMs(start, renderDone), frame);
+	}
+
+	m_frames = frameCount;
+	m_last_frame_stats = m_renderer->GetStats();
+	m_last_frame_commands = m_renderer->GetCommands().size();
+	m_last_frame_occlusion = m_scene->GetOcclusionStats();
+}
+
+std::string SceneBenchmark::Report() const {
+	std::ostringstream out;
+	out << std::fixed << std::setprecision(3);
+	out << "frames: " << m_frames << "\n";
+	out << std::left << std::setw(14) << "stage" << std::right << std::setw(10) << "avg ms" << std::setw(10) << "min ms" << std::setw(10) << "max ms" << "\n";
+	for (const BenchmarkStage& stage : m_stages) {
+		double average = m_frames > 0 ? stage.total / m_frames : 0.0;
+		out << std::left << std::setw(14) << stage.name << std::right << std::setw(10) << average << std::setw(10) << stage.min << std::setw(10) << stage.max << "\n";
+	}
+	out << "occlusion is part of cull and is not counted again in frame\n";
+	out << "last frame: " << m_last_frame_stats.draws << " draws (" << m_last_frame_stats.instances << " instances), " << m_last_frame_stats.indices << " indices, "
+		<< m_last_frame_stats.stateChanges << " state changes, " << m_last_frame_stats.constantBufferUpdates << " constant buffer updates ("
+		<< m_last_frame_stats.constantBufferBytes << " bytes), " << m_last_frame_commands << " recorded commands\n";
+	out << "occlusion: " << m_last_frame_occlusion.occluders << " occluders (" << m_last_frame_occlusion.triangles << " triangles), "
+		<< m_last_frame_occlusion.occluded << " of " << m_last_frame_occlusion.tested << " actors culled, rasterize "
+		<< m_last_frame_occlusion.rasterizeMs << " ms, test " << m_last_frame_occlusion.testMs << " ms\n";
+	return out.str();
+}
\ No newline at end of file
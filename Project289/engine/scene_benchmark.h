@@ -0,0 +1,39 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark_stage.h"
+#include "headless_renderer.h"
+#include "../nodes/occlusion_culler.h"
+
+class Scene;
+class CameraNode;
+
+// Plays a level on the headless renderer for a fixed number of frames with a fixed time step and collects the CPU
+// time of each stage of the frame: events, game logic, scene update and the stages of Scene::OnRender.
+class SceneBenchmark {
+	HeadlessRenderer* m_renderer;
+	std::unique_ptr<Scene> m_scene;
+	std::shared_ptr<CameraNode> m_camera;
+	std::vector<BenchmarkStage> m_stages;
+	int m_frames;
+
+	// Last frame of the run, the command stream is recorded every frame so its cost is part of the timings.
+	RenderStats m_last_frame_stats;
+	size_t m_last_frame_commands;
+	OcclusionStats m_last_frame_occlusion;
+
+public:
+	explicit SceneBenchmark(HeadlessRenderer* renderer);
+	~SceneBenchmark();
+
+	bool LoadLevel(const std::string& levelResource);
+	// Adds count copies of an actor on a grid in front of the camera and returns how many were created.
+	int SpawnActors(const std::string& actorResource, int count, float spacing = 1.5f);
+	void SetInstancing(bool enabled);
+	void SetOcclusionCulling(bool enabled);
+	void Run(int frameCount, float frameSeconds = 1.0f / 60.0f);
+	std::string Report() const;
+};
\ No newline at end of file
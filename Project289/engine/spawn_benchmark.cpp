@@ -0,0 +1,55 @@
+#include "spawn_benchmark.h"
+#include "benchmark_stage.h"
+#include "../actors/actor_factory.h"
+#include "../actors/actor_memory_report.h"
+#include "../actors/component_store.h"
+
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+std::string BenchmarkSpawn(const std::string& actorResource, int count) {
+	ActorFactory factory;
+	ComponentStore store;
+	std::vector<StrongActorPtr> actors;
+	actors.reserve(static_cast<size_t>(count));
+	std::vector<std::shared_ptr<ActorComponent>> changedComponents;
+
+	std::ostringstream out;
+	out << std::fixed << std::setprecision(3);
+	out << actorResource << ", actors: " << count << "\n";
+
+	// Actors are only built, finishing them would queue render component events for a scene that does not exist
+	for (int cached = 0; cached < 2; ++cached) {
+		factory.ClearPrototypes();
+		gameTimePoint start = gameClock::now();
+		for (int i = 0; i < count; ++i) {
+			if (!cached) {
+				factory.ClearPrototypes();
+			}
+			changedComponents.clear();
+			StrongActorPtr pActor = factory.BuildActor(actorResource.c_str(), nullptr, nullptr, factory.ReserveActorId(INVALID_ACTOR_ID), changedComponents);
+			if (!pActor) {
+				out << "failed to build " << actorResource << "\n";
+				return out.str();
+			}
+			store.AddActor(*pActor);
+			actors.push_back(std::move(pActor));
+		}
+		double ms = ElapsedMs(start, gameClock::now());
+		out << (cached ? "prototype clone" : "parse per spawn") << ": " << ms << " ms, " << (ms > 0.0 ? count * 1000.0 / ms : 0.0) << " actors/s\n";
+		if (cached) {
+			out << "pools with every actor alive:\n" << GetActorMemoryReport(store);
+		}
+
+		for (const StrongActorPtr& pActor : actors) {
+			store.RemoveActor(*pActor);
+			pActor->Destroy();
+		}
+		actors.clear();
+	}
+
+	// Live counts should drop back to zero, prototypes are not pooled; reserved bytes stay since pools keep their chunks
+	out << "pools after destroying them:\n" << GetActorMemoryReport(store);
+	return out.str();
+}
\ No newline at end of file
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <string>
+
+// Builds count actors from one template with a fresh ActorFactory, first re-reading the template for every actor as
+// the factory did before prototypes and then cloning the cached prototype, and reports actors per second for both.
+// Needs an initialized engine for the components' VInit.
+std::string BenchmarkSpawn(const std::string& actorResource, int count);
\ No newline at end of file
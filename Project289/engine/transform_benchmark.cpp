@@ -0,0 +1,105 @@
+#include "transform_benchmark.h"
+#include "benchmark_stage.h"
+#include "headless_renderer.h"
+#include "../nodes/scene.h"
+#include "../nodes/camera_node.h"
+#include "../nodes/frustum.h"
+
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <vector>
+
+std::string BenchmarkTransforms(HeadlessRenderer* renderer, int nodeCount, int frameCount) {
+	const int groupSize = 8;
+	Scene scene(renderer);
+	Frustum frustum;
+	frustum.Init(DirectX::XM_PI / 4.0f, 1.0f, 1.0f, 100.0f);
+	std::shared_ptr<CameraNode> camera = std::make_shared<CameraNode>(DirectX::XMMatrixIdentity(), frustum);
+	scene.AddChild(INVALID_ACTOR_ID, camera);
+	scene.SetCamera(camera);
+
+	// Parents spread through a volume a bit wider than the view, so the cull keeps roughly half of them
+	std::mt19937 rng(289u);
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> depth(1.0f, 110.0f);
+	std::uniform_real_distribution<float> radius(0.25f, 1.0f);
+	std::vector<std::shared_ptr<SceneNode>> parents;
+	std::vector<std::shared_ptr<SceneNode>> nodes;
+	nodes.reserve(static_cast<size_t>(nodeCount));
+	while (static_cast<int>(nodes.size()) < nodeCount) {
+		float z = depth(rng);
+		std::shared_ptr<SceneNode> pParent = std::make_shared<SceneNode>(nullptr, RenderPass::RenderPass_Actor, DirectX::XMMatrixTranslation(unit(rng) * z * 0.6f, unit(rng) * z * 0.6f, z), DirectX::XMMatrixIdentity());
+		pParent->SetRadius(radius(rng));
+		nodes.push_back(pParent);
+		for (int i = 1; i < groupSize && static_cast<int>(nodes.size()) < nodeCount; ++i) {
+			std::shared_ptr<SceneNode> pChild = std::make_shared<SceneNode>(nullptr, RenderPass::RenderPass_Actor, DirectX::XMMatrixTranslation(unit(rng) * 2.0f, unit(rng) * 2.0f, unit(rng) * 2.0f), DirectX::XMMatrixIdentity());
+			pChild->SetRadius(radius(rng));
+			pParent->VAddChild(pChild);
+			nodes.push_back(pChild);
+		}
+		scene.AddChild(INVALID_ACTOR_ID, pParent);
+		parents.push_back(pParent);
+	}
+
+	// First pass flattens the hierarchy and places the camera, the runs only time the per frame work
+	scene.UpdateTransforms();
+	camera->SetViewTransform(&scene);
+
+	std::ostringstream out;
+	out << std::fixed << std::setprecision(3);
+	out << "nodes: " << nodes.size() << " in " << parents.size() << " groups, frames: " << frameCount << "\n";
+
+	const char* const runNames[3] = { "nothing moving", "1% of groups moving", "every node dirty" };
+	size_t movingStride = 100u;
+	for (int run = 0; run < 3; ++run) {
+		BenchmarkStage transforms;
+		BenchmarkStage cull;
+		for (int frame = 0; frame < frameCount; ++frame) {
+			if (run == 1) {
+				for (size_t i = frame % movingStride; i < parents.size(); i += movingStride) {
+					DirectX::XMFLOAT3 position = parents[i]->GetPosition3();
+					position.x += (frame & 1) ? 0.01f : -0.01f;
+					parents[i]->SetPosition3(position);
+				}
+			}
+			else if (run == 2) {
+				for (const std::shared_ptr<SceneNode>& pNode : nodes) {
+					pNode->MarkWorldDirty();
+				}
+			}
+
+			gameTimePoint start = gameClock::now();
+			scene.UpdateTransforms();
+			gameTimePoint transformsDone = gameClock::now();
+			scene.CullNodes();
+			gameTimePoint cullDone = gameClock::now();
+			transforms.Add(ElapsedMs(start, transformsDone), frame);
+			cull.Add(ElapsedMs(transformsDone, cullDone), frame);
+		}
+		out << runNames[run] << "\n";
+		out << "  transforms ms avg " << (frameCount > 0 ? transforms.total / frameCount : 0.0) << ", min " << transforms.min << ", max " << transforms.max << "\n";
+		out << "  cull ms avg " << (frameCount > 0 ? cull.total / frameCount : 0.0) << ", min " << cull.min << ", max " << cull.max << "\n";
+	}
+
+	// The test SceneNode::VIsVisible did per node before the cull stage: world position to view space, six planes
+	DirectX::XMMATRIX view = DirectX::XMLoadFloat4x4(&camera->GetView4x4());
+	BenchmarkStage scalar;
+	size_t scalarVisible = 0u;
+	for (int frame = 0; frame < frameCount; ++frame) {
+		scalarVisible = 0u;
+		gameTimePoint start = gameClock::now();
+		for (const std::shared_ptr<SceneNode>& pNode : nodes) {
+			DirectX::XMVECTOR position = DirectX::XMVector3TransformCoord(pNode->GetWorldPosition(), view);
+			scalarVisible += camera->GetFrustum().Inside(position, pNode->VGet().Radius()) ? 1u : 0u;
+		}
+		scalar.Add(ElapsedMs(start, gameClock::now()), frame);
+	}
+	size_t simdVisible = 0u;
+	for (const std::shared_ptr<SceneNode>& pNode : nodes) {
+		simdVisible += pNode->VIsVisible(&scene) ? 1u : 0u;
+	}
+	out << "per node view space test ms avg " << (frameCount > 0 ? scalar.total / frameCount : 0.0) << ", min " << scalar.min << ", max " << scalar.max << "\n";
+	out << "visible: " << simdVisible << " by the cull stage, " << scalarVisible << " by the per node test\n";
+	return out.str();
+}
\ No newline at end of file
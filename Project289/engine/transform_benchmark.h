@@ -0,0 +1,11 @@
+#pragma once
+
+#include <string>
+
+class HeadlessRenderer;
+
+// Builds a synthetic scene of nodeCount plain scene nodes, groups of a parent and seven children spread through the
+// default camera's view, and times Scene::UpdateTransforms and Scene::CullNodes over frameCount frames with nothing
+// moving, with 1% of the groups moving and with every node dirty as before world transforms were cached. The SIMD
+// cull is checked against the old per node view space Frustum::Inside test. Needs an initialized engine for the scene.
+std::string BenchmarkTransforms(HeadlessRenderer* renderer, int nodeCount, int frameCount);
\ No newline at end of file
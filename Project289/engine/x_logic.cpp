@@ -15,6 +15,7 @@
 #include "../engine/engine.h"
 #include "../processes/exec_process.h"
 #include "../processes/delay_process.h"
+#include "level_load_process.h"
 
 XLogic::XLogic() {
 	
@@ -59,9 +60,10 @@ void XLogic::VChangeState(BaseEngineState newState) {
 			std::shared_ptr<DelayProcess> delay = std::make_shared<DelayProcess>(2.0f, [](float dt, float tt, float n) {
 				return true;
 			});
-			std::shared_ptr<ExecProcess> exec2 = std::make_shared<ExecProcess>([]() {
-				std::shared_ptr<HumanView> gameView(new XHumanView(g_pApp->GetRenderer()));
-				g_pApp->GetGameLogic()->VLoadGame("World.xml", gameView);
+			// The level is built on the job system while the menu keeps drawing, the view is attached once every actor is committed
+			std::shared_ptr<HumanView> gameView(new XHumanView(g_pApp->GetRenderer()));
+			std::shared_ptr<LevelLoadProcess> load = std::make_shared<LevelLoadProcess>("World.xml", gameView);
+			std::shared_ptr<ExecProcess> exec2 = std::make_shared<ExecProcess>([gameView]() {
 				gameView->VCanDraw(false);
 
 				g_pApp->GetGameLogic()->VAddView(gameView);
@@ -73,7 +75,8 @@ void XLogic::VChangeState(BaseEngineState newState) {
 				return true;
 			});
 			execOne->AttachChild(delay);
-			delay->AttachChild(exec2);
+			delay->AttachChild(load);
+			load->AttachChild(exec2);
 			exec2->AttachChild(exec3);
 			m_process_manager->AttachProcess(execOne);
 
@@ -56,8 +56,15 @@ void XPhysics::VOnUpdate(float deltaSeconds) {
 void XPhysics::VSyncVisibleScene() {
 	using namespace DirectX;
 	for (const auto& [key, val] : m_particle_array) {
-		StrongActorPtr pActor = MakeStrongPtr(g_pApp->GetGameLogic()->VGetActor(key));
-		std::shared_ptr<TransformComponent> pTransformComponent = MakeStrongPtr(pActor->GetComponent<TransformComponent>(TransformComponent::g_Name));
+		ComponentRef<TransformComponent>& transformRef = m_transform_refs[key];
+		TransformComponent* pTransformComponent = transformRef.Get();
+		if (!pTransformComponent) {
+			StrongActorPtr pActor = MakeStrongPtr(g_pApp->GetGameLogic()->VGetActor(key));
+			if (!pActor) { continue; }
+			transformRef = g_pApp->GetGameLogic()->GetComponentStore()->MakeRef<TransformComponent>(*pActor);
+			pTransformComponent = pActor->GetComponentFast<TransformComponent>();
+			if (!pTransformComponent) { continue; }
+		}
 		XMVECTOR newPos = val->getPosition();
 		XMVECTOR oldPos = pTransformComponent->GetPosition();
 		if (!XMVector3NearEqual(newPos, oldPos, XMVectorReplicate(EPSILON))) {
@@ -83,19 +90,32 @@ std::vector<Particle*>& XPhysics::VGetParticles() {
 }
 
 void XPhysics::VRemoveParticle(Particle* p) {
+	// Components remove themselves when destroyed, usually after DestroyActorDelegate already did, so a miss is fine
 	auto it = std::find_if(m_particle_array.begin(), m_particle_array.end(), [p](const std::pair<ActorId, Particle*>& t) -> bool { return t.second == p; });
+	if (it == m_particle_array.end()) {
+		return;
+	}
 	ActorId act = (*it).first;
 	m_particle_array.erase(act);
+	m_transform_refs.erase(act);
 	ParticleWorld::Particles& particles = m_particle_world.getParticles();
 	particles.erase(std::find(particles.begin(), particles.end(), p));
 }
 
 void XPhysics::VRemoveActorParticle(ActorId id) {
-	Particle* pParticle = m_particle_array[id];
+	auto findIt = m_particle_array.find(id);
+	if (findIt == m_particle_array.end()) {
+		return;
+	}
+	Particle* pParticle = findIt->second;
 	ParticleWorld::Particles& particles = m_particle_world.getParticles();
-	particles.erase(std::find(particles.begin(), particles.end(), pParticle));
+	auto particleIt = std::find(particles.begin(), particles.end(), pParticle);
+	if (particleIt != particles.end()) {
+		particles.erase(particleIt);
+	}
 
 	m_particle_array.erase(id);
+	m_transform_refs.erase(id);
 }
 
 void XPhysics::VAddContactGenerator(ActorId id) {
@@ -10,6 +10,7 @@
 #include "../tools/math_utitity.h"
 
 #include "../actors/actor.h"
+#include "../actors/component_store.h"
 #include "i_engine_physics.h"
 
 #include "../physics/particle.h"
@@ -22,9 +23,12 @@
 
 #include "../events/i_event_data.h"
 
+class TransformComponent;
+
 class XPhysics : public IEnginePhysics {
 	ParticleWorld m_particle_world;
 	std::unordered_map<ActorId, Particle*> m_particle_array;
+	std::unordered_map<ActorId, ComponentRef<TransformComponent>> m_transform_refs;
 	std::unordered_map<ActorId, std::shared_ptr<ParticleContactGenerator>> m_contact_generators;
 	std::unordered_map<ActorId, std::shared_ptr<ParticleForceGenerator>> m_force_generators;
 
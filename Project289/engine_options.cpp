@@ -42,6 +42,9 @@ void EngineOptions::Init(const std::string& xmlFileName) {
 			if (attribute == "Direct3D 11") {
 				m_Renderer = Renderer::Renderer_D3D11;
 			}
+			else if (attribute == "Headless") {
+				m_Renderer = Renderer::Renderer_Headless;
+			}
 
 			if (pNode->Attribute("width")) {
 				m_screenWidth = atoi(pNode->Attribute("width"));
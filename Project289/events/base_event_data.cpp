@@ -9,3 +9,7 @@ gameTimePoint BaseEventData::GetTimeStamp() const {
 void BaseEventData::VSerialize(std::ostream& out) const {}
 
 void BaseEventData::VDeserialize(std::istream& in) {}
+
+void BaseEventData::VSerializeBinary(BinaryWriter& out) const {}
+
+void BaseEventData::VDeserializeBinary(BinaryReader& in) {}
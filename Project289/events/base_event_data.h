@@ -2,15 +2,22 @@
 
 #include "i_event_data.h"
 #include "../tools/game_timer.h"
+#include "../tools/binary_stream.h"
+#include "../tools/fnv_hash.h"
 
 class BaseEventData : public IEventData {
 	const gameTimePoint m_timeStamp;
 
 public:
+	// Events whose binary payload fully describes them redeclare this as true so recordings can re-create them.
+	static constexpr bool sk_Replayable = false;
+
 	explicit BaseEventData(const gameTimePoint timeStamp = gameClock::now());
 
 	gameTimePoint GetTimeStamp() const override;
 
 	virtual void VSerialize(std::ostream& out) const override;
 	virtual void VDeserialize(std::istream& in) override;
+	virtual void VSerializeBinary(BinaryWriter& out) const override;
+	virtual void VDeserializeBinary(BinaryReader& in) override;
 };
\ No newline at end of file
@@ -1,7 +1,11 @@
 #include "event_manager.h"
 
-EventManager::EventManager(const std::string& pName, bool setAsGlobal) : IEventManager(setAsGlobal), m_eventManagerName(pName) {
+EventManager::EventManager(const std::string& pName, bool setAsGlobal) : IEventManager(setAsGlobal), m_eventManagerName(pName), m_frameWheel(EVENTMANAGER_FRAME_WHEEL_SLOTS), m_timeWheel(EVENTMANAGER_TIME_WHEEL_SLOTS) {
 	m_activeQueue = 0;
+	m_frame = 0u;
+	m_timeBase = gameClock::now();
+	m_coalescedCount = 0u;
+	m_lastFrameCoalescedCount = 0u;
 }
 
 bool EventManager::VAddListener(const EventListenerDelegate& eventDelegate, const EventTypeId& type) {
@@ -46,13 +50,21 @@ bool EventManager::VTriggerEvent(const IEventDataPtr& pEvent) const {
 }
 
 bool EventManager::VQueueEvent(const IEventDataPtr& pEvent) {
+	return VQueueEvent(pEvent, EventPriority::NORMAL);
+}
+
+bool EventManager::VQueueEvent(const IEventDataPtr& pEvent, EventPriority priority) {
 	if (!pEvent) {
 		return false;
 	}
 
 	auto findIt = m_eventListeners.find(pEvent->VGetEventType());
 	if (findIt != m_eventListeners.end()) {
-		m_queues[m_activeQueue].push_back(pEvent);
+		if (m_pRecorder) {
+			m_pRecorder->Record(pEvent);
+		}
+
+		PushEvent(m_activeQueue, pEvent, priority);
 		return true;
 	}
 	else {
@@ -60,34 +72,77 @@ bool EventManager::VQueueEvent(const IEventDataPtr& pEvent) {
 	}
 }
 
+bool EventManager::VQueueEvent(const IEventDataPtr& pEvent, gameTimePoint deliverAt, EventPriority priority) {
+	// Same as the next frame queue, nobody would be listening when it is delivered either
+	if (!pEvent || m_eventListeners.find(pEvent->VGetEventType()) == m_eventListeners.end()) {
+		return false;
+	}
+
+	m_timeWheel.Schedule(TimeToTick(deliverAt), { pEvent, priority });
+	++m_pendingCounts[pEvent->VGetEventType()];
+	return true;
+}
+
+bool EventManager::VQueueEvent(const IEventDataPtr& pEvent, EventFrameDelay delay, EventPriority priority) {
+	if (delay.frames <= 1u) {
+		return VQueueEvent(pEvent, priority);
+	}
+	if (!pEvent || m_eventListeners.find(pEvent->VGetEventType()) == m_eventListeners.end()) {
+		return false;
+	}
+
+	m_frameWheel.Schedule(m_frame + delay.frames, { pEvent, priority });
+	++m_pendingCounts[pEvent->VGetEventType()];
+	return true;
+}
+
 bool EventManager::VUpdate() {
 	int queueToProcess = m_activeQueue;
 	m_activeQueue = (m_activeQueue + 1) % EVENTMANAGER_NUM_QUEUES;
-	m_queues[m_activeQueue].clear();
+	for (auto& eventQueue : m_queues[m_activeQueue]) {
+		eventQueue.clear();
+	}
+	m_coalesceSlots[m_activeQueue].clear();
+
+	// Delayed events that come due coalesce with what was queued last frame, the slots are dropped only once the
+	// queue is about to be drained
+	++m_frame;
+	m_frameWheel.Advance(m_frame, [this, queueToProcess](uint64_t tick, PendingEvent& pending) { DeliverDelayed(queueToProcess, pending); });
+	m_timeWheel.Advance(TimeToTick(gameClock::now()), [this, queueToProcess](uint64_t tick, PendingEvent& pending) { DeliverDelayed(queueToProcess, pending); });
+	m_coalesceSlots[queueToProcess].clear();
+
+	m_lastFrameCoalescedCount = m_coalescedCount;
+	m_coalescedCount = 0u;
 
-	while (!m_queues[queueToProcess].empty()) {
-		auto pEvent = m_queues[queueToProcess].front();
-		m_queues[queueToProcess].pop_front();
+	for (auto& eventQueue : m_queues[queueToProcess]) {
+		while (!eventQueue.empty()) {
+			auto pEvent = eventQueue.front();
+			eventQueue.pop_front();
 
-		const unsigned long& eventType = pEvent->VGetEventType();
+			const unsigned long& eventType = pEvent->VGetEventType();
 
-		auto findIt = m_eventListeners.find(eventType);
-		if (findIt != m_eventListeners.end()) {
-			const auto& eventListeners = findIt->second;
+			auto findIt = m_eventListeners.find(eventType);
+			if (findIt != m_eventListeners.end()) {
+				const auto& eventListeners = findIt->second;
 
-			for (auto it = eventListeners.begin(); it != eventListeners.end(); ++it) {
-				auto listener = (*it);
-				listener(pEvent);
+				for (auto it = eventListeners.begin(); it != eventListeners.end(); ++it) {
+					auto listener = (*it);
+					listener(pEvent);
+				}
 			}
 		}
 	}
 
-	bool queueFlushed = (m_queues[queueToProcess].empty());
-	if (!queueFlushed) {
-		while (!m_queues[queueToProcess].empty()) {
-			auto pEvent = m_queues[queueToProcess].back();
-			m_queues[queueToProcess].pop_back();
-			m_queues[m_activeQueue].push_front(pEvent);
+	bool queueFlushed = true;
+	for (unsigned int priority = 0; priority < EVENT_PRIORITY_COUNT; ++priority) {
+		auto& eventQueue = m_queues[queueToProcess][priority];
+		if (!eventQueue.empty()) {
+			queueFlushed = false;
+		}
+		while (!eventQueue.empty()) {
+			auto pEvent = eventQueue.back();
+			eventQueue.pop_back();
+			m_queues[m_activeQueue][priority].push_front(pEvent);
 		}
 	}
 
@@ -99,24 +154,124 @@ bool EventManager::VAbortEvent(const EventTypeId& inType, bool allOfType) {
 	auto findIt = m_eventListeners.find(inType);
 
 	if (findIt != m_eventListeners.end()) {
-		auto& eventQueue = m_queues[m_activeQueue];
-		auto it = eventQueue.begin();
-		while (it != eventQueue.end()) {
-			auto thisIt = it;
-			++it;
-
-			if ((*thisIt)->VGetEventType() == inType) {
-				eventQueue.erase(thisIt);
-				success = true;
-				if (!allOfType)
-					break;
+		for (auto& eventQueue : m_queues[m_activeQueue]) {
+			auto it = eventQueue.begin();
+			while (it != eventQueue.end()) {
+				auto thisIt = it;
+				++it;
+
+				if ((*thisIt)->VGetEventType() == inType) {
+					auto policyIt = m_coalescePolicies.find(inType);
+					if (policyIt != m_coalescePolicies.end()) {
+						m_coalesceSlots[m_activeQueue][inType].erase(policyIt->second(**thisIt));
+					}
+					eventQueue.erase(thisIt);
+					success = true;
+					if (!allOfType)
+						return success;
+				}
 			}
 		}
 	}
 
+	auto pendingIt = m_pendingCounts.find(inType);
+	if (pendingIt == m_pendingCounts.end()) {
+		return success;
+	}
+
+	auto isOfType = [&inType](const PendingEvent& pending) { return pending.pEvent->VGetEventType() == inType; };
+	size_t removed = m_frameWheel.RemoveIf(isOfType, allOfType);
+	if (allOfType || removed == 0u) {
+		removed += m_timeWheel.RemoveIf(isOfType, allOfType);
+	}
+	if (removed > 0u) {
+		success = true;
+		pendingIt->second -= removed;
+		if (pendingIt->second == 0u) {
+			m_pendingCounts.erase(pendingIt);
+		}
+	}
+
 	return success;
 }
 
+void EventManager::SetCoalescePolicy(const EventTypeId& type, EventCoalesceKeyFn keyFn) {
+	if (!keyFn) {
+		RemoveCoalescePolicy(type);
+		return;
+	}
+	m_coalescePolicies[type] = keyFn;
+}
+
+void EventManager::RemoveCoalescePolicy(const EventTypeId& type) {
+	m_coalescePolicies.erase(type);
+	for (auto& slots : m_coalesceSlots) {
+		slots.erase(type);
+	}
+}
+
+unsigned int EventManager::GetLastFrameCoalescedCount() const {
+	return m_lastFrameCoalescedCount;
+}
+
+bool EventManager::StartRecording(const std::string& fileName) {
+	std::unique_ptr<EventRecorder> pRecorder = std::make_unique<EventRecorder>();
+	if (!pRecorder->Open(fileName)) {
+		return false;
+	}
+	m_pRecorder = std::move(pRecorder);
+	return true;
+}
+
+void EventManager::StopRecording() {
+	m_pRecorder.reset();
+}
+
+bool EventManager::IsRecording() const {
+	return m_pRecorder != nullptr;
+}
+
+size_t EventManager::GetDelayedEventCount() const {
+	return m_frameWheel.Size() + m_timeWheel.Size();
+}
+
+uint64_t EventManager::TimeToTick(gameTimePoint time) const {
+	if (time <= m_timeBase) {
+		return 0u;
+	}
+	return static_cast<uint64_t>((time - m_timeBase + EVENTMANAGER_TIME_WHEEL_RESOLUTION - gameClockDuration(1)) / EVENTMANAGER_TIME_WHEEL_RESOLUTION);
+}
+
+void EventManager::DeliverDelayed(int queue, PendingEvent& pending) {
+	auto pendingIt = m_pendingCounts.find(pending.pEvent->VGetEventType());
+	if (--pendingIt->second == 0u) {
+		m_pendingCounts.erase(pendingIt);
+	}
+	if (m_pRecorder) {
+		m_pRecorder->Record(pending.pEvent);
+	}
+	PushEvent(queue, std::move(pending.pEvent), pending.priority);
+}
+
+void EventManager::PushEvent(int queue, IEventDataPtr pEvent, EventPriority priority) {
+	EventQueue& eventQueue = m_queues[queue][static_cast<int>(priority)];
+	auto policyIt = m_coalescePolicies.find(pEvent->VGetEventType());
+	if (policyIt == m_coalescePolicies.end()) {
+		eventQueue.push_back(std::move(pEvent));
+		return;
+	}
+
+	auto& slots = m_coalesceSlots[queue][pEvent->VGetEventType()];
+	uint64_t key = policyIt->second(*pEvent);
+	auto slotIt = slots.find(key);
+	if (slotIt != slots.end()) {
+		m_queues[queue][static_cast<int>(slotIt->second.priority)].erase(slotIt->second.it);
+		++m_coalescedCount;
+	}
+	eventQueue.push_back(std::move(pEvent));
+	slots[key] = { std::prev(eventQueue.end()), priority };
+}
+
 std::ostream& operator<<(std::ostream& os, const EventManager& mgr) {
 	std::ios::fmtflags oldFlag = os.flags();
 
@@ -127,15 +282,31 @@ std::ostream& operator<<(std::ostream& os, const EventManager& mgr) {
 		std::cout << ++counter << ") Listener for event type id: " << eventTypeId << " with name: " << GET_EVENT_NAME(eventTypeId) << std::endl;
 	}
 	std::cout << "Current active queue: " << mgr.m_activeQueue << std::endl;
+	std::cout << "Coalesced events last frame: " << mgr.m_lastFrameCoalescedCount << " this frame: " << mgr.m_coalescedCount << std::endl;
+	if (mgr.m_pRecorder) {
+		std::cout << "Recording to: " << mgr.m_pRecorder->GetFileName() << " events recorded: " << mgr.m_pRecorder->GetEventCount() << std::endl;
+	}
 	std::cout << "Events queue contains:" << std::endl;
 	int queueCounter = 0;
 	int eventCounter = 0;
 	for (const auto& currentQueue : mgr.m_queues) {
 		std::cout << queueCounter++ << ") queue ->" << std::endl;
-		for (const auto& currentEvent : currentQueue) {
-			std::cout << "\t" << ++eventCounter << ") event id: " << currentEvent->VGetEventType() << " with name: " << currentEvent->GetName() << std::endl;
+		for (unsigned int priority = 0; priority < EVENT_PRIORITY_COUNT; ++priority) {
+			for (const auto& currentEvent : currentQueue[priority]) {
+				std::cout << "\t" << ++eventCounter << ") event id: " << currentEvent->VGetEventType() << " with name: " << currentEvent->GetName() << " priority: " << priority << std::endl;
+			}
 		}
 	}
+	std::cout << "Current frame: " << mgr.m_frame << std::endl;
+	std::cout << "Delayed events pending: " << mgr.GetDelayedEventCount() << std::endl;
+	int delayedCounter = 0;
+	mgr.m_frameWheel.ForEach([&delayedCounter](uint64_t tick, const EventManager::PendingEvent& pending) {
+		std::cout << "\t" << ++delayedCounter << ") event id: " << pending.pEvent->VGetEventType() << " with name: " << pending.pEvent->GetName() << " priority: " << static_cast<int>(pending.priority) << " due at frame: " << tick << std::endl;
+	});
+	mgr.m_timeWheel.ForEach([&delayedCounter, &mgr](uint64_t tick, const EventManager::PendingEvent& pending) {
+		auto dueAt = mgr.m_timeBase + tick * EVENTMANAGER_TIME_WHEEL_RESOLUTION;
+		std::cout << "\t" << ++delayedCounter << ") event id: " << pending.pEvent->VGetEventType() << " with name: " << pending.pEvent->GetName() << " priority: " << static_cast<int>(pending.priority) << " due at: " << dueAt.time_since_epoch().count() << "ns" << std::endl;
+	});
 
 	os.flags(oldFlag);
 	return os;
@@ -4,18 +4,55 @@
 #include <unordered_map>
 #include <list>
 #include <string>
+#include <memory>
+#include <cstdint>
+#include <iterator>
 
 #include "i_event_manager.h"
+#include "event_recorder.h"
+#include "../tools/timing_wheel.h"
 
 const unsigned int EVENTMANAGER_NUM_QUEUES = 2;
+const size_t EVENTMANAGER_FRAME_WHEEL_SLOTS = 256u;
+const size_t EVENTMANAGER_TIME_WHEEL_SLOTS = 4096u;
+const gameClockDuration EVENTMANAGER_TIME_WHEEL_RESOLUTION = std::chrono::milliseconds(1);
+
+// Maps a queued event to its coalescing slot, events of one type with equal keys replace each other within a frame.
+using EventCoalesceKeyFn = uint64_t(*)(const IEventData& evt);
 
 class EventManager : public IEventManager {
+	using EventQueue = std::list<IEventDataPtr>;
+
+	struct CoalesceSlot {
+		EventQueue::iterator it;
+		EventPriority priority;
+	};
+	using CoalesceSlots = std::unordered_map<EventTypeId, std::unordered_map<uint64_t, CoalesceSlot>>;
+
+	struct PendingEvent {
+		IEventDataPtr pEvent;
+		EventPriority priority;
+	};
+
 	std::unordered_map<EventTypeId, std::list<EventListenerDelegate>> m_eventListeners;
 	const std::string m_eventManagerName;
 
-	std::list<IEventDataPtr> m_queues[EVENTMANAGER_NUM_QUEUES];
+	EventQueue m_queues[EVENTMANAGER_NUM_QUEUES][EVENT_PRIORITY_COUNT];
 	int m_activeQueue;
 
+	uint64_t m_frame;
+	gameTimePoint m_timeBase;
+	TimingWheel<PendingEvent> m_frameWheel;
+	TimingWheel<PendingEvent> m_timeWheel;
+	std::unordered_map<EventTypeId, size_t> m_pendingCounts;
+
+	std::unordered_map<EventTypeId, EventCoalesceKeyFn> m_coalescePolicies;
+	CoalesceSlots m_coalesceSlots[EVENTMANAGER_NUM_QUEUES];
+	unsigned int m_coalescedCount;
+	unsigned int m_lastFrameCoalescedCount;
+
+	std::unique_ptr<EventRecorder> m_pRecorder;
+
 public:
 	explicit EventManager(const std::string& pName, bool setAsGlobal);
 
@@ -24,9 +61,30 @@ public:
 
 	bool VTriggerEvent(const IEventDataPtr& pEvent) const override;
 	bool VQueueEvent(const IEventDataPtr& pEvent) override;
+	bool VQueueEvent(const IEventDataPtr& pEvent, EventPriority priority) override;
+	bool VQueueEvent(const IEventDataPtr& pEvent, gameTimePoint deliverAt, EventPriority priority) override;
+	bool VQueueEvent(const IEventDataPtr& pEvent, EventFrameDelay delay, EventPriority priority) override;
 	bool VUpdate() override;
+	// Types with nothing pending skip the wheels, otherwise each wheel is walked slot by slot, O(slots + pending).
 	bool VAbortEvent(const EventTypeId& inType, bool allOfType) override;
 
+	void SetCoalescePolicy(const EventTypeId& type, EventCoalesceKeyFn keyFn);
+	void RemoveCoalescePolicy(const EventTypeId& type);
+	unsigned int GetLastFrameCoalescedCount() const;
+
+	bool StartRecording(const std::string& fileName);
+	void StopRecording();
+	bool IsRecording() const;
+
+	size_t GetDelayedEventCount() const;
+
+private:
+	uint64_t TimeToTick(gameTimePoint time) const;
+	void DeliverDelayed(int queue, PendingEvent& pending);
+	// Appends to a queue, an event replacing a coalesced one drops the old entry and goes to the back, so delivery
+	// keeps the order of the latest writes.
+	void PushEvent(int queue, IEventDataPtr pEvent, EventPriority priority);
+
 	friend std::ostream& operator<<(std::ostream& os, const EventManager& mgr);
 };
 
@@ -0,0 +1,68 @@
+#include "event_recorder.h"
+#include "event_registry.h"
+
+EventRecorder::EventRecorder() : m_eventCount(0u) {}
+
+EventRecorder::~EventRecorder() {
+	Close();
+}
+
+bool EventRecorder::Open(const std::string& fileName) {
+	Close();
+
+	m_file.open(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!m_file.is_open()) {
+		return false;
+	}
+
+	m_fileName = fileName;
+	m_startTime = gameClock::now();
+	m_eventCount = 0u;
+
+	BinaryWriter header;
+	header.WriteU32(EVENT_RECORD_MAGIC);
+	header.WriteU16(EVENT_RECORD_VERSION);
+	header.WriteU16(0u);
+	m_file.write(reinterpret_cast<const char*>(header.GetData()), header.GetSize());
+
+	return m_file.good();
+}
+
+void EventRecorder::Close() {
+	if (m_file.is_open()) {
+		m_file.flush();
+		m_file.close();
+	}
+}
+
+bool EventRecorder::IsOpen() const {
+	return m_file.is_open();
+}
+
+void EventRecorder::Record(const IEventDataPtr& pEvent) {
+	if (!pEvent || !m_file.is_open()) { return; }
+	if (!IsEventReplayable(pEvent->VGetEventType())) { return; }
+
+	m_payload.Clear();
+	pEvent->VSerializeBinary(m_payload);
+
+	gameClockDuration sinceStart = gameClock::now() - m_startTime;
+	long long timeUs = std::chrono::duration_cast<std::chrono::microseconds>(sinceStart).count();
+
+	m_record.Clear();
+	m_record.WriteVarint(pEvent->VGetEventType());
+	m_record.WriteVarint(timeUs > 0 ? static_cast<uint64_t>(timeUs) : 0u);
+	m_record.WriteVarint(m_payload.GetSize());
+	m_record.WriteBytes(m_payload.GetData(), m_payload.GetSize());
+
+	m_file.write(reinterpret_cast<const char*>(m_record.GetData()), m_record.GetSize());
+	++m_eventCount;
+}
+
+const std::string& EventRecorder::GetFileName() const {
+	return m_fileName;
+}
+
+size_t EventRecorder::GetEventCount() const {
+	return m_eventCount;
+}
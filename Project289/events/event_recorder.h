@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "i_event_data.h"
+#include "../tools/binary_stream.h"
+#include "../tools/game_timer.h"
+
+const uint32_t EVENT_RECORD_MAGIC = 0x43525645; // "EVRC"
+const uint16_t EVENT_RECORD_VERSION = 2u;
+
+// Record layout: varint event type, varint microseconds from recording start to queueing, varint payload size, payload.
+class EventRecorder {
+	std::ofstream m_file;
+	std::string m_fileName;
+	gameTimePoint m_startTime;
+	BinaryWriter m_record;
+	BinaryWriter m_payload;
+	size_t m_eventCount;
+
+public:
+	EventRecorder();
+	~EventRecorder();
+
+	bool Open(const std::string& fileName);
+	void Close();
+	bool IsOpen() const;
+
+	void Record(const IEventDataPtr& pEvent);
+
+	const std::string& GetFileName() const;
+	size_t GetEventCount() const;
+};
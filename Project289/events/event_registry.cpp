@@ -0,0 +1,69 @@
+#include "event_registry.h"
+
+#include "evt_data_destroy_actor.h"
+#include "evt_data_destroy_particle_component.h"
+#include "evt_data_destroy_particle_contact_generator.h"
+#include "evt_data_destroy_particle_force_generator.h"
+#include "evt_data_end_thrust.h"
+#include "evt_data_environment_loaded.h"
+#include "evt_data_level_loaded.h"
+#include "evt_data_modified_render_component.h"
+#include "evt_data_move_actor.h"
+#include "evt_data_new_actor.h"
+#include "evt_data_new_particle_component.h"
+#include "evt_data_new_particle_contact_generator.h"
+#include "evt_data_new_particle_force_generator.h"
+#include "evt_data_new_render_component.h"
+#include "evt_data_request_destroy_actor.h"
+#include "evt_data_request_new_actor.h"
+#include "evt_data_request_start_game.h"
+#include "evt_data_start_thrust.h"
+#include "evt_data_update_tick.h"
+
+using GameEventRegistry = EventRegistry<
+	EvtData_Destroy_Actor,
+	EvtData_Destroy_Particle_Component,
+	EvtData_Destroy_Particle_Contact_Generator,
+	EvtData_Destroy_Particle_Force_Generator,
+	EvtData_EndThrust,
+	EvtData_Environment_Loaded,
+	EvtData_Level_Loaded,
+	EvtData_Modified_Render_Component,
+	EvtData_Move_Actor,
+	EvtData_New_Actor,
+	EvtData_New_Particle_Component,
+	EvtData_New_Particle_Contact_Generator,
+	EvtData_New_Particle_Force_Generator,
+	EvtData_New_Render_Component,
+	EvtData_Request_Destroy_Actor,
+	EvtData_Request_New_Actor,
+	EvtData_Request_Start_Game,
+	EvtData_StartThrust,
+	EvtData_Update_Tick
+>;
+
+IEventData* CreateRegisteredEvent(EventTypeId id) {
+	const EventRegistryEntry* pEntry = GameEventRegistry::Find(id);
+	if (pEntry && pEntry->pCreate) {
+		return pEntry->pCreate();
+	}
+	return nullptr;
+}
+
+const std::string& GetRegisteredEventName(EventTypeId id) {
+	static const std::string notRegistered = "No name or not registered";
+	const EventRegistryEntry* pEntry = GameEventRegistry::Find(id);
+	if (pEntry) {
+		return *pEntry->pName;
+	}
+	return notRegistered;
+}
+
+bool IsEventRegistered(EventTypeId id) {
+	return GameEventRegistry::Find(id) != nullptr;
+}
+
+bool IsEventReplayable(EventTypeId id) {
+	const EventRegistryEntry* pEntry = GameEventRegistry::Find(id);
+	return pEntry && pEntry->replayable;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <type_traits>
+
+#include "i_event_data.h"
+
+struct EventRegistryEntry {
+	EventTypeId id;
+	const std::string* pName;
+	IEventData* (*pCreate)();
+	bool replayable;
+};
+
+template <class EventClass>
+IEventData* CreateRegisteredEventInstance() {
+	return new EventClass;
+}
+
+template <class EventClass>
+constexpr EventRegistryEntry MakeEventRegistryEntry() {
+	if constexpr (std::is_default_constructible_v<EventClass>) {
+		return EventRegistryEntry{ EventClass::sk_EventType, &EventClass::sk_EventName, &CreateRegisteredEventInstance<EventClass>, EventClass::sk_Replayable };
+	}
+	else {
+		return EventRegistryEntry{ EventClass::sk_EventType, &EventClass::sk_EventName, nullptr, false };
+	}
+}
+
+template <size_t N>
+constexpr std::array<EventRegistryEntry, N> SortEventRegistryEntries(std::array<EventRegistryEntry, N> entries) {
+	for (size_t i = 1u; i < N; ++i) {
+		EventRegistryEntry entry = entries[i];
+		size_t j = i;
+		while (j > 0u && entries[j - 1u].id > entry.id) {
+			entries[j] = entries[j - 1u];
+			--j;
+		}
+		entries[j] = entry;
+	}
+	return entries;
+}
+
+template <size_t N>
+constexpr bool HasUniqueEventIds(const std::array<EventRegistryEntry, N>& sortedEntries) {
+	for (size_t i = 1u; i < N; ++i) {
+		if (sortedEntries[i - 1u].id == sortedEntries[i].id) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Compile-time table of event classes sorted by type id, lookups are a binary search over a flat array.
+template <class... EventClasses>
+class EventRegistry {
+public:
+	static constexpr size_t sk_Count = sizeof...(EventClasses);
+	static constexpr std::array<EventRegistryEntry, sk_Count> sk_Entries = SortEventRegistryEntries(std::array<EventRegistryEntry, sk_Count>{ MakeEventRegistryEntry<EventClasses>()... });
+
+	static_assert(HasUniqueEventIds(sk_Entries), "Event type id collision, rename one of the event classes");
+
+	static const EventRegistryEntry* Find(EventTypeId id) {
+		size_t lo = 0u;
+		size_t hi = sk_Count;
+		while (lo < hi) {
+			size_t mid = lo + (hi - lo) / 2u;
+			if (sk_Entries[mid].id < id) {
+				lo = mid + 1u;
+			}
+			else {
+				hi = mid;
+			}
+		}
+		return (lo < sk_Count && sk_Entries[lo].id == id) ? &sk_Entries[lo] : nullptr;
+	}
+};
+
+IEventData* CreateRegisteredEvent(EventTypeId id);
+const std::string& GetRegisteredEventName(EventTypeId id);
+bool IsEventRegistered(EventTypeId id);
+bool IsEventReplayable(EventTypeId id);
@@ -22,6 +22,14 @@ void EvtData_Destroy_Actor::VDeserialize(std::istream& in) {
 	in >> m_id;
 }
 
+void EvtData_Destroy_Actor::VSerializeBinary(BinaryWriter& out) const {
+	out.WriteVarint(m_id);
+}
+
+void EvtData_Destroy_Actor::VDeserializeBinary(BinaryReader& in) {
+	m_id = static_cast<ActorId>(in.ReadVarint());
+}
+
 const std::string& EvtData_Destroy_Actor::GetName() const {
 	return sk_EventName;
 }
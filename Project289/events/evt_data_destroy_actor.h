@@ -7,14 +7,17 @@ class EvtData_Destroy_Actor : public BaseEventData {
     ActorId m_id;
 
 public:
-    static const EventTypeId sk_EventType = 0x77dd2b3a;
+    static constexpr EventTypeId sk_EventType = Fnv1a32("EvtData_Destroy_Actor");
     static const std::string sk_EventName;
+    static constexpr bool sk_Replayable = true;
 
     explicit EvtData_Destroy_Actor(ActorId id = 0);
 
     virtual EventTypeId VGetEventType() const override;
     virtual void VSerialize(std::ostream& out) const override;
     virtual void VDeserialize(std::istream& in) override;
+    virtual void VSerializeBinary(BinaryWriter& out) const override;
+    virtual void VDeserializeBinary(BinaryReader& in) override;
     virtual IEventDataPtr VCopy() const override;
     virtual const std::string& GetName() const override;
 
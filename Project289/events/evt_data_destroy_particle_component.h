@@ -11,7 +11,7 @@ class EvtData_Destroy_Particle_Component : public BaseEventData {
     ActorId m_actorId;
 
 public:
-    static const EventTypeId sk_EventType = 0x3118ee5d;
+    static constexpr EventTypeId sk_EventType = Fnv1a32("EvtData_Destroy_Particle_Component");
     static const std::string sk_EventName;
 
     EvtData_Destroy_Particle_Component();
@@ -11,7 +11,7 @@ class EvtData_Destroy_Particle_Force_Generator : public BaseEventData {
     ActorId m_actorId;
 
 public:
-    static const EventTypeId sk_EventType = 0xa2d9b463;
+    static constexpr EventTypeId sk_EventType = Fnv1a32("EvtData_Destroy_Particle_Force_Generator");
     static const std::string sk_EventName;
 
     EvtData_Destroy_Particle_Force_Generator();
@@ -30,6 +30,14 @@ void EvtData_EndThrust::VDeserialize(std::istream& in) {
 	in >> m_id;
 }
 
+void EvtData_EndThrust::VSerializeBinary(BinaryWriter& out) const {
+	out.WriteVarint(m_id);
+}
+
+void EvtData_EndThrust::VDeserializeBinary(BinaryReader& in) {
+	m_id = static_cast<ActorId>(in.ReadVarint());
+}
+
 EvtData_EndThrust::EvtData_EndThrust() : m_id(INVALID_ACTOR_ID) {}
 
 EvtData_EndThrust::EvtData_EndThrust(ActorId id) : m_id(id) {}
@@ -8,8 +8,9 @@ class EvtData_EndThrust : public BaseEventData {
     ActorId m_id;
 
 public:
-    static const EventTypeId sk_EventType = 0xe60f88a4;
+    static constexpr EventTypeId sk_EventType = Fnv1a32("EvtData_EndThrust");
     static const std::string sk_EventName;
+    static constexpr bool sk_Replayable = true;
 
     EvtData_EndThrust();
     EvtData_EndThrust(ActorId id);
@@ -17,6 +18,8 @@ public:
     virtual EventTypeId VGetEventType() const override;
     virtual void VSerialize(std::ostream& out) const override;
     virtual void VDeserialize(std::istream& in) override;
+    virtual void VSerializeBinary(BinaryWriter& out) const override;
+    virtual void VDeserializeBinary(BinaryReader& in) override;
     virtual IEventDataPtr VCopy() const override;
     virtual const std::string& GetName() const override;
 
@@ -4,8 +4,9 @@
 
 class EvtData_Environment_Loaded : public BaseEventData {
 public:
-	static const EventTypeId sk_EventType = 0x8E2AD6E6;
+	static constexpr EventTypeId sk_EventType = Fnv1a32("EvtData_Environment_Loaded");
 	static const std::string sk_EventName;
+	static constexpr bool sk_Replayable = true;
 
 	EvtData_Environment_Loaded();
 
@@ -0,0 +1,49 @@
+#include "evt_data_level_loaded.h"
+
+const std::string EvtData_Level_Loaded::sk_EventName = "EvtData_Level_Loaded";
+
+EvtData_Level_Loaded::EvtData_Level_Loaded() {}
+
+EvtData_Level_Loaded::EvtData_Level_Loaded(const std::string& levelResource) : m_levelResource(levelResource) {}
+
+EventTypeId EvtData_Level_Loaded::VGetEventType() const {
+	return sk_EventType;
+}
+
+void EvtData_Level_Loaded::VSerialize(std::ostream& out) const {
+	out << m_levelResource << " ";
+}
+
+void EvtData_Level_Loaded::VDeserialize(std::istream& in) {
+	in >> m_levelResource;
+}
+
+void EvtData_Level_Loaded::VSerializeBinary(BinaryWriter& out) const {
+	out.WriteString(m_levelResource);
+}
+
+void EvtData_Level_Loaded::VDeserializeBinary(BinaryReader& in) {
+	m_levelResource = in.ReadString();
+}
+
+IEventDataPtr EvtData_Level_Loaded::VCopy() const {
+	return IEventDataPtr(new EvtData_Level_Loaded(m_levelResource));
+}
+
+const std::string& EvtData_Level_Loaded::GetName() const {
+	return sk_EventName;
+}
+
+const std::string& EvtData_Level_Loaded::GetLevelResource() const {
+	return m_levelResource;
+}
+
+std::ostream& operator<<(std::ostream& os, const EvtData_Level_Loaded& evt) {
+	std::ios::fmtflags oldFlag = os.flags();
+	os << "Event type id: " << evt.sk_EventType << std::endl;
+	os << "Event name: " << evt.sk_EventName << std::endl;
+	os << "Event time stamp: " << evt.GetTimeStamp().time_since_epoch().count() << "ns" << std::endl;
+	os << "Event level resource: " << evt.m_levelResource << std::endl;
+	os.flags(oldFlag);
+	return os;
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "base_event_data.h"
+
+// Queued at low priority once a level's last actor is committed, so it is delivered after every event the commits queued.
+class EvtData_Level_Loaded : public BaseEventData {
+	std::string m_levelResource;
+
+public:
+	static constexpr EventTypeId sk_EventType = Fnv1a32("EvtData_Level_Loaded");
+	static const std::string sk_EventName;
+	static constexpr bool sk_Replayable = true;
+
+	EvtData_Level_Loaded();
+	explicit EvtData_Level_Loaded(const std::string& levelResource);
+
+	virtual EventTypeId VGetEventType() const override;
+	virtual void VSerialize(std::ostream& out) const override;
+	virtual void VDeserialize(std::istream& in) override;
+	virtual void VSerializeBinary(BinaryWriter& out) const override;
+	virtual void VDeserializeBinary(BinaryReader& in) override;
+	virtual IEventDataPtr VCopy() const override;
+	virtual const std::string& GetName() const override;
+
+	const std::string& GetLevelResource() const;
+
+	friend std::ostream& operator<<(std::ostream& os, const EvtData_Level_Loaded& evt);
+};
\ No newline at end of file
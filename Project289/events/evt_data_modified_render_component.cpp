@@ -22,6 +22,14 @@ void EvtData_Modified_Render_Component::VDeserialize(std::istream& in) {
     in >> m_id;
 }
 
+void EvtData_Modified_Render_Component::VSerializeBinary(BinaryWriter& out) const {
+    out.WriteVarint(m_id);
+}
+
+void EvtData_Modified_Render_Component::VDeserializeBinary(BinaryReader& in) {
+    m_id = static_cast<ActorId>(in.ReadVarint());
+}
+
 IEventDataPtr EvtData_Modified_Render_Component::VCopy() const {
     return IEventDataPtr(new EvtData_Modified_Render_Component(m_id));
 }
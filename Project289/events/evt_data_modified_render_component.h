@@ -7,8 +7,9 @@ class EvtData_Modified_Render_Component : public BaseEventData {
     ActorId m_id;
 
 public:
-    static const EventTypeId sk_EventType = 0x80fe9766;
+    static constexpr EventTypeId sk_EventType = Fnv1a32("EvtData_Modified_Render_Component");
     static const std::string sk_EventName;
+    static constexpr bool sk_Replayable = true;
 
     EvtData_Modified_Render_Component();
     EvtData_Modified_Render_Component(ActorId id);
@@ -16,6 +17,8 @@ public:
     virtual EventTypeId VGetEventType() const override;
     virtual void VSerialize(std::ostream& out) const override;
     virtual void VDeserialize(std::istream& in) override;
+    virtual void VSerializeBinary(BinaryWriter& out) const override;
+    virtual void VDeserializeBinary(BinaryReader& in) override;
     virtual IEventDataPtr VCopy() const override;
     virtual const std::string& GetName() const override;
 
@@ -33,6 +33,16 @@ void EvtData_Move_Actor::VDeserialize(std::istream& in) {
     }
 }
 
+void EvtData_Move_Actor::VSerializeBinary(BinaryWriter& out) const {
+    out.WriteVarint(m_id);
+    out.WriteFloat4x4(m_matrix);
+}
+
+void EvtData_Move_Actor::VDeserializeBinary(BinaryReader& in) {
+    m_id = static_cast<ActorId>(in.ReadVarint());
+    m_matrix = in.ReadFloat4x4();
+}
+
 IEventDataPtr EvtData_Move_Actor::VCopy() const {
     return IEventDataPtr(new EvtData_Move_Actor(m_id, m_matrix));
 }
@@ -11,8 +11,9 @@ class EvtData_Move_Actor : public BaseEventData {
     DirectX::XMFLOAT4X4 m_matrix;
 
 public:
-    static const EventTypeId sk_EventType = 0xeeaa0a40;
+    static constexpr EventTypeId sk_EventType = Fnv1a32("EvtData_Move_Actor");
     static const std::string sk_EventName;
+    static constexpr bool sk_Replayable = true;
 
     EvtData_Move_Actor();
     EvtData_Move_Actor(ActorId id, const DirectX::XMFLOAT4X4& matrix);
@@ -20,6 +21,8 @@ public:
     virtual EventTypeId VGetEventType() const override;
     virtual void VSerialize(std::ostream& out) const override;
     virtual void VDeserialize(std::istream& in) override;
+    virtual void VSerializeBinary(BinaryWriter& out) const override;
+    virtual void VDeserializeBinary(BinaryReader& in) override;
     virtual IEventDataPtr VCopy() const override;
     virtual const std::string& GetName() const override;
 
@@ -17,6 +17,16 @@ void EvtData_New_Actor::VDeserialize(std::istream& in) {
 	in >> m_viewId;
 }
 
+void EvtData_New_Actor::VSerializeBinary(BinaryWriter& out) const {
+	out.WriteVarint(m_actorId);
+	out.WriteVarint(m_viewId);
+}
+
+void EvtData_New_Actor::VDeserializeBinary(BinaryReader& in) {
+	m_actorId = static_cast<ActorId>(in.ReadVarint());
+	m_viewId = static_cast<unsigned int>(in.ReadVarint());
+}
+
 EventTypeId EvtData_New_Actor::VGetEventType() const {
 	return sk_EventType;
 }
@@ -8,13 +8,16 @@ class EvtData_New_Actor : public BaseEventData {
 	unsigned int m_viewId;
 
 public:
-	static const EventTypeId sk_EventType = 0xe86c7c31;
+	static constexpr EventTypeId sk_EventType = Fnv1a32("EvtData_New_Actor");
 	static const std::string sk_EventName;
+	static constexpr bool sk_Replayable = true;
 
 	EvtData_New_Actor();
 	explicit EvtData_New_Actor(ActorId actorId, unsigned long viewId = 0xffffffff);
 
 	virtual void VDeserialize(std::istream& in) override;
+	virtual void VSerializeBinary(BinaryWriter& out) const override;
+	virtual void VDeserializeBinary(BinaryReader& in) override;
 	virtual EventTypeId VGetEventType() const override;
 	virtual IEventDataPtr VCopy() const override;
 	virtual void VSerialize(std::ostream& out) const override;
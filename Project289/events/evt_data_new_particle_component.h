@@ -13,7 +13,7 @@ class EvtData_New_Particle_Component : public BaseEventData {
     Particle* m_pParticle;
 
 public:
-    static const EventTypeId sk_EventType = 0x4e170c71;
+    static constexpr EventTypeId sk_EventType = Fnv1a32("EvtData_New_Particle_Component");
     static const std::string sk_EventName;
 
     EvtData_New_Particle_Component();
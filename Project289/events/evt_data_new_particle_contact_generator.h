@@ -12,7 +12,7 @@ class EvtData_New_Particle_Contact_Generator : public BaseEventData {
     std::shared_ptr<ParticleContactGenerator> m_contact_generator;
 
 public:
-    static const EventTypeId sk_EventType = 0xd191e882;
+    static constexpr EventTypeId sk_EventType = Fnv1a32("EvtData_New_Particle_Contact_Generator");
     static const std::string sk_EventName;
 
     EvtData_New_Particle_Contact_Generator();
@@ -12,7 +12,7 @@ class EvtData_New_Particle_Force_Generator : public BaseEventData {
     std::shared_ptr<ParticleForceGenerator> m_force_generator;
 
 public:
-    static const EventTypeId sk_EventType = 0xd535f215;
+    static constexpr EventTypeId sk_EventType = Fnv1a32("EvtData_New_Particle_Force_Generator");
     static const std::string sk_EventName;
 
     EvtData_New_Particle_Force_Generator();
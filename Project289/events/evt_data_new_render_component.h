@@ -12,7 +12,7 @@ class EvtData_New_Render_Component : public BaseEventData {
     std::shared_ptr<SceneNode> m_pSceneNode;
 
 public:
-    static const EventTypeId sk_EventType = 0xaf4aff75;
+    static constexpr EventTypeId sk_EventType = Fnv1a32("EvtData_New_Render_Component");
     static const std::string sk_EventName;
 
     EvtData_New_Render_Component();
@@ -1,6 +1,6 @@
 #include "evt_data_request_destroy_actor.h"
 
-const std::string EvtData_Request_Destroy_Actor::sk_EventName = "EvtData_New_Actor";
+const std::string EvtData_Request_Destroy_Actor::sk_EventName = "EvtData_Request_Destroy_Actor";
 
 EvtData_Request_Destroy_Actor::EvtData_Request_Destroy_Actor() {
 	m_actorId = 0;
@@ -14,6 +14,14 @@ void EvtData_Request_Destroy_Actor::VDeserialize(std::istream& in) {
 	in >> m_actorId;
 }
 
+void EvtData_Request_Destroy_Actor::VSerializeBinary(BinaryWriter& out) const {
+	out.WriteVarint(m_actorId);
+}
+
+void EvtData_Request_Destroy_Actor::VDeserializeBinary(BinaryReader& in) {
+	m_actorId = static_cast<ActorId>(in.ReadVarint());
+}
+
 EventTypeId EvtData_Request_Destroy_Actor::VGetEventType() const {
 	return sk_EventType;
 }
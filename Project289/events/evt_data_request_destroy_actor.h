@@ -7,13 +7,16 @@ class EvtData_Request_Destroy_Actor : public BaseEventData {
 	ActorId m_actorId;
 
 public:
-	static const EventTypeId sk_EventType = 0xf5395770;
+	static constexpr EventTypeId sk_EventType = Fnv1a32("EvtData_Request_Destroy_Actor");
 	static const std::string sk_EventName;
+	static constexpr bool sk_Replayable = true;
 
 	EvtData_Request_Destroy_Actor();
 	explicit EvtData_Request_Destroy_Actor(ActorId actorId);
 
 	virtual void VDeserialize(std::istream& in) override;
+	virtual void VSerializeBinary(BinaryWriter& out) const override;
+	virtual void VDeserializeBinary(BinaryReader& in) override;
 	virtual EventTypeId VGetEventType() const override;
 	virtual IEventDataPtr VCopy() const override;
 	virtual void VSerialize(std::ostream& out) const override;
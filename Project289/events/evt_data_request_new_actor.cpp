@@ -1,7 +1,7 @@
 #include "evt_data_request_new_actor.h"
 #include "../tools/string_utility.h"
 
-const std::string EvtData_Request_New_Actor::sk_EventName = "EvtData_New_Actor";
+const std::string EvtData_Request_New_Actor::sk_EventName = "EvtData_Request_New_Actor";
 
 EvtData_Request_New_Actor::EvtData_Request_New_Actor() {
 	m_actorResource = "";
@@ -52,6 +52,26 @@ void EvtData_Request_New_Actor::VDeserialize(std::istream& in) {
 	in >> m_serverActorId;
 }
 
+void EvtData_Request_New_Actor::VSerializeBinary(BinaryWriter& out) const {
+	out.WriteString(m_actorResource);
+	out.WriteBool(m_hasInitialTransform);
+	if (m_hasInitialTransform) {
+		out.WriteFloat4x4(m_initialTransform);
+	}
+	out.WriteVarint(m_serverActorId);
+	out.WriteVarint(m_viewId);
+}
+
+void EvtData_Request_New_Actor::VDeserializeBinary(BinaryReader& in) {
+	m_actorResource = in.ReadString();
+	m_hasInitialTransform = in.ReadBool();
+	if (m_hasInitialTransform) {
+		m_initialTransform = in.ReadFloat4x4();
+	}
+	m_serverActorId = static_cast<ActorId>(in.ReadVarint());
+	m_viewId = static_cast<EngineViewId>(in.ReadVarint());
+}
+
 IEventDataPtr EvtData_Request_New_Actor::VCopy() const {
 	return IEventDataPtr(new EvtData_Request_New_Actor(m_actorResource, (m_hasInitialTransform) ? &m_initialTransform : NULL, m_serverActorId));
 }
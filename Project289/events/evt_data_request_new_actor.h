@@ -14,8 +14,9 @@ class EvtData_Request_New_Actor : public BaseEventData {
 	EngineViewId m_viewId;
 
 public:
-	static const EventTypeId sk_EventType = 0x40378c64;
+	static constexpr EventTypeId sk_EventType = Fnv1a32("EvtData_Request_New_Actor");
 	static const std::string sk_EventName;
+	static constexpr bool sk_Replayable = true;
 
 	EvtData_Request_New_Actor();
 	explicit EvtData_Request_New_Actor(const std::string& actorResource, const DirectX::XMFLOAT4X4* initialTransform = nullptr, const ActorId serverActorId = 0, const EngineViewId viewId = 0);
@@ -23,6 +24,8 @@ public:
 
 	virtual EventTypeId VGetEventType() const override;
 	virtual void VDeserialize(std::istream& in) override;
+	virtual void VSerializeBinary(BinaryWriter& out) const override;
+	virtual void VDeserializeBinary(BinaryReader& in) override;
 	virtual IEventDataPtr VCopy() const override;
 	virtual void VSerialize(std::ostream& out) const override;
 	virtual const std::string& GetName() const override;
@@ -7,8 +7,9 @@
 class EvtData_Request_Start_Game : public BaseEventData {
 
 public:
-	static const EventTypeId sk_EventType = 0x11f2b19d;
+	static constexpr EventTypeId sk_EventType = Fnv1a32("EvtData_Request_Start_Game");
 	static const std::string sk_EventName;
+	static constexpr bool sk_Replayable = true;
 
 	EvtData_Request_Start_Game();
 
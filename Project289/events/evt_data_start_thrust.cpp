@@ -24,6 +24,16 @@ void EvtData_StartThrust::VDeserialize(std::istream& in) {
     in >> m_acceleration;
 }
 
+void EvtData_StartThrust::VSerializeBinary(BinaryWriter& out) const {
+    out.WriteVarint(m_id);
+    out.WriteFloat(m_acceleration);
+}
+
+void EvtData_StartThrust::VDeserializeBinary(BinaryReader& in) {
+    m_id = static_cast<ActorId>(in.ReadVarint());
+    m_acceleration = in.ReadFloat();
+}
+
 const std::string& EvtData_StartThrust::GetName() const {
     return sk_EventName;
 }
@@ -9,8 +9,9 @@ class EvtData_StartThrust : public BaseEventData {
     float m_acceleration;
 
 public:
-    static const EventTypeId sk_EventType = 0x1d62d48c;
+    static constexpr EventTypeId sk_EventType = Fnv1a32("EvtData_StartThrust");
     static const std::string sk_EventName;
+    static constexpr bool sk_Replayable = true;
 
     EvtData_StartThrust();
     EvtData_StartThrust(ActorId id, float acceleration);
@@ -18,6 +19,8 @@ public:
     virtual EventTypeId VGetEventType() const override;
     virtual void VSerialize(std::ostream& out) const override;
     virtual void VDeserialize(std::istream& in) override;
+    virtual void VSerializeBinary(BinaryWriter& out) const override;
+    virtual void VDeserializeBinary(BinaryReader& in) override;
     virtual IEventDataPtr VCopy() const override;
     virtual const std::string& GetName() const override;
 
@@ -9,7 +9,7 @@ class EvtData_Update_Tick : public BaseEventData {
 	float m_TotalSeconds;
 
 public:
-	static const EventTypeId sk_EventType = 0xf0f5d183;
+	static constexpr EventTypeId sk_EventType = Fnv1a32("EvtData_Update_Tick");
 	static const std::string sk_EventName;
 
 	explicit EvtData_Update_Tick(float deltaSeconds, float totalSeconds);
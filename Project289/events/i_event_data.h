@@ -6,6 +6,8 @@
 #include "../tools/game_timer.h"
 
 class IEventData;
+class BinaryWriter;
+class BinaryReader;
 
 using EventTypeId = unsigned long;
 using IEventDataPtr = std::shared_ptr<IEventData>;
@@ -19,6 +21,8 @@ public:
 	virtual gameTimePoint GetTimeStamp() const = 0;
 	virtual void VSerialize(std::ostream& out) const = 0;
 	virtual void VDeserialize(std::istream& in) = 0;
+	virtual void VSerializeBinary(BinaryWriter& out) const = 0;
+	virtual void VDeserializeBinary(BinaryReader& in) = 0;
 	virtual IEventDataPtr VCopy(void) const = 0;
 	virtual const std::string& GetName() const = 0;
 };
\ No newline at end of file
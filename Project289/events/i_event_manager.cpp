@@ -1,16 +1,11 @@
 #include "i_event_manager.h"
 
 IEventManager* g_pEventMgr = nullptr;
-GenericObjectFactory<IEventData, EventTypeId> g_eventFactory;
 
 IEventManager* IEventManager::Get() {
 	return g_pEventMgr;
 }
 
-IEventDataPtr IEventManager::Create(EventTypeId eventType) {
-	return IEventDataPtr(CREATE_EVENT(eventType));
-}
-
 IEventManager::IEventManager(bool setAsGlobal) {
 	if (setAsGlobal) {
 		if (g_pEventMgr) {
@@ -1,13 +1,24 @@
 #pragma once
 
-#include "../tools/generic_object_factory.h"
 #include "i_event_data.h"
+#include "event_registry.h"
 
-extern GenericObjectFactory<IEventData, EventTypeId> g_eventFactory;
+#define CREATE_EVENT(eventType) CreateRegisteredEvent(eventType)
+#define GET_EVENT_NAME(eventType) GetRegisteredEventName(eventType)
 
-#define REGISTER_EVENT(eventClass) g_eventFactory.Register<eventClass>(eventClass::sk_EventType, eventClass::sk_EventName)
-#define CREATE_EVENT(eventType) g_eventFactory.Create(eventType)
-#define GET_EVENT_NAME(eventType) g_eventFactory.GetName(eventType)
+enum class EventPriority {
+	HIGH = 0,
+	NORMAL,
+	LOW
+};
+
+const unsigned int EVENT_PRIORITY_COUNT = 3;
+
+// Frames to wait before delivery, counted in VUpdate calls. 0 and 1 both mean the next VUpdate, the same as queueing
+// the event without a delay.
+struct EventFrameDelay {
+	unsigned int frames;
+};
 
 class IEventManager {
 public:
@@ -19,9 +30,13 @@ public:
 	virtual bool VRemoveListener(const EventListenerDelegate& eventDelegate, const EventTypeId& type) = 0;
 	virtual bool VTriggerEvent(const IEventDataPtr& pEvent) const = 0;
 	virtual bool VQueueEvent(const IEventDataPtr& pEvent) = 0;
+	virtual bool VQueueEvent(const IEventDataPtr& pEvent, EventPriority priority) = 0;
+	virtual bool VQueueEvent(const IEventDataPtr& pEvent, gameTimePoint deliverAt, EventPriority priority) = 0;
+	virtual bool VQueueEvent(const IEventDataPtr& pEvent, EventFrameDelay delay, EventPriority priority) = 0;
 	virtual bool VUpdate() = 0;
 	virtual bool VAbortEvent(const EventTypeId& type, bool allOfType = false) = 0;
 
 	static IEventManager* Get();
-	static IEventDataPtr Create(EventTypeId eventType);
+	// Inline so code that only needs Get() does not link the event registry and every event class with it.
+	static IEventDataPtr Create(EventTypeId eventType) { return IEventDataPtr(CREATE_EVENT(eventType)); }
 };
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+
+// On disk layout of a baked mesh (.bmesh). The file is an image that is used in place after mapping it: every section
+// starts at a 16 byte aligned offset from the start of the file, vertices are stored in the engine Vertex layout and
+// indices as 32 bit values relative to the first vertex of their part.
+constexpr uint32_t sk_BakedMeshMagic = 0x48534D42u; // "BMSH"
+constexpr uint32_t sk_BakedMeshVersion = 1u;
+constexpr uint32_t sk_BakedMeshAlignment = 16u;
+
+enum class BakedMaterialSource : uint32_t {
+	Color,
+	Disk,
+	Embedded,
+	Unhandled
+};
+
+// Children of a node are stored next to each other, node 0 is the root.
+struct BakedMeshNode {
+	float transform[16];
+	uint32_t meshBegin;
+	uint32_t meshCount;
+	uint32_t childBegin;
+	uint32_t childCount;
+};
+
+struct BakedMeshPart {
+	uint32_t vertexOffset;
+	uint32_t vertexCount;
+	uint32_t indexOffset;
+	uint32_t indexCount;
+	uint32_t materialIndex;
+	float boundsMin[3];
+	float boundsMax[3];
+};
+
+// Diffuse texture of a material: a flat color, a path to a texture on disk or a compressed embedded texture.
+// Paths and embedded textures live in the data section.
+struct BakedMeshMaterial {
+	BakedMaterialSource source;
+	float color[3];
+	uint64_t dataOffset;
+	uint64_t dataSize;
+};
+
+struct BakedMeshHeader {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t vertexStride;
+	uint32_t nodeCount;
+	uint32_t meshRefCount;
+	uint32_t partCount;
+	uint32_t materialCount;
+	uint32_t vertexCount;
+	uint32_t indexCount;
+	uint32_t reserved;
+	uint64_t nodesOffset;
+	uint64_t meshRefsOffset;
+	uint64_t partsOffset;
+	uint64_t materialsOffset;
+	uint64_t verticesOffset;
+	uint64_t indicesOffset;
+	uint64_t dataOffset;
+	uint64_t dataSize;
+	float boundsMin[3];
+	float boundsMax[3];
+};
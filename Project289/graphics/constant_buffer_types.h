@@ -14,6 +14,17 @@ struct CB_VS_VertexShader {
 	MaterialShader material;
 };
 
+// One element of the instance buffer read by the instanced vertex shader, transposed like CB_VS_VertexShader.
+// The view projection matrix is shared by the whole draw and lives in CB_VS_ViewProjection.
+struct InstanceData {
+	DirectX::XMFLOAT4X4 worldMatrix;
+	DirectX::XMFLOAT4X4 invWorldMatrix;
+};
+
+struct CB_VS_ViewProjection {
+	DirectX::XMFLOAT4X4 viewProjMatrix;
+};
+
 struct CB_PS_PixelShader_Light {
 	DirectionalLight gDirLights[3];
 	//PointLight gPointLights[3];
@@ -0,0 +1,207 @@
+#include "mesh_asset_cache.h"
+
+#include "mesh_baker.h"
+
+#include <filesystem>
+
+const std::string& MeshAsset::GetPath() const {
+	return m_path;
+}
+
+bool MeshAsset::IsMapped() const {
+	return m_mapping.IsOpen();
+}
+
+size_t MeshAsset::GetByteSize() const {
+	return m_imageSize;
+}
+
+const BakedMeshHeader& MeshAsset::GetHeader() const {
+	return *m_pHeader;
+}
+
+const BakedMeshNode& MeshAsset::GetNode(uint32_t index) const {
+	return GetSection<BakedMeshNode>(m_pHeader->nodesOffset)[index];
+}
+
+uint32_t MeshAsset::GetNodeMesh(const BakedMeshNode& node, uint32_t index) const {
+	return GetSection<uint32_t>(m_pHeader->meshRefsOffset)[node.meshBegin + index];
+}
+
+const BakedMeshPart& MeshAsset::GetPart(uint32_t index) const {
+	return GetSection<BakedMeshPart>(m_pHeader->partsOffset)[index];
+}
+
+const BakedMeshMaterial& MeshAsset::GetMaterial(uint32_t index) const {
+	return GetSection<BakedMeshMaterial>(m_pHeader->materialsOffset)[index];
+}
+
+const uint8_t* MeshAsset::GetMaterialData(const BakedMeshMaterial& material) const {
+	return m_pImage + m_pHeader->dataOffset + material.dataOffset;
+}
+
+const Vertex* MeshAsset::GetVertices(const BakedMeshPart& part) const {
+	return GetSection<Vertex>(m_pHeader->verticesOffset) + part.vertexOffset;
+}
+
+const DWORD* MeshAsset::GetIndices(const BakedMeshPart& part) const {
+	return GetSection<DWORD>(m_pHeader->indicesOffset) + part.indexOffset;
+}
+
+const MeshBvh& MeshAsset::GetBvh(const BakedMeshPart& part) const {
+	size_t partIndex = static_cast<size_t>(&part - GetSection<BakedMeshPart>(m_pHeader->partsOffset));
+	std::call_once(m_bvhBuilt[partIndex], [this, &part, partIndex]() {
+		m_bvhs[partIndex] = std::make_unique<MeshBvh>(GetVertices(part), GetIndices(part), part.indexCount);
+	});
+	return *m_bvhs[partIndex];
+}
+
+bool MeshAsset::Load(const std::string& path) {
+	m_path = path;
+
+	// A baked file is preferred while it is at least as new as its source
+	std::string bakedPath = IsBakedMeshPath(path) ? path : GetBakedMeshPath(path);
+	std::error_code ec;
+	bool bakedIsCurrent = std::filesystem::exists(bakedPath, ec);
+	if (bakedIsCurrent && bakedPath != path && std::filesystem::exists(path, ec)) {
+		bakedIsCurrent = std::filesystem::last_write_time(bakedPath, ec) >= std::filesystem::last_write_time(path, ec) && !ec;
+	}
+	if (bakedIsCurrent && m_mapping.Open(bakedPath)) {
+		if (SetImage(m_mapping.GetData(), m_mapping.GetSize())) {
+			return true;
+		}
+		m_mapping.Close();
+	}
+
+	if (IsBakedMeshPath(path) || !BakeMesh(path, m_ownedImage)) {
+		return false;
+	}
+	return SetImage(m_ownedImage.data(), m_ownedImage.size());
+}
+
+bool MeshAsset::SetImage(const uint8_t* pImage, size_t size) {
+	// Only the structure is checked, the streams themselves are used as they are
+	if (size < sizeof(BakedMeshHeader)) { return false; }
+	const BakedMeshHeader* pHeader = reinterpret_cast<const BakedMeshHeader*>(pImage);
+	if (pHeader->magic != sk_BakedMeshMagic || pHeader->version != sk_BakedMeshVersion || pHeader->vertexStride != sizeof(Vertex)) { return false; }
+	if (pHeader->nodeCount == 0u) { return false; }
+
+	auto sectionFits = [size](uint64_t offset, uint64_t count, uint64_t stride) {
+		return offset % sk_BakedMeshAlignment == 0u && offset <= size && count <= (size - offset) / stride;
+	};
+	if (!sectionFits(pHeader->nodesOffset, pHeader->nodeCount, sizeof(BakedMeshNode)) ||
+		!sectionFits(pHeader->meshRefsOffset, pHeader->meshRefCount, sizeof(uint32_t)) ||
+		!sectionFits(pHeader->partsOffset, pHeader->partCount, sizeof(BakedMeshPart)) ||
+		!sectionFits(pHeader->materialsOffset, pHeader->materialCount, sizeof(BakedMeshMaterial)) ||
+		!sectionFits(pHeader->verticesOffset, pHeader->vertexCount, sizeof(Vertex)) ||
+		!sectionFits(pHeader->indicesOffset, pHeader->indexCount, sizeof(DWORD)) ||
+		!sectionFits(pHeader->dataOffset, pHeader->dataSize, 1u)) {
+		return false;
+	}
+
+	m_pImage = pImage;
+	m_imageSize = size;
+	m_pHeader = pHeader;
+
+	for (uint32_t i = 0u; i < pHeader->nodeCount; ++i) {
+		const BakedMeshNode& node = GetNode(i);
+		if (uint64_t(node.meshBegin) + node.meshCount > pHeader->meshRefCount || uint64_t(node.childBegin) + node.childCount > pHeader->nodeCount) { return false; }
+		for (uint32_t m = 0u; m < node.meshCount; ++m) {
+			if (GetNodeMesh(node, m) >= pHeader->partCount) { return false; }
+		}
+	}
+	for (uint32_t i = 0u; i < pHeader->partCount; ++i) {
+		const BakedMeshPart& part = GetPart(i);
+		if (uint64_t(part.vertexOffset) + part.vertexCount > pHeader->vertexCount || uint64_t(part.indexOffset) + part.indexCount > pHeader->indexCount || part.materialIndex >= pHeader->materialCount) { return false; }
+		// Indices are relative to the part, one past its vertices would read the next part or past the image in a pick
+		const DWORD* pIndices = GetIndices(part);
+		for (uint32_t j = 0u; j < part.indexCount; ++j) {
+			if (pIndices[j] >= part.vertexCount) { return false; }
+		}
+	}
+	for (uint32_t i = 0u; i < pHeader->materialCount; ++i) {
+		const BakedMeshMaterial& material = GetMaterial(i);
+		if (material.dataOffset > pHeader->dataSize || material.dataSize > pHeader->dataSize - material.dataOffset) { return false; }
+	}
+
+	m_bvhBuilt = std::make_unique<std::once_flag[]>(pHeader->partCount);
+	m_bvhs.clear();
+	m_bvhs.resize(pHeader->partCount);
+	return true;
+}
+
+float MeshAssetCacheStats::GetHitRate() const {
+	return requests ? static_cast<float>(hits) / static_cast<float>(requests) : 0.0f;
+}
+
+MeshAssetCache& MeshAssetCache::Get() {
+	static MeshAssetCache cache;
+	return cache;
+}
+
+std::shared_ptr<const MeshAsset> MeshAssetCache::Load(const std::string& fileName) {
+	m_requests.fetch_add(1u, std::memory_order_relaxed);
+	std::string path = GetCanonicalPath(fileName);
+
+	Entry* pEntry = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		std::unique_ptr<Entry>& pSlot = m_entries[path];
+		if (!pSlot) {
+			pSlot = std::make_unique<Entry>();
+		}
+		pEntry = pSlot.get();
+	}
+
+	// Entries are never erased, so the pointer stays valid; the import itself runs under the entry lock only
+	std::lock_guard<std::mutex> loadLock(pEntry->loadMutex);
+	std::shared_ptr<const MeshAsset> pAsset = pEntry->pAsset.lock();
+	if (pAsset) {
+		m_hits.fetch_add(1u, std::memory_order_relaxed);
+		return pAsset;
+	}
+
+	std::shared_ptr<MeshAsset> pNewAsset(new MeshAsset());
+	if (!pNewAsset->Load(path)) {
+		return nullptr;
+	}
+	{
+		// Written under both locks so GetStats can read the entries while holding only the cache lock
+		std::lock_guard<std::mutex> lock(m_mutex);
+		pEntry->pAsset = pNewAsset;
+	}
+	return pNewAsset;
+}
+
+MeshAssetCacheStats MeshAssetCache::GetStats() {
+	MeshAssetCacheStats stats;
+	stats.requests = m_requests.load(std::memory_order_relaxed);
+	stats.hits = m_hits.load(std::memory_order_relaxed);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (auto& [path, pEntry] : m_entries) {
+		std::shared_ptr<const MeshAsset> pAsset = pEntry->pAsset.lock();
+		if (pAsset) {
+			++stats.residentAssets;
+			stats.residentBytes += pAsset->GetByteSize();
+			if (pAsset->IsMapped()) {
+				++stats.mappedAssets;
+			}
+		}
+	}
+	return stats;
+}
+
+std::string MeshAssetCache::GetCanonicalPath(const std::string& fileName) {
+	std::error_code ec;
+	std::filesystem::path path = std::filesystem::weakly_canonical(std::filesystem::path(fileName), ec);
+	if (ec) {
+		return std::filesystem::path(fileName).lexically_normal().generic_string();
+	}
+	return path.generic_string();
+}
+
+std::ostream& operator<<(std::ostream& os, const MeshAssetCacheStats& stats) {
+	os << "Mesh assets: " << stats.residentAssets << " resident (" << stats.mappedAssets << " mapped), " << stats.residentBytes << " bytes, " << stats.hits << "/" << stats.requests << " hits (" << stats.GetHitRate() * 100.0f << "%)\n";
+	return os;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <Windows.h>
+
+#include "baked_mesh_format.h"
+#include "mesh_bvh.h"
+#include "vertex.h"
+#include "../tools/mapped_file.h"
+
+// One model in the baked mesh layout. A baked .bmesh file is mapped and used in place, anything else is imported
+// through Assimp and baked into memory on load. Immutable after loading, shared between components.
+class MeshAsset {
+public:
+	MeshAsset(const MeshAsset&) = delete;
+	MeshAsset& operator=(const MeshAsset&) = delete;
+
+	const std::string& GetPath() const;
+	bool IsMapped() const;
+	size_t GetByteSize() const;
+
+	const BakedMeshHeader& GetHeader() const;
+	const BakedMeshNode& GetNode(uint32_t index) const;
+	uint32_t GetNodeMesh(const BakedMeshNode& node, uint32_t index) const;
+	const BakedMeshPart& GetPart(uint32_t index) const;
+	const BakedMeshMaterial& GetMaterial(uint32_t index) const;
+	const uint8_t* GetMaterialData(const BakedMeshMaterial& material) const;
+	const Vertex* GetVertices(const BakedMeshPart& part) const;
+	const DWORD* GetIndices(const BakedMeshPart& part) const;
+	// Ray casting hierarchy of a part, built on the first query of that part; safe to call from several threads.
+	const MeshBvh& GetBvh(const BakedMeshPart& part) const;
+
+private:
+	friend class MeshAssetCache;
+
+	MeshAsset() = default;
+	bool Load(const std::string& path);
+	bool SetImage(const uint8_t* pImage, size_t size);
+
+	template <class T>
+	const T* GetSection(uint64_t offset) const {
+		return reinterpret_cast<const T*>(m_pImage + offset);
+	}
+
+	std::string m_path;
+	MappedFile m_mapping;
+	std::vector<uint8_t> m_ownedImage;
+	const uint8_t* m_pImage = nullptr;
+	size_t m_imageSize = 0u;
+	const BakedMeshHeader* m_pHeader = nullptr;
+	// Most parts are never picked, so their hierarchies are only built when first asked for
+	mutable std::unique_ptr<std::once_flag[]> m_bvhBuilt;
+	mutable std::vector<std::unique_ptr<MeshBvh>> m_bvhs;
+};
+
+struct MeshAssetCacheStats {
+	size_t requests = 0u;
+	size_t hits = 0u;
+	size_t residentAssets = 0u;
+	size_t residentBytes = 0u;
+	size_t mappedAssets = 0u;
+
+	float GetHitRate() const;
+};
+
+// Reference counted cache of MeshAsset keyed by canonical path. The cache only holds weak references, an asset is
+// released when the last component using it goes away. Safe to call from loader threads, a file is imported once
+// even when several threads ask for it at the same time.
+class MeshAssetCache {
+public:
+	static MeshAssetCache& Get();
+
+	std::shared_ptr<const MeshAsset> Load(const std::string& fileName);
+	MeshAssetCacheStats GetStats();
+
+private:
+	struct Entry {
+		std::mutex loadMutex;
+		std::weak_ptr<const MeshAsset> pAsset;
+	};
+
+	MeshAssetCache() = default;
+
+	static std::string GetCanonicalPath(const std::string& fileName);
+
+	std::mutex m_mutex;
+	std::unordered_map<std::string, std::unique_ptr<Entry>> m_entries;
+	std::atomic<size_t> m_requests{ 0u };
+	std::atomic<size_t> m_hits{ 0u };
+};
+
+std::ostream& operator<<(std::ostream& os, const MeshAssetCacheStats& stats);
@@ -0,0 +1,258 @@
+#include "mesh_baker.h"
+#include "baked_mesh_format.h"
+#include "vertex.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include <Windows.h>
+
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+static_assert(sizeof(DWORD) == sizeof(uint32_t), "Baked indices are read in place as DWORD");
+
+namespace {
+	struct MeshImage {
+		std::vector<BakedMeshNode> nodes;
+		std::vector<uint32_t> meshRefs;
+		std::vector<BakedMeshPart> parts;
+		std::vector<BakedMeshMaterial> materials;
+		std::vector<Vertex> vertices;
+		std::vector<uint32_t> indices;
+		std::vector<uint8_t> data;
+	};
+
+	uint64_t AppendData(MeshImage& image, const void* pData, size_t size) {
+		uint64_t offset = image.data.size();
+		image.data.insert(image.data.end(), static_cast<const uint8_t*>(pData), static_cast<const uint8_t*>(pData) + size);
+		return offset;
+	}
+
+	void BakeNodes(MeshImage& image, const aiNode* pRoot) {
+		// Breadth first, so the children of every node end up next to each other
+		std::vector<const aiNode*> order{ pRoot };
+		for (size_t i = 0u; i < order.size(); ++i) {
+			const aiNode* pNode = order[i];
+			BakedMeshNode node;
+			// Stored transposed, the way DirectXMath expects the matrix
+			const aiMatrix4x4& m = pNode->mTransformation;
+			const float* src = &m.a1;
+			for (int r = 0; r < 4; ++r) {
+				for (int c = 0; c < 4; ++c) {
+					node.transform[r * 4 + c] = src[c * 4 + r];
+				}
+			}
+			node.meshBegin = static_cast<uint32_t>(image.meshRefs.size());
+			node.meshCount = pNode->mNumMeshes;
+			node.childBegin = static_cast<uint32_t>(order.size());
+			node.childCount = pNode->mNumChildren;
+			image.meshRefs.insert(image.meshRefs.end(), pNode->mMeshes, pNode->mMeshes + pNode->mNumMeshes);
+			order.insert(order.end(), pNode->mChildren, pNode->mChildren + pNode->mNumChildren);
+			image.nodes.push_back(node);
+		}
+	}
+
+	void BakePart(MeshImage& image, const aiMesh* mesh) {
+		BakedMeshPart part;
+		part.vertexOffset = static_cast<uint32_t>(image.vertices.size());
+		part.vertexCount = mesh->mNumVertices;
+		part.indexOffset = static_cast<uint32_t>(image.indices.size());
+		part.materialIndex = mesh->mMaterialIndex;
+		std::fill(std::begin(part.boundsMin), std::end(part.boundsMin), FLT_MAX);
+		std::fill(std::begin(part.boundsMax), std::end(part.boundsMax), -FLT_MAX);
+
+		for (unsigned int i = 0u; i < mesh->mNumVertices; ++i) {
+			Vertex vertex;
+			vertex.color = { 0.7f, 0.1f, 0.6f, 1.0f };
+			vertex.pos = { mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z };
+			// Point and line meshes get no normals, and no tangents come without UVs; Vertex leaves those zeroed
+			if (mesh->HasNormals()) {
+				vertex.normal = { mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z };
+			}
+			if (mesh->HasTangentsAndBitangents()) {
+				vertex.tg = { mesh->mTangents[i].x, mesh->mTangents[i].y, mesh->mTangents[i].z };
+			}
+			if (mesh->mTextureCoords[0]) {
+				vertex.uv = { (float)mesh->mTextureCoords[0][i].x, (float)mesh->mTextureCoords[0][i].y };
+			}
+			image.vertices.push_back(vertex);
+
+			const float p[3] = { vertex.pos.x, vertex.pos.y, vertex.pos.z };
+			for (int a = 0; a < 3; ++a) {
+				part.boundsMin[a] = std::min(part.boundsMin[a], p[a]);
+				part.boundsMax[a] = std::max(part.boundsMax[a], p[a]);
+			}
+		}
+
+		for (unsigned int i = 0u; i < mesh->mNumFaces; ++i) {
+			const aiFace& face = mesh->mFaces[i];
+			image.indices.insert(image.indices.end(), face.mIndices, face.mIndices + face.mNumIndices);
+		}
+		part.indexCount = static_cast<uint32_t>(image.indices.size()) - part.indexOffset;
+
+		if (part.vertexCount == 0u) {
+			std::fill(std::begin(part.boundsMin), std::end(part.boundsMin), 0.0f);
+			std::fill(std::begin(part.boundsMax), std::end(part.boundsMax), 0.0f);
+		}
+		image.parts.push_back(part);
+	}
+
+	const aiTexture* FindEmbeddedTexture(const aiScene* pScene, const aiString& path) {
+		if (path.length > 0u && path.data[0] == '*') {
+			unsigned int index = static_cast<unsigned int>(atoi(&path.data[1]));
+			return index < pScene->mNumTextures ? pScene->mTextures[index] : nullptr;
+		}
+		return pScene->GetEmbeddedTexture(path.C_Str());
+	}
+
+	void BakeMaterial(MeshImage& image, const aiScene* pScene, const aiMaterial* pMaterial) {
+		BakedMeshMaterial material = {};
+		material.source = BakedMaterialSource::Unhandled;
+
+		unsigned int textureCount = pMaterial->GetTextureCount(aiTextureType_DIFFUSE);
+		if (textureCount == 0u) {
+			aiColor3D aiColor(0.0f, 0.0f, 0.0f);
+			pMaterial->Get(AI_MATKEY_COLOR_DIFFUSE, aiColor);
+			material.source = BakedMaterialSource::Color;
+			material.color[0] = aiColor.r;
+			material.color[1] = aiColor.g;
+			material.color[2] = aiColor.b;
+		}
+
+		// Only the first usable diffuse texture is ever bound, so that is the one that is kept
+		for (unsigned int i = 0u; i < textureCount && material.source == BakedMaterialSource::Unhandled; ++i) {
+			aiString path;
+			pMaterial->GetTexture(aiTextureType_DIFFUSE, i, &path);
+			const aiTexture* pTexture = FindEmbeddedTexture(pScene, path);
+			if (pTexture) {
+				// Raw embedded pixels were never supported by MaterialTexture, only compressed images
+				if (pTexture->mHeight == 0u) {
+					material.source = BakedMaterialSource::Embedded;
+					material.dataSize = pTexture->mWidth;
+					material.dataOffset = AppendData(image, pTexture->pcData, pTexture->mWidth);
+				}
+			}
+			else if (path.length > 0u && path.data[0] != '*') {
+				material.source = BakedMaterialSource::Disk;
+				material.dataSize = path.length;
+				material.dataOffset = AppendData(image, path.data, path.length);
+			}
+		}
+
+		image.materials.push_back(material);
+	}
+
+	uint64_t AlignOffset(uint64_t offset) {
+		return (offset + sk_BakedMeshAlignment - 1u) & ~uint64_t(sk_BakedMeshAlignment - 1u);
+	}
+
+	template <class T>
+	uint64_t WriteSection(std::vector<uint8_t>& out, const std::vector<T>& section) {
+		uint64_t offset = AlignOffset(out.size());
+		out.resize(offset + section.size() * sizeof(T));
+		if (!section.empty()) {
+			std::memcpy(out.data() + offset, section.data(), section.size() * sizeof(T));
+		}
+		return offset;
+	}
+}
+
+bool BakeMesh(const std::string& sourcePath, std::vector<uint8_t>& out) {
+	Assimp::Importer importer;
+	const aiScene* pScene = importer.ReadFile(sourcePath, aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_CalcTangentSpace | aiProcess_ConvertToLeftHanded);
+	if (!pScene || !pScene->mRootNode) {
+		return false;
+	}
+
+	MeshImage image;
+	BakeNodes(image, pScene->mRootNode);
+	for (unsigned int i = 0u; i < pScene->mNumMeshes; ++i) {
+		BakePart(image, pScene->mMeshes[i]);
+	}
+	for (unsigned int i = 0u; i < pScene->mNumMaterials; ++i) {
+		BakeMaterial(image, pScene, pScene->mMaterials[i]);
+	}
+
+	BakedMeshHeader header = {};
+	header.magic = sk_BakedMeshMagic;
+	header.version = sk_BakedMeshVersion;
+	header.vertexStride = sizeof(Vertex);
+	header.nodeCount = static_cast<uint32_t>(image.nodes.size());
+	header.meshRefCount = static_cast<uint32_t>(image.meshRefs.size());
+	header.partCount = static_cast<uint32_t>(image.parts.size());
+	header.materialCount = static_cast<uint32_t>(image.materials.size());
+	header.vertexCount = static_cast<uint32_t>(image.vertices.size());
+	header.indexCount = static_cast<uint32_t>(image.indices.size());
+	std::fill(std::begin(header.boundsMin), std::end(header.boundsMin), image.parts.empty() ? 0.0f : FLT_MAX);
+	std::fill(std::begin(header.boundsMax), std::end(header.boundsMax), image.parts.empty() ? 0.0f : -FLT_MAX);
+	for (const BakedMeshPart& part : image.parts) {
+		for (int a = 0; a < 3; ++a) {
+			header.boundsMin[a] = std::min(header.boundsMin[a], part.boundsMin[a]);
+			header.boundsMax[a] = std::max(header.boundsMax[a], part.boundsMax[a]);
+		}
+	}
+
+	out.assign(sizeof(BakedMeshHeader), 0u);
+	header.nodesOffset = WriteSection(out, image.nodes);
+	header.meshRefsOffset = WriteSection(out, image.meshRefs);
+	header.partsOffset = WriteSection(out, image.parts);
+	header.materialsOffset = WriteSection(out, image.materials);
+	header.verticesOffset = WriteSection(out, image.vertices);
+	header.indicesOffset = WriteSection(out, image.indices);
+	header.dataOffset = WriteSection(out, image.data);
+	header.dataSize = image.data.size();
+	std::memcpy(out.data(), &header, sizeof(header));
+
+	return true;
+}
+
+bool BakeMeshFile(const std::string& sourcePath, const std::string& bakedPath) {
+	std::vector<uint8_t> image;
+	if (!BakeMesh(sourcePath, image)) {
+		return false;
+	}
+
+	// Written next to the target and renamed, so a running game never maps a half written file
+	std::string tempPath = bakedPath + ".tmp";
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		if (!file) {
+			return false;
+		}
+		file.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+		if (!file) {
+			return false;
+		}
+	}
+
+	std::error_code ec;
+	std::filesystem::rename(tempPath, bakedPath, ec);
+	if (!ec) {
+		return true;
+	}
+
+	// Windows will not replace a file while a running game has it mapped, but it can rename it: the old image is
+	// moved aside and stays mapped for the assets using it, and the leftover goes with the next bake
+	std::string oldPath = bakedPath + ".old";
+	std::filesystem::remove(oldPath, ec);
+	std::filesystem::rename(bakedPath, oldPath, ec);
+	if (ec) {
+		std::filesystem::remove(tempPath, ec);
+		return false;
+	}
+	std::filesystem::rename(tempPath, bakedPath, ec);
+	return !ec;
+}
+
+std::string GetBakedMeshPath(const std::string& sourcePath) {
+	return std::filesystem::path(sourcePath).replace_extension(".bmesh").string();
+}
+
+bool IsBakedMeshPath(const std::string& path) {
+	return std::filesystem::path(path).extension() == ".bmesh";
+}
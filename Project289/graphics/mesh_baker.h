@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Imports a model through Assimp with the engine post processing and flattens it into a baked mesh image
+// (see baked_mesh_format.h). The same image is written to disk by the offline bake and built in memory when
+// an asset has not been baked.
+bool BakeMesh(const std::string& sourcePath, std::vector<uint8_t>& image);
+bool BakeMeshFile(const std::string& sourcePath, const std::string& bakedPath);
+
+// models/feisar.obj -> models/feisar.bmesh
+std::string GetBakedMeshPath(const std::string& sourcePath);
+bool IsBakedMeshPath(const std::string& path);
@@ -0,0 +1,427 @@
+#include "mesh_bvh.h"
+#include "../tools/job_system.h"
+
+#include <algorithm>
+#include <cfloat>
+
+#include <xmmintrin.h>
+
+namespace {
+	constexpr int sk_BinCount = 12;
+	// Past this depth splits fall back to the median, which bounds the traversal stack
+	constexpr int sk_MaxSahDepth = 40;
+	constexpr int sk_StackSize = 256;
+
+	struct Box {
+		DirectX::XMFLOAT3 m_Min = { FLT_MAX, FLT_MAX, FLT_MAX };
+		DirectX::XMFLOAT3 m_Max = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+		void Grow(const DirectX::XMFLOAT3& p) {
+			m_Min = { std::min(m_Min.x, p.x), std::min(m_Min.y, p.y), std::min(m_Min.z, p.z) };
+			m_Max = { std::max(m_Max.x, p.x), std::max(m_Max.y, p.y), std::max(m_Max.z, p.z) };
+		}
+
+		void Grow(const Box& b) {
+			Grow(b.m_Min);
+			Grow(b.m_Max);
+		}
+
+		float Area() const {
+			if (m_Min.x > m_Max.x) { return 0.0f; }
+			float dx = m_Max.x - m_Min.x;
+			float dy = m_Max.y - m_Min.y;
+			float dz = m_Max.z - m_Min.z;
+			return dx * dy + dy * dz + dz * dx;
+		}
+	};
+
+	float Axis(const DirectX::XMFLOAT3& p, int axis) {
+		return axis == 0 ? p.x : (axis == 1 ? p.y : p.z);
+	}
+
+	struct BuildNode {
+		Box m_Box;
+		uint32_t m_Left;
+		uint32_t m_Right;
+		// Range of m_Order for leaves, m_Count is 0 for inner nodes
+		uint32_t m_First;
+		uint32_t m_Count;
+	};
+
+	class BinaryBuilder {
+	public:
+		BinaryBuilder(const Vertex* pVertices, const DWORD* pIndices, size_t triangleCount) {
+			m_Boxes.resize(triangleCount);
+			m_Centroids.resize(triangleCount);
+			m_Order.resize(triangleCount);
+			for (size_t i = 0u; i < triangleCount; ++i) {
+				Box& box = m_Boxes[i];
+				for (size_t corner = 0u; corner < 3u; ++corner) {
+					box.Grow(pVertices[pIndices[i * 3u + corner]].pos);
+				}
+				m_Centroids[i] = { (box.m_Min.x + box.m_Max.x) * 0.5f, (box.m_Min.y + box.m_Max.y) * 0.5f, (box.m_Min.z + box.m_Max.z) * 0.5f };
+				m_Order[i] = static_cast<uint32_t>(i);
+			}
+			m_Nodes.reserve(triangleCount * 2u / MeshBvh::sk_LeafSize + 1u);
+			Build(0u, static_cast<uint32_t>(triangleCount), 0);
+		}
+
+		std::vector<BuildNode> m_Nodes;
+		std::vector<uint32_t> m_Order;
+
+	private:
+		uint32_t Build(uint32_t first, uint32_t count, int depth) {
+			uint32_t nodeIndex = static_cast<uint32_t>(m_Nodes.size());
+			m_Nodes.emplace_back();
+			Box box;
+			Box centroidBox;
+			for (uint32_t i = first; i < first + count; ++i) {
+				box.Grow(m_Boxes[m_Order[i]]);
+				centroidBox.Grow(m_Centroids[m_Order[i]]);
+			}
+			m_Nodes[nodeIndex].m_Box = box;
+
+			if (count <= MeshBvh::sk_LeafSize) {
+				m_Nodes[nodeIndex].m_First = first;
+				m_Nodes[nodeIndex].m_Count = count;
+				return nodeIndex;
+			}
+
+			uint32_t middle = depth < sk_MaxSahDepth ? SplitSah(first, count, centroidBox) : first;
+			if (middle == first || middle == first + count) {
+				middle = SplitMedian(first, count, centroidBox);
+			}
+
+			uint32_t left = Build(first, middle - first, depth + 1);
+			uint32_t right = Build(middle, first + count - middle, depth + 1);
+			BuildNode& node = m_Nodes[nodeIndex];
+			node.m_Left = left;
+			node.m_Right = right;
+			node.m_Count = 0u;
+			return nodeIndex;
+		}
+
+		int LargestAxis(const Box& box) const {
+			float dx = box.m_Max.x - box.m_Min.x;
+			float dy = box.m_Max.y - box.m_Min.y;
+			float dz = box.m_Max.z - box.m_Min.z;
+			return dx >= dy && dx >= dz ? 0 : (dy >= dz ? 1 : 2);
+		}
+
+		// Returns the start of the right half, or first when no plane beats a leaf
+		uint32_t SplitSah(uint32_t first, uint32_t count, const Box& centroidBox) {
+			int axis = LargestAxis(centroidBox);
+			float lo = Axis(centroidBox.m_Min, axis);
+			float extent = Axis(centroidBox.m_Max, axis) - lo;
+			if (extent <= 0.0f) {
+				return first;
+			}
+
+			Box bins[sk_BinCount];
+			uint32_t binCounts[sk_BinCount] = {};
+			float scale = sk_BinCount / extent;
+			for (uint32_t i = first; i < first + count; ++i) {
+				int bin = std::min(sk_BinCount - 1, static_cast<int>((Axis(m_Centroids[m_Order[i]], axis) - lo) * scale));
+				bins[bin].Grow(m_Boxes[m_Order[i]]);
+				++binCounts[bin];
+			}
+
+			// Sweep from the right for the right hand areas, then from the left for the costs
+			float rightArea[sk_BinCount];
+			uint32_t rightCount[sk_BinCount];
+			Box accumulated;
+			uint32_t accumulatedCount = 0u;
+			for (int i = sk_BinCount - 1; i > 0; --i) {
+				accumulated.Grow(bins[i]);
+				accumulatedCount += binCounts[i];
+				rightArea[i] = accumulated.Area();
+				rightCount[i] = accumulatedCount;
+			}
+
+			float bestCost = FLT_MAX;
+			int bestPlane = -1;
+			accumulated = Box();
+			accumulatedCount = 0u;
+			for (int i = 1; i < sk_BinCount; ++i) {
+				accumulated.Grow(bins[i - 1]);
+				accumulatedCount += binCounts[i - 1];
+				float cost = accumulated.Area() * accumulatedCount + rightArea[i] * rightCount[i];
+				if (accumulatedCount > 0u && rightCount[i] > 0u && cost < bestCost) {
+					bestCost = cost;
+					bestPlane = i;
+				}
+			}
+			if (bestPlane < 0) {
+				return first;
+			}
+
+			uint32_t* pBegin = m_Order.data() + first;
+			uint32_t* pMiddle = std::partition(pBegin, pBegin + count, [&](uint32_t triangle) {
+				return static_cast<int>((Axis(m_Centroids[triangle], axis) - lo) * scale) < bestPlane;
+			});
+			return first + static_cast<uint32_t>(pMiddle - pBegin);
+		}
+
+		uint32_t SplitMedian(uint32_t first, uint32_t count, const Box& centroidBox) {
+			int axis = LargestAxis(centroidBox);
+			uint32_t* pBegin = m_Order.data() + first;
+			std::nth_element(pBegin, pBegin + count / 2u, pBegin + count, [&](uint32_t a, uint32_t b) {
+				return Axis(m_Centroids[a], axis) < Axis(m_Centroids[b], axis);
+			});
+			return first + count / 2u;
+		}
+
+		std::vector<Box> m_Boxes;
+		std::vector<DirectX::XMFLOAT3> m_Centroids;
+	};
+}
+
+MeshBvh::MeshBvh(const Vertex* pVertices, const DWORD* pIndices, size_t indexCount) {
+	m_TriangleCount = indexCount / 3u;
+	if (m_TriangleCount == 0u) {
+		return;
+	}
+
+	BinaryBuilder builder(pVertices, pIndices, m_TriangleCount);
+	const std::vector<BuildNode>& binary = builder.m_Nodes;
+
+	// Collapse: each wide node takes the binary node's children and keeps opening the largest inner one until it
+	// has four. Nodes are filled in after their children are created, so the pending list holds binary indices
+	struct Pending {
+		uint32_t m_Binary;
+		uint32_t m_Wide;
+	};
+	std::vector<Pending> pending;
+	m_Nodes.emplace_back();
+	pending.push_back({ 0u, 0u });
+	while (!pending.empty()) {
+		Pending item = pending.back();
+		pending.pop_back();
+
+		uint32_t children[4];
+		uint32_t childCount = 0u;
+		if (binary[item.m_Binary].m_Count > 0u) {
+			children[childCount++] = item.m_Binary;
+		}
+		else {
+			children[childCount++] = binary[item.m_Binary].m_Left;
+			children[childCount++] = binary[item.m_Binary].m_Right;
+		}
+		while (childCount < 4u) {
+			int open = -1;
+			float openArea = -1.0f;
+			for (uint32_t i = 0u; i < childCount; ++i) {
+				const BuildNode& child = binary[children[i]];
+				if (child.m_Count == 0u && child.m_Box.Area() > openArea) {
+					openArea = child.m_Box.Area();
+					open = static_cast<int>(i);
+				}
+			}
+			if (open < 0) {
+				break;
+			}
+			const BuildNode& opened = binary[children[open]];
+			children[open] = opened.m_Left;
+			children[childCount++] = opened.m_Right;
+		}
+
+		WideNode node = {};
+		node.m_Count = childCount;
+		for (uint32_t i = 0u; i < childCount; ++i) {
+			const BuildNode& child = binary[children[i]];
+			node.m_MinX[i] = child.m_Box.m_Min.x;
+			node.m_MinY[i] = child.m_Box.m_Min.y;
+			node.m_MinZ[i] = child.m_Box.m_Min.z;
+			node.m_MaxX[i] = child.m_Box.m_Max.x;
+			node.m_MaxY[i] = child.m_Box.m_Max.y;
+			node.m_MaxZ[i] = child.m_Box.m_Max.z;
+
+			if (child.m_Count > 0u) {
+				TrianglePacket packet = {};
+				for (uint32_t lane = 0u; lane < child.m_Count; ++lane) {
+					uint32_t triangle = builder.m_Order[child.m_First + lane];
+					const DirectX::XMFLOAT3& v0 = pVertices[pIndices[triangle * 3u + 0u]].pos;
+					const DirectX::XMFLOAT3& v1 = pVertices[pIndices[triangle * 3u + 1u]].pos;
+					const DirectX::XMFLOAT3& v2 = pVertices[pIndices[triangle * 3u + 2u]].pos;
+					packet.m_V0X[lane] = v0.x;
+					packet.m_V0Y[lane] = v0.y;
+					packet.m_V0Z[lane] = v0.z;
+					packet.m_E1X[lane] = v1.x - v0.x;
+					packet.m_E1Y[lane] = v1.y - v0.y;
+					packet.m_E1Z[lane] = v1.z - v0.z;
+					packet.m_E2X[lane] = v2.x - v0.x;
+					packet.m_E2Y[lane] = v2.y - v0.y;
+					packet.m_E2Z[lane] = v2.z - v0.z;
+					packet.m_Triangle[lane] = triangle;
+				}
+				for (uint32_t lane = child.m_Count; lane < 4u; ++lane) {
+					packet.m_Triangle[lane] = sk_NoHit;
+				}
+				node.m_Children[i] = ~static_cast<int32_t>(m_Packets.size());
+				m_Packets.push_back(packet);
+			}
+			else {
+				node.m_Children[i] = static_cast<int32_t>(m_Nodes.size());
+				m_Nodes.emplace_back();
+				pending.push_back({ children[i], static_cast<uint32_t>(node.m_Children[i]) });
+			}
+		}
+		m_Nodes[item.m_Wide] = node;
+	}
+}
+
+template <class OnHit>
+void MeshBvh::Traverse(const BvhRay& ray, OnHit&& onHit) const {
+	if (m_Nodes.empty()) {
+		return;
+	}
+
+	float tMax = ray.maxDistance;
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 originX = _mm_set1_ps(ray.origin.x);
+	const __m128 originY = _mm_set1_ps(ray.origin.y);
+	const __m128 originZ = _mm_set1_ps(ray.origin.z);
+	const __m128 dirX = _mm_set1_ps(ray.direction.x);
+	const __m128 dirY = _mm_set1_ps(ray.direction.y);
+	const __m128 dirZ = _mm_set1_ps(ray.direction.z);
+	const __m128 invX = _mm_set1_ps(1.0f / ray.direction.x);
+	const __m128 invY = _mm_set1_ps(1.0f / ray.direction.y);
+	const __m128 invZ = _mm_set1_ps(1.0f / ray.direction.z);
+
+	int32_t stack[sk_StackSize];
+	int top = 0;
+	stack[top++] = 0;
+	while (top > 0) {
+		int32_t ref = stack[--top];
+
+		if (ref < 0) {
+			// Moller-Trumbore on four triangles
+			const TrianglePacket& packet = m_Packets[~ref];
+			__m128 e1x = _mm_load_ps(packet.m_E1X);
+			__m128 e1y = _mm_load_ps(packet.m_E1Y);
+			__m128 e1z = _mm_load_ps(packet.m_E1Z);
+			__m128 e2x = _mm_load_ps(packet.m_E2X);
+			__m128 e2y = _mm_load_ps(packet.m_E2Y);
+			__m128 e2z = _mm_load_ps(packet.m_E2Z);
+
+			__m128 px = _mm_sub_ps(_mm_mul_ps(dirY, e2z), _mm_mul_ps(dirZ, e2y));
+			__m128 py = _mm_sub_ps(_mm_mul_ps(dirZ, e2x), _mm_mul_ps(dirX, e2z));
+			__m128 pz = _mm_sub_ps(_mm_mul_ps(dirX, e2y), _mm_mul_ps(dirY, e2x));
+			__m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+			__m128 invDet = _mm_div_ps(one, det);
+
+			__m128 tx = _mm_sub_ps(originX, _mm_load_ps(packet.m_V0X));
+			__m128 ty = _mm_sub_ps(originY, _mm_load_ps(packet.m_V0Y));
+			__m128 tz = _mm_sub_ps(originZ, _mm_load_ps(packet.m_V0Z));
+			__m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, px), _mm_mul_ps(ty, py)), _mm_mul_ps(tz, pz)), invDet);
+
+			__m128 qx = _mm_sub_ps(_mm_mul_ps(ty, e1z), _mm_mul_ps(tz, e1y));
+			__m128 qy = _mm_sub_ps(_mm_mul_ps(tz, e1x), _mm_mul_ps(tx, e1z));
+			__m128 qz = _mm_sub_ps(_mm_mul_ps(tx, e1y), _mm_mul_ps(ty, e1x));
+			__m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dirX, qx), _mm_mul_ps(dirY, qy)), _mm_mul_ps(dirZ, qz)), invDet);
+			__m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), invDet);
+
+			// Degenerate padding lanes have a zero determinant, their NaNs fail every compare
+			__m128 hit = _mm_cmpneq_ps(det, zero);
+			hit = _mm_and_ps(hit, _mm_cmpge_ps(u, zero));
+			hit = _mm_and_ps(hit, _mm_cmpge_ps(v, zero));
+			hit = _mm_and_ps(hit, _mm_cmple_ps(_mm_add_ps(u, v), one));
+			hit = _mm_and_ps(hit, _mm_cmpge_ps(t, zero));
+			hit = _mm_and_ps(hit, _mm_cmplt_ps(t, _mm_set1_ps(tMax)));
+			int mask = _mm_movemask_ps(hit);
+			if (mask) {
+				alignas(16) float ts[4];
+				alignas(16) float us[4];
+				alignas(16) float vs[4];
+				_mm_store_ps(ts, t);
+				_mm_store_ps(us, u);
+				_mm_store_ps(vs, v);
+				for (int lane = 0; lane < 4; ++lane) {
+					if ((mask & (1 << lane)) && ts[lane] < tMax) {
+						tMax = onHit(ts[lane], packet.m_Triangle[lane], us[lane], vs[lane], tMax);
+					}
+				}
+			}
+			continue;
+		}
+
+		// Slab test against the four child boxes
+		const WideNode& node = m_Nodes[ref];
+		__m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.m_MinX), originX), invX);
+		__m128 t2 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.m_MaxX), originX), invX);
+		__m128 tNear = _mm_max_ps(_mm_min_ps(t1, t2), zero);
+		__m128 tFar = _mm_min_ps(_mm_max_ps(t1, t2), _mm_set1_ps(tMax));
+		t1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.m_MinY), originY), invY);
+		t2 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.m_MaxY), originY), invY);
+		tNear = _mm_max_ps(_mm_min_ps(t1, t2), tNear);
+		tFar = _mm_min_ps(_mm_max_ps(t1, t2), tFar);
+		t1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.m_MinZ), originZ), invZ);
+		t2 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.m_MaxZ), originZ), invZ);
+		tNear = _mm_max_ps(_mm_min_ps(t1, t2), tNear);
+		tFar = _mm_min_ps(_mm_max_ps(t1, t2), tFar);
+		int mask = _mm_movemask_ps(_mm_cmple_ps(tNear, tFar)) & ((1 << node.m_Count) - 1);
+		if (!mask) {
+			continue;
+		}
+
+		// Push the farthest child first so the nearest one is visited next
+		alignas(16) float nears[4];
+		_mm_store_ps(nears, tNear);
+		int order[4];
+		int hitCount = 0;
+		for (int lane = 0; lane < 4; ++lane) {
+			if (mask & (1 << lane)) {
+				int slot = hitCount++;
+				while (slot > 0 && nears[order[slot - 1]] < nears[lane]) {
+					order[slot] = order[slot - 1];
+					--slot;
+				}
+				order[slot] = lane;
+			}
+		}
+		for (int i = 0; i < hitCount; ++i) {
+			stack[top++] = node.m_Children[order[i]];
+		}
+	}
+}
+
+bool MeshBvh::IntersectClosest(const BvhRay& ray, BvhHit& hit) const {
+	hit = { ray.maxDistance, sk_NoHit, 0.0f, 0.0f };
+	Traverse(ray, [&hit](float t, uint32_t triangle, float u, float v, float) {
+		hit = { t, triangle, u, v };
+		return t;
+	});
+	return hit.triangle != sk_NoHit;
+}
+
+size_t MeshBvh::IntersectAll(const BvhRay& ray, std::vector<BvhHit>& hits) const {
+	size_t before = hits.size();
+	Traverse(ray, [&hits](float t, uint32_t triangle, float u, float v, float tMax) {
+		hits.push_back({ t, triangle, u, v });
+		return tMax;
+	});
+	return hits.size() - before;
+}
+
+void MeshBvh::IntersectBatch(const BvhRay* pRays, BvhHit* pHits, size_t count, JobSystem* pJobSystem) const {
+	auto castRange = [this, pRays, pHits](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			IntersectClosest(pRays[i], pHits[i]);
+		}
+	};
+	if (pJobSystem && count > sk_BatchSize) {
+		pJobSystem->ParallelFor(count, sk_BatchSize, castRange);
+	}
+	else {
+		castRange(0u, count);
+	}
+}
+
+size_t MeshBvh::GetTriangleCount() const {
+	return m_TriangleCount;
+}
+
+size_t MeshBvh::GetNodeCount() const {
+	return m_Nodes.size();
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <Windows.h>
+#include <DirectXMath.h>
+
+#include "vertex.h"
+
+class JobSystem;
+
+// Direction need not be normalized, distances are then in units of its length.
+struct BvhRay {
+	DirectX::XMFLOAT3 origin;
+	DirectX::XMFLOAT3 direction;
+	float maxDistance;
+};
+
+struct BvhHit {
+	float distance;
+	// Face index into the index list, MeshBvh::sk_NoHit on a miss
+	uint32_t triangle;
+	// Barycentric weights of the second and third vertex
+	float u;
+	float v;
+};
+
+// Bounding volume hierarchy over the triangles of one mesh part, in the part's local space. Built once with a binned
+// surface area heuristic and then collapsed to four children per node, so a single SSE test covers every child box.
+// Leaves hold up to four triangles stored as one packet and tested together. Immutable after construction and safe
+// to query from several threads.
+class MeshBvh {
+public:
+	static constexpr uint32_t sk_NoHit = UINT32_MAX;
+	static constexpr uint32_t sk_LeafSize = 4u;
+	static constexpr size_t sk_BatchSize = 64u;
+
+	MeshBvh(const Vertex* pVertices, const DWORD* pIndices, size_t indexCount);
+
+	// Nearest hit closer than ray.maxDistance, triangles are hit from both sides.
+	bool IntersectClosest(const BvhRay& ray, BvhHit& hit) const;
+	// Appends every hit closer than ray.maxDistance in no particular order and returns how many were added.
+	size_t IntersectAll(const BvhRay& ray, std::vector<BvhHit>& hits) const;
+	// Closest hit of each ray, split over the job system when there are enough rays. pJobSystem may be null.
+	void IntersectBatch(const BvhRay* pRays, BvhHit* pHits, size_t count, JobSystem* pJobSystem) const;
+
+	size_t GetTriangleCount() const;
+	size_t GetNodeCount() const;
+
+private:
+	struct alignas(16) WideNode {
+		float m_MinX[4];
+		float m_MinY[4];
+		float m_MinZ[4];
+		float m_MaxX[4];
+		float m_MaxY[4];
+		float m_MaxZ[4];
+		// Non negative is another node, negative is the packet ~child
+		int32_t m_Children[4];
+		uint32_t m_Count;
+	};
+
+	// First vertex and the two edges from it, unused lanes are degenerate and never hit.
+	struct alignas(16) TrianglePacket {
+		float m_V0X[4];
+		float m_V0Y[4];
+		float m_V0Z[4];
+		float m_E1X[4];
+		float m_E1Y[4];
+		float m_E1Z[4];
+		float m_E2X[4];
+		float m_E2Y[4];
+		float m_E2Z[4];
+		uint32_t m_Triangle[4];
+	};
+
+	template <class OnHit>
+	void Traverse(const BvhRay& ray, OnHit&& onHit) const;
+
+	std::vector<WideNode> m_Nodes;
+	std::vector<TrianglePacket> m_Packets;
+	size_t m_TriangleCount = 0u;
+};
\ No newline at end of file
@@ -1,21 +1,245 @@
 #include <Windows.h>
+#include <shellapi.h>
 #include <utility>
 #include <tuple>
 #include <string>
+#include <fstream>
+#include <vector>
 
 #pragma comment(lib,"d3d11.lib")
 #pragma comment(lib,"DirectXTK.lib")
 #pragma comment(lib,"DXGI.lib")
 #pragma comment(lib,"D3DCompiler.lib")
 #pragma comment(lib,"assimp-vc142-mtd.lib")
+#pragma comment(lib,"Shell32.lib")
 
 #include "tools/error_logger.h"
 #include "engine/render_window.h"
 #include "engine/engine.h"
+#include "graphics/mesh_baker.h"
+#include "engine/scene_benchmark.h"
+#include "engine/transform_benchmark.h"
+#include "engine/spawn_benchmark.h"
+#include "engine/first_frame_benchmark.h"
+#include "engine/mesh_load_benchmark.h"
+#include "engine/archive_benchmark.h"
 
 using namespace std::literals;
 
+// Project289.exe -bake models/a.obj models/b.obj ... writes models/a.bmesh and so on without starting the engine.
+static int BakeMeshes(int argc, LPWSTR* argv) {
+	int failed = 0;
+	for (int i = 2; i < argc; ++i) {
+		std::string source = w2s(argv[i]);
+		if (!BakeMeshFile(source, GetBakedMeshPath(source))) {
+			ErrorLogger::Log("Failed to bake mesh " + source);
+			++failed;
+		}
+	}
+	return failed;
+}
+
+// Project289.exe -bench World.xml 1000 plays the level for 1000 frames on the headless renderer and writes the per
+// stage CPU timings to bench_scene.txt.
+static int BenchScene(int argc, LPWSTR* argv) {
+	if (argc < 3) {
+		ErrorLogger::Log("Usage: -bench <level.xml> [frames]");
+		return 1;
+	}
+	std::string level = w2s(argv[2]);
+	int frames = argc > 3 ? _wtoi(argv[3]) : 1000;
+
+	Engine engine;
+	if (!engine.InitializeHeadless(EngineOptions("EngineOptions.xml"s))) {
+		return 1;
+	}
+
+	SceneBenchmark benchmark(static_cast<HeadlessRenderer*>(engine.GetRenderer()));
+	if (!benchmark.LoadLevel(level)) {
+		ErrorLogger::Log("Failed to load level " + level);
+		return 1;
+	}
+	benchmark.Run(frames);
+
+	std::ofstream report("bench_scene.txt");
+	report << level << "\n" << benchmark.Report();
+	return 0;
+}
+
+// Project289.exe -bench-instancing World.xml data\actors\InstancedFeisar.xml 1000 1000 adds 1000 copies of the actor to
+// the level, plays it for 1000 frames with instancing off and then on and writes both reports to bench_instancing.txt.
+static int BenchInstancing(int argc, LPWSTR* argv) {
+	if (argc < 4) {
+		ErrorLogger::Log("Usage: -bench-instancing <level.xml> <actor.xml> [count] [frames]");
+		return 1;
+	}
+	std::string level = w2s(argv[2]);
+	std::string actor = w2s(argv[3]);
+	int count = argc > 4 ? _wtoi(argv[4]) : 1000;
+	int frames = argc > 5 ? _wtoi(argv[5]) : 1000;
+
+	Engine engine;
+	if (!engine.InitializeHeadless(EngineOptions("EngineOptions.xml"s))) {
+		return 1;
+	}
+
+	SceneBenchmark benchmark(static_cast<HeadlessRenderer*>(engine.GetRenderer()));
+	if (!benchmark.LoadLevel(level)) {
+		ErrorLogger::Log("Failed to load level " + level);
+		return 1;
+	}
+	int spawned = benchmark.SpawnActors(actor, count);
+
+	std::ofstream report("bench_instancing.txt");
+	report << level << " + " << spawned << " x " << actor << "\n";
+	benchmark.SetInstancing(false);
+	benchmark.Run(frames);
+	report << "instancing off\n" << benchmark.Report();
+	benchmark.SetInstancing(true);
+	benchmark.Run(frames);
+	report << "instancing on\n" << benchmark.Report();
+	return 0;
+}
+
+// Project289.exe -bench-transforms 100000 1000 builds a synthetic scene of 100000 nodes, runs the transform update and
+// the cull stage for 1000 frames with none, 1% and all of them moving and writes the timings to bench_transforms.txt.
+static int BenchTransforms(int argc, LPWSTR* argv) {
+	int nodes = argc > 2 ? _wtoi(argv[2]) : 100000;
+	int frames = argc > 3 ? _wtoi(argv[3]) : 1000;
+
+	Engine engine;
+	if (!engine.InitializeHeadless(EngineOptions("EngineOptions.xml"s))) {
+		return 1;
+	}
+
+	std::ofstream report("bench_transforms.txt");
+	report << BenchmarkTransforms(static_cast<HeadlessRenderer*>(engine.GetRenderer()), nodes, frames);
+	return 0;
+}
+
+// Project289.exe -bench-spawn data\actors\MeshRenderComponent.xml 10000 builds 10000 actors from the template with and
+// without the prototype cache and writes the actors per second to bench_spawn.txt.
+static int BenchSpawn(int argc, LPWSTR* argv) {
+	if (argc < 3) {
+		ErrorLogger::Log("Usage: -bench-spawn <actor.xml> [count]");
+		return 1;
+	}
+	std::string actor = w2s(argv[2]);
+	int count = argc > 3 ? _wtoi(argv[3]) : 10000;
+
+	Engine engine;
+	if (!engine.InitializeHeadless(EngineOptions("EngineOptions.xml"s))) {
+		return 1;
+	}
+
+	std::ofstream report("bench_spawn.txt");
+	report << BenchmarkSpawn(actor, count);
+	return 0;
+}
+
+// Project289.exe -bench-archive data\actors\MeshRenderComponent.xml 10000 10 spawns 10000 actors, saves and reloads
+// them 10 times as XML and through the binary archive and writes the throughput to bench_archive.txt.
+static int BenchArchive(int argc, LPWSTR* argv) {
+	if (argc < 3) {
+		ErrorLogger::Log("Usage: -bench-archive <actor.xml> [count] [repeats]");
+		return 1;
+	}
+	std::string actor = w2s(argv[2]);
+	int count = argc > 3 ? _wtoi(argv[3]) : 10000;
+	int repeats = argc > 4 ? _wtoi(argv[4]) : 10;
+
+	Engine engine;
+	if (!engine.InitializeHeadless(EngineOptions("EngineOptions.xml"s))) {
+		return 1;
+	}
+
+	std::ofstream report("bench_archive.txt");
+	report << BenchmarkArchive(actor, count, repeats);
+	return 0;
+}
+
+// Project289.exe -bench-mesh-load 10 models/a.obj models/b.obj ... bakes the models, then loads each 10 times through
+// Assimp and from the baked file and writes the load times to bench_mesh_load.txt. Needs no engine.
+static int BenchMeshLoad(int argc, LPWSTR* argv) {
+	if (argc < 4) {
+		ErrorLogger::Log("Usage: -bench-mesh-load <repeats> <model> [model...]");
+		return 1;
+	}
+	int repeats = _wtoi(argv[2]);
+	std::vector<std::string> sources;
+	for (int i = 3; i < argc; ++i) {
+		sources.push_back(w2s(argv[i]));
+	}
+
+	std::ofstream report("bench_mesh_load.txt");
+	report << BenchmarkMeshLoad(sources, repeats);
+	return 0;
+}
+
+// Project289.exe -bench-first-frame World.xml streams the level in on the headless renderer and writes the time to its
+// first complete frame to bench_first_frame.txt.
+static int BenchFirstFrame(int argc, LPWSTR* argv) {
+	if (argc < 3) {
+		ErrorLogger::Log("Usage: -bench-first-frame <level.xml>");
+		return 1;
+	}
+	std::string level = w2s(argv[2]);
+
+	Engine engine;
+	if (!engine.InitializeHeadless(EngineOptions("EngineOptions.xml"s))) {
+		return 1;
+	}
+
+	std::ofstream report("bench_first_frame.txt");
+	report << BenchmarkFirstFrame(static_cast<HeadlessRenderer*>(engine.GetRenderer()), level);
+	return 0;
+}
+
 int APIENTRY wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _In_ LPWSTR lpCmdLine, _In_ int nCmdShow) {
+	int argc = 0;
+	LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+	if (argv && argc > 1 && argv[1] == L"-bake"s) {
+		int result = BakeMeshes(argc, argv);
+		LocalFree(argv);
+		return result;
+	}
+	if (argv && argc > 1 && argv[1] == L"-bench"s) {
+		int result = BenchScene(argc, argv);
+		LocalFree(argv);
+		return result;
+	}
+	if (argv && argc > 1 && argv[1] == L"-bench-instancing"s) {
+		int result = BenchInstancing(argc, argv);
+		LocalFree(argv);
+		return result;
+	}
+	if (argv && argc > 1 && argv[1] == L"-bench-transforms"s) {
+		int result = BenchTransforms(argc, argv);
+		LocalFree(argv);
+		return result;
+	}
+	if (argv && argc > 1 && argv[1] == L"-bench-spawn"s) {
+		int result = BenchSpawn(argc, argv);
+		LocalFree(argv);
+		return result;
+	}
+	if (argv && argc > 1 && argv[1] == L"-bench-archive"s) {
+		int result = BenchArchive(argc, argv);
+		LocalFree(argv);
+		return result;
+	}
+	if (argv && argc > 1 && argv[1] == L"-bench-mesh-load"s) {
+		int result = BenchMeshLoad(argc, argv);
+		LocalFree(argv);
+		return result;
+	}
+	if (argv && argc > 1 && argv[1] == L"-bench-first-frame"s) {
+		int result = BenchFirstFrame(argc, argv);
+		LocalFree(argv);
+		return result;
+	}
+	LocalFree(argv);
+
 	Engine engine;
 	bool can_run = engine.Initialize(
 		RenderWindowConfig{EngineOptions("EngineOptions.xml"s)}
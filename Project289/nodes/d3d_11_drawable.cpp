@@ -1,6 +1,8 @@
 #include "d3d_11_drawable.h"
-#include "../engine/engine.h"
-#include "../engine/d3d_renderer11.h"
+#include "scene.h"
+#include "camera_node.h"
+#include "render_queue.h"
+#include "../engine/i_renderer.h"
 
 D3D11Drawable::D3D11Drawable(BaseRenderComponent* renderComponent, const DirectX::XMFLOAT4X4* pMatrix) : SceneNode(renderComponent, RenderPass::RenderPass_Actor, pMatrix) {}
 
@@ -9,18 +11,73 @@ D3D11Drawable::D3D11Drawable(BaseRenderComponent* renderComponent, DirectX::FXMM
 D3D11Drawable::~D3D11Drawable() {}
 
 void D3D11Drawable::AddBind(BindableType key, std::unique_ptr<Bindable> bind) {
-	m_binds[key] = std::move(bind);
+	m_binds[static_cast<size_t>(key)] = std::move(bind);
+}
+
+Bindable* D3D11Drawable::GetBind(BindableType key) const {
+	return m_binds[static_cast<size_t>(key)].get();
 }
 
 HRESULT D3D11Drawable::VRender(Scene* pScene) {
-	D3DRenderer11* renderer = static_cast<D3DRenderer11*>(g_pApp->GetRenderer());
-	ID3D11DeviceContext* deviceContext = renderer->GetDeviceContext();
+	// Drawn outside the queue (alpha pass), so nothing can be assumed about what is bound
+	RenderStateCache stateCache;
+	VSubmit(pScene->GetRenderer(), stateCache);
+	return S_OK;
+}
+
+bool D3D11Drawable::VQueueRender(Scene* pScene) {
+	pScene->GetRenderQueue().Push(MakeSortKey(pScene), this);
+	return true;
+}
+
+void D3D11Drawable::VSubmit(IRenderer* pRenderer, RenderStateCache& stateCache) {
+	BindState(pRenderer, stateCache);
+	pRenderer->VDrawIndexed(VGetIndexCount());
+}
 
-	for (auto const& [key, val] : m_binds) {
-		val->Bind(deviceContext);
+void D3D11Drawable::BindState(IRenderer* pRenderer, RenderStateCache& stateCache, Bindable* pInstancedVertexShader) const {
+	for (size_t i = 0u; i < m_binds.size(); ++i) {
+		Bindable* pBind = m_binds[i].get();
+		if (pInstancedVertexShader) {
+			if (i == static_cast<size_t>(BindableType::vertex_shader)) {
+				pBind = pInstancedVertexShader;
+			}
+			else if (i == static_cast<size_t>(BindableType::vertex_constant_buffer)) {
+				continue;
+			}
+		}
+		if (pBind && stateCache.NeedsBind(static_cast<BindableType>(i), pBind->GetStateId())) {
+			pRenderer->VBind(pBind);
+		}
 	}
-	size_t index_count = static_cast<const IndexBufferBindable*>(m_binds.at(BindableType::index_buffer).get())->GetCount();
-	deviceContext->DrawIndexed(index_count, 0u, 0u);
+}
 
-	return S_OK;
+UINT D3D11Drawable::VGetIndexCount() const {
+	return static_cast<const IndexBufferBindable*>(GetBind(BindableType::index_buffer))->GetCount();
 }
+
+uint64_t D3D11Drawable::MakeSortKey(Scene* pScene, uint64_t instanceKey) const {
+	auto stateId = [this](BindableType key) {
+		Bindable* pBind = GetBind(key);
+		return pBind ? pBind->GetStateId() : 0u;
+	};
+	uint32_t shaderId;
+	uint32_t materialId;
+	if (instanceKey != 0u) {
+		// Every instance has its own buffers and views, the key is what they have in common
+		shaderId = RenderQueue::HashStateIds(instanceKey, 0u);
+		materialId = RenderQueue::HashStateIds(0u, instanceKey);
+	}
+	else {
+		shaderId = RenderQueue::HashStateIds(stateId(BindableType::vertex_shader), stateId(BindableType::pixel_shader));
+		materialId = RenderQueue::HashStateIds(stateId(BindableType::shader_resource), stateId(BindableType::input_layout));
+	}
+
+	float depth = 0.0f;
+	const std::shared_ptr<CameraNode>& pCamera = pScene->GetCamera();
+	if (pCamera) {
+		depth = pScene->GetViewDepth(m_WorldTransform) / pCamera->GetFrustum().m_Far;
+	}
+
+	return RenderQueue::MakeSortKey(m_Props.RenderPass(), shaderId, materialId, depth);
+}
\ No newline at end of file
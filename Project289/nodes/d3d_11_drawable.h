@@ -1,8 +1,8 @@
 #pragma once
 
+#include <array>
 #include <memory>
 #include <vector>
-#include <unordered_map>
 #include <d3d11.h>
 #include <DirectXMath.h>
 
@@ -17,9 +17,20 @@ public:
 	virtual ~D3D11Drawable();
 
 	virtual HRESULT VRender(Scene* pScene) override;
+	virtual bool VQueueRender(Scene* pScene) override;
+	virtual void VSubmit(IRenderer* pRenderer, RenderStateCache& stateCache) override;
 
 	virtual void AddBind(BindableType key, std::unique_ptr<Bindable> bind);
+	Bindable* GetBind(BindableType key) const;
 
 protected:
-	std::unordered_map<BindableType, std::unique_ptr<Bindable>> m_binds;
+	// Indexed by BindableType, so a draw walks the slots in a fixed order without hashing.
+	std::array<std::unique_ptr<Bindable>, BindableTypeCount> m_binds;
+
+	// Nodes drawn as instances pass their instance key, so the shader and material bits match across the instances.
+	uint64_t MakeSortKey(Scene* pScene, uint64_t instanceKey = 0u) const;
+	virtual UINT VGetIndexCount() const;
+	// Binds the slots that differ from the cache. An instanced vertex shader replaces the node's own and leaves out
+	// the per object constant buffer, its transforms come from the instance buffer.
+	void BindState(IRenderer* pRenderer, RenderStateCache& stateCache, Bindable* pInstancedVertexShader = nullptr) const;
 };
\ No newline at end of file
@@ -17,22 +17,26 @@
 #include "../actors/mesh_render_component.h"
 #include "../graphics/material_texture.h"
 #include "../nodes/light_manager.h"
+#include "../nodes/render_queue.h"
+#include "../nodes/occlusion_culler.h"
 
 D3D11Mesh::D3D11Mesh(int mesh_id, BaseRenderComponent* renderComponent, const DirectX::XMFLOAT4X4* pMatrix) : D3D11Mesh(mesh_id, renderComponent, DirectX::XMLoadFloat4x4(pMatrix), DirectX::XMMatrixIdentity(), true) {}
 
 D3D11Mesh::D3D11Mesh(int mesh_id, BaseRenderComponent* renderComponent, DirectX::FXMMATRIX to, DirectX::CXMMATRIX from, bool calculate_from) : D3D11Drawable(nullptr, to, from, calculate_from) {
 	m_mesh_id = mesh_id;
+	m_instance_key = 0u;
 
 	MeshRenderComponent* mrc = static_cast<MeshRenderComponent*>(renderComponent);
 	MeshHolder& mesh = mrc->GetMesh(mesh_id);
+	SetOccluderGeometry(mrc);
 
 	D3DRenderer11* renderer = static_cast<D3DRenderer11*>(g_pApp->GetRenderer());
 	ID3D11Device* device = renderer->GetDevice();
 
-	std::unique_ptr<VertexBufferBindable> vb = std::make_unique<VertexBufferBindable>(device, mesh.vertices);
+	std::unique_ptr<VertexBufferBindable> vb = std::make_unique<VertexBufferBindable>(device, mesh.GetVertices(), mesh.GetVertexCount());
 	AddBind(BindableType::vertex_buffer_bindable, std::move(vb));
 
-	std::unique_ptr<IndexBufferBindable> ibuf = std::make_unique<IndexBufferBindable>(device, mesh.indices);
+	std::unique_ptr<IndexBufferBindable> ibuf = std::make_unique<IndexBufferBindable>(device, mesh.GetIndices(), mesh.GetIndexCount());
 	AddBind(BindableType::index_buffer, std::move(ibuf));
 
 	bool can_draw = m_vs.Initialize(
@@ -46,6 +50,12 @@ D3D11Mesh::D3D11Mesh(int mesh_id, BaseRenderComponent* renderComponent, DirectX:
 	ID3DBlob* pvsbc = pvs->GetBytecode();
 	AddBind(BindableType::vertex_shader, std::move(pvs));
 
+	// Same input signature as the vertex shader, the input layout is shared
+	const std::string& instancedShader = mrc->GetInstancedVertexShaderResource();
+	if (!instancedShader.empty() && m_instanced_vs.Initialize(device, ShaderGonfig{}.set_shader_name(s2w(instancedShader)).set_description(mrc->GetLayout()))) {
+		SetInstancedVertexShader(std::make_unique<VertexShaderBindable>(device, m_instanced_vs.GetBuffer(), m_instanced_vs.GetShader()), mrc->GetInstanceKey(mesh_id));
+	}
+
 	can_draw &= m_ps.Initialize(
 		device,
 		ShaderGonfig{}
@@ -100,6 +110,12 @@ D3D11Mesh::D3D11Mesh(int mesh_id, BaseRenderComponent* renderComponent, DirectX:
 	AddBind(BindableType::pixel_constant_buffer, std::move(cbps1));
 }
 
+D3D11Mesh::D3D11Mesh(int mesh_id, DirectX::FXMMATRIX to, DirectX::CXMMATRIX from, bool calculate_from) : D3D11Drawable(nullptr, to, from, calculate_from) {
+	m_mesh_id = mesh_id;
+	m_instance_key = 0u;
+	SetOccluderGeometry(nullptr);
+}
+
 D3D11Mesh::~D3D11Mesh() {}
 
 HRESULT D3D11Mesh::VOnUpdate(Scene* pScene, float const elapsedMs) {
@@ -109,31 +125,110 @@ HRESULT D3D11Mesh::VOnUpdate(Scene* pScene, float const elapsedMs) {
 HRESULT D3D11Mesh::VPreRender(Scene* pScene) {
 	//StrongActorPtr pActor = MakeStrongPtr(g_pApp->GetGameLogic()->VGetActor(VGet().ActorId()));
 	StrongActorPtr pActor = MakeStrongPtr(g_pApp->GetGameLogic()->VGetActor(VFindMyActor()));
-	
-	D3DRenderer11* renderer = static_cast<D3DRenderer11*>(g_pApp->GetRenderer());
-	ID3D11DeviceContext* deviceContext = renderer->GetDeviceContext();
+	IRenderer* renderer = pScene->GetRenderer();
 	SceneNode::VPreRender(pScene);
 
 	const std::shared_ptr<CameraNode> camera = pScene->GetCamera();
 
-	std::shared_ptr<MeshRenderComponent> pMeshComponent = MakeStrongPtr(pActor->GetComponent<MeshRenderComponent>(MeshRenderComponent::g_Name));
+	LightManager* lightManager = pScene->GetLightManager();
+	lightManager->CopyLighting(&m_lighting, this);
+
+	// Instances take their transforms from the instance buffer and their lighting when the run is submitted
+	if (IsDrawnInstanced(pScene)) {
+		return S_OK;
+	}
+
+	MeshRenderComponent* pMeshComponent = pActor->GetComponentFast<MeshRenderComponent>();
 	CB_VS_VertexShader mt;
 	mt.lwvpMatrix = camera->GetWorldViewProjection4x4T(pScene);
-	mt.invWorldMatrix = pScene->GetTopInvMatrix4x4fT();
-	mt.worldMatrix = pScene->GetTopMatrix4x4fT();
+	DirectX::XMStoreFloat4x4(&mt.invWorldMatrix, DirectX::XMMatrixTranspose(DirectX::XMLoadFloat4x4(&m_WorldInvTransform)));
+	DirectX::XMStoreFloat4x4(&mt.worldMatrix, DirectX::XMMatrixTranspose(DirectX::XMLoadFloat4x4(&m_WorldTransform)));
 	mt.material.Ambient.w = pMeshComponent->GetColor().w;
 
 	//unsigned int componentId = ActorComponent::GetIdFromName("MeshComponent");
 
-	static_cast<VertexConstantBufferBindable<CB_VS_VertexShader>*>(m_binds[BindableType::vertex_constant_buffer].get())->Update(deviceContext, mt);
+	renderer->VUpdateConstantBuffer(GetBind(BindableType::vertex_constant_buffer), &mt, sizeof(mt));
+	renderer->VUpdateConstantBuffer(GetBind(BindableType::pixel_constant_buffer), &m_lighting, sizeof(m_lighting));
 
-	CB_PS_PixelShader_Light lt;
-	LightManager* lightManager = pScene->GetLightManager();
-	lightManager->CopyLighting(&lt, this);
+	return S_OK;
+}
 
-	static_cast<PixelConstantBufferBindable<CB_PS_PixelShader_Light>*>(m_binds[BindableType::pixel_constant_buffer].get())->Update(deviceContext, lt);
+bool D3D11Mesh::VQueueRender(Scene* pScene) {
+	if (!IsDrawnInstanced(pScene)) {
+		return D3D11Drawable::VQueueRender(pScene);
+	}
 
-	return S_OK;
+	InstanceData instance;
+	DirectX::XMStoreFloat4x4(&instance.worldMatrix, DirectX::XMMatrixTranspose(DirectX::XMLoadFloat4x4(&m_WorldTransform)));
+	DirectX::XMStoreFloat4x4(&instance.invWorldMatrix, DirectX::XMMatrixTranspose(DirectX::XMLoadFloat4x4(&m_WorldInvTransform)));
+	pScene->GetRenderQueue().PushInstance(MakeSortKey(pScene, m_instance_key), this, m_instance_key, instance);
+	return true;
+}
+
+void D3D11Mesh::VSubmitInstanced(IRenderer* pRenderer, RenderStateCache& stateCache, const InstanceData* pInstances, UINT count) {
+	BindState(pRenderer, stateCache, m_instanced_vs_bind.get());
+	// Every mesh copies the same scene lighting, the first instance's copy stands for the run
+	pRenderer->VUpdateConstantBuffer(GetBind(BindableType::pixel_constant_buffer), &m_lighting, sizeof(m_lighting));
+	pRenderer->VDrawIndexedInstanced(VGetIndexCount(), pInstances, count);
+}
+
+void D3D11Mesh::SetInstancedVertexShader(std::unique_ptr<Bindable> pBind, uint64_t instanceKey) {
+	m_instanced_vs_bind = std::move(pBind);
+	m_instance_key = instanceKey;
+}
+
+void D3D11Mesh::SetOccluderGeometry(MeshRenderComponent* pMeshComponent) {
+	if (!pMeshComponent || !pMeshComponent->IsOccluder()) {
+		m_occluder_vertices = nullptr;
+		m_occluder_vertex_count = 0u;
+		m_occluder_indices = nullptr;
+		m_occluder_index_count = 0u;
+		return;
+	}
+	// The holder keeps the asset alive as long as the component, which outlives its scene nodes
+	const MeshHolder& mesh = pMeshComponent->GetMesh(m_mesh_id);
+	m_occluder_vertices = mesh.GetVertices();
+	m_occluder_vertex_count = mesh.GetVertexCount();
+	m_occluder_indices = mesh.GetIndices();
+	m_occluder_index_count = mesh.GetIndexCount();
+}
+
+bool D3D11Mesh::VGetOccluderGeometry(OccluderMesh& occluder) const {
+	if (!m_occluder_vertices) {
+		return false;
+	}
+	occluder.pVertices = m_occluder_vertices;
+	occluder.vertexCount = m_occluder_vertex_count;
+	occluder.pIndices = m_occluder_indices;
+	occluder.indexCount = m_occluder_index_count;
+	return true;
+}
+
+bool D3D11Mesh::IsDrawnInstanced(Scene* pScene) const {
+	// Same alpha test as SceneNode::VRenderChildren, translucent meshes are drawn in the alpha pass on their own
+	return m_instance_key != 0u && pScene->GetRenderQueue().IsInstancing() && m_Props.GetMaterial().GetAlpha() == 1.0f;
+}
+
+HRESULT D3D11Mesh::VPick(Scene* pScene, RayCast* pRayCast) {
+	StrongActorPtr pActor = MakeStrongPtr(g_pApp->GetGameLogic()->VGetActor(VFindMyActor()));
+	if (pActor) {
+		MeshRenderComponent* pMeshComponent = pActor->GetComponentFast<MeshRenderComponent>();
+		if (pMeshComponent) {
+			const MeshHolder& mesh = pMeshComponent->GetMesh(m_mesh_id);
+			HRESULT hr = pRayCast->Pick(pActor->GetId(), mesh.GetBvh(), mesh.GetVertices(), mesh.GetIndices(), m_WorldTransform, m_WorldInvTransform);
+			if (FAILED(hr)) { return hr; }
+		}
+	}
+	return SceneNode::VPick(pScene, pRayCast);
+}
+
+const MeshBvh* D3D11Mesh::VGetPickBvh() {
+	StrongActorPtr pActor = MakeStrongPtr(g_pApp->GetGameLogic()->VGetActor(VFindMyActor()));
+	if (!pActor) {
+		return nullptr;
+	}
+	MeshRenderComponent* pMeshComponent = pActor->GetComponentFast<MeshRenderComponent>();
+	return pMeshComponent ? &pMeshComponent->GetMesh(m_mesh_id).GetBvh() : nullptr;
 }
 
 ActorId D3D11Mesh::VFindMyActor() {
@@ -6,11 +6,25 @@
 #include "d3d_11_drawable.h"
 #include "../graphics/material_texture.h"
 #include "../graphics/shader.h"
+#include "../graphics/constant_buffer_types.h"
+
+class MeshRenderComponent;
 
 class D3D11Mesh : public D3D11Drawable {
 	VertexShader m_vs;
 	PixelShader m_ps;
+	VertexShader m_instanced_vs;
 	int m_mesh_id;
+	// Takes the place of the vertex shader in instanced draws, null when the mesh is always drawn on its own.
+	std::unique_ptr<Bindable> m_instanced_vs_bind;
+	uint64_t m_instance_key;
+	// Kept from VPreRender for instanced draws, which update the pixel constant buffer at submit.
+	CB_PS_PixelShader_Light m_lighting;
+	// Geometry borrowed from the component's mesh when the actor is an occluder, null otherwise.
+	const Vertex* m_occluder_vertices;
+	size_t m_occluder_vertex_count;
+	const DWORD* m_occluder_indices;
+	size_t m_occluder_index_count;
 
 public:
 	D3D11Mesh(int mesh_id, BaseRenderComponent* renderComponent, const DirectX::XMFLOAT4X4* pMatrix);
@@ -18,6 +32,20 @@ public:
 	virtual ~D3D11Mesh();
 	virtual HRESULT VOnUpdate(Scene* pScene, float const elapsedMs) override;
 	virtual HRESULT VPreRender(Scene* pScene) override;
+	virtual bool VQueueRender(Scene* pScene) override;
+	virtual void VSubmitInstanced(IRenderer* pRenderer, RenderStateCache& stateCache, const InstanceData* pInstances, UINT count) override;
+	virtual bool VGetOccluderGeometry(OccluderMesh& occluder) const override;
+	virtual HRESULT VPick(Scene* pScene, RayCast* pRayCast) override;
+	virtual const MeshBvh* VGetPickBvh() override;
 
 	virtual ActorId VFindMyActor();
+
+protected:
+	// For meshes that fill m_binds themselves, creates no device objects.
+	D3D11Mesh(int mesh_id, DirectX::FXMMATRIX to, DirectX::CXMMATRIX from, bool calulate_from);
+	void SetInstancedVertexShader(std::unique_ptr<Bindable> pBind, uint64_t instanceKey);
+	// Opaque meshes with an instanced vertex shader go through the queue as instances while instancing is on.
+	bool IsDrawnInstanced(Scene* pScene) const;
+	// Keeps the mesh's triangles for occlusion culling when the component marks the actor as an occluder.
+	void SetOccluderGeometry(MeshRenderComponent* pMeshComponent);
 };
\ No newline at end of file
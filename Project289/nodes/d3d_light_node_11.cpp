@@ -10,8 +10,7 @@ HRESULT D3DLightNode11::VOnRestore(Scene* pScene) {
 }
 
 HRESULT D3DLightNode11::VOnUpdate(Scene*, float elapsedSeconds) {
-	unsigned int componentId = ActorComponent::GetIdFromName("LightRenderComponent");
-	std::shared_ptr<LightRenderComponent> rc = MakeStrongPtr(m_RenderComponent->GetOwner()->GetComponent<LightRenderComponent>(componentId));
+	LightRenderComponent* rc = m_RenderComponent->GetOwner()->GetComponentFast<LightRenderComponent>();
 	m_light_props = rc->GetLight();
 	
 	return S_OK;
@@ -0,0 +1,115 @@
+#include "frustum_culler.h"
+#include "../tools/job_system.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#else
+#include <xmmintrin.h>
+#endif
+
+void FrustumCuller::Resize(size_t count) {
+	m_count = count;
+	size_t padded = (count + 63u) & ~size_t(63u);
+	m_x.resize(padded, 0.0f);
+	m_y.resize(padded, 0.0f);
+	m_z.resize(padded, 0.0f);
+	m_radius.resize(padded, 0.0f);
+	m_visible.resize(padded / 64u, 0u);
+}
+
+size_t FrustumCuller::GetCount() const {
+	return m_count;
+}
+
+void FrustumCuller::SetSphere(size_t index, float x, float y, float z, float radius) {
+	m_x[index] = x;
+	m_y[index] = y;
+	m_z[index] = z;
+	m_radius[index] = radius;
+}
+
+void FrustumCuller::SetPlanes(const Frustum& frustum, const DirectX::XMFLOAT4X4& view) {
+	// A view space plane p becomes p * transpose(view) in world space
+	DirectX::XMMATRIX viewT = DirectX::XMMatrixTranspose(DirectX::XMLoadFloat4x4(&view));
+	for (size_t i = 0u; i < m_planes.size(); ++i) {
+		DirectX::XMVECTOR plane = DirectX::XMLoadFloat4(&frustum.m_Planes[i].GetCoefficients());
+		DirectX::XMStoreFloat4(&m_planes[i], DirectX::XMPlaneTransform(plane, viewT));
+	}
+}
+
+void FrustumCuller::Cull(JobSystem* pJobSystem) {
+	size_t padded = m_x.size();
+	if (pJobSystem && padded >= sk_ParallelThreshold) {
+		pJobSystem->ParallelFor(padded, sk_BatchSize, [this](size_t begin, size_t end) { CullRange(begin, end); });
+	}
+	else {
+		CullRange(0u, padded);
+	}
+}
+
+bool FrustumCuller::IsVisible(size_t index) const {
+	if (index >= m_count) {
+		return true;
+	}
+	return (m_visible[index >> 6u] >> (index & 63u)) & 1u;
+}
+
+const std::array<DirectX::XMFLOAT4, 6>& FrustumCuller::GetPlanes() const {
+	return m_planes;
+}
+
+void FrustumCuller::CullRange(size_t begin, size_t end) {
+	// Same test as Plane::Inside: a sphere is out once its center is more than radius behind any plane
+#if defined(__AVX__)
+	constexpr size_t width = 8u;
+	__m256 planes[6][4];
+	for (size_t p = 0u; p < 6u; ++p) {
+		planes[p][0] = _mm256_set1_ps(m_planes[p].x);
+		planes[p][1] = _mm256_set1_ps(m_planes[p].y);
+		planes[p][2] = _mm256_set1_ps(m_planes[p].z);
+		planes[p][3] = _mm256_set1_ps(m_planes[p].w);
+	}
+	const __m256 zero = _mm256_setzero_ps();
+#else
+	constexpr size_t width = 4u;
+	__m128 planes[6][4];
+	for (size_t p = 0u; p < 6u; ++p) {
+		planes[p][0] = _mm_set1_ps(m_planes[p].x);
+		planes[p][1] = _mm_set1_ps(m_planes[p].y);
+		planes[p][2] = _mm_set1_ps(m_planes[p].z);
+		planes[p][3] = _mm_set1_ps(m_planes[p].w);
+	}
+	const __m128 zero = _mm_setzero_ps();
+#endif
+
+	for (size_t word = begin >> 6u; word < (end >> 6u); ++word) {
+		uint64_t bits = 0u;
+		for (size_t lane = 0u; lane < 64u; lane += width) {
+			size_t i = (word << 6u) + lane;
+#if defined(__AVX__)
+			__m256 x = _mm256_loadu_ps(&m_x[i]);
+			__m256 y = _mm256_loadu_ps(&m_y[i]);
+			__m256 z = _mm256_loadu_ps(&m_z[i]);
+			__m256 negRadius = _mm256_sub_ps(zero, _mm256_loadu_ps(&m_radius[i]));
+			__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+			for (size_t p = 0u; p < 6u; ++p) {
+				__m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(planes[p][0], x), _mm256_mul_ps(planes[p][1], y)), _mm256_add_ps(_mm256_mul_ps(planes[p][2], z), planes[p][3]));
+				inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, negRadius, _CMP_GE_OQ));
+			}
+			bits |= static_cast<uint64_t>(_mm256_movemask_ps(inside)) << lane;
+#else
+			__m128 x = _mm_loadu_ps(&m_x[i]);
+			__m128 y = _mm_loadu_ps(&m_y[i]);
+			__m128 z = _mm_loadu_ps(&m_z[i]);
+			__m128 negRadius = _mm_sub_ps(zero, _mm_loadu_ps(&m_radius[i]));
+			__m128 inside = _mm_cmpeq_ps(zero, zero);
+			for (size_t p = 0u; p < 6u; ++p) {
+				__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planes[p][0], x), _mm_mul_ps(planes[p][1], y)), _mm_add_ps(_mm_mul_ps(planes[p][2], z), planes[p][3]));
+				inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, negRadius));
+			}
+			bits |= static_cast<uint64_t>(_mm_movemask_ps(inside)) << lane;
+#endif
+		}
+		m_visible[word] = bits;
+	}
+}
\ No newline at end of file
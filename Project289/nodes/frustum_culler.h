@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <DirectXMath.h>
+
+#include "frustum.h"
+
+class JobSystem;
+
+// World space bounding spheres kept as structure of arrays and tested against the six frustum planes four at a
+// time with SSE, eight at a time when the project is built with /arch:AVX. The result is a bitset indexed like the
+// spheres. Large sets are split over the job system in blocks of whole bitset words.
+class FrustumCuller {
+public:
+	static constexpr size_t sk_ParallelThreshold = 16384u;
+	static constexpr size_t sk_BatchSize = 4096u;
+
+	// Keeps the spheres below count, new ones start as a zero sphere at the origin.
+	void Resize(size_t count);
+	size_t GetCount() const;
+
+	void SetSphere(size_t index, float x, float y, float z, float radius);
+	// Frustum planes are in view space, they are moved to world space once instead of moving every sphere to view.
+	void SetPlanes(const Frustum& frustum, const DirectX::XMFLOAT4X4& view);
+	// pJobSystem may be null, small sets are always culled on the calling thread.
+	void Cull(JobSystem* pJobSystem);
+
+	// Indices the culler does not know about count as visible.
+	bool IsVisible(size_t index) const;
+	// World space planes from the last SetPlanes, pointing into the frustum.
+	const std::array<DirectX::XMFLOAT4, 6>& GetPlanes() const;
+
+private:
+	void CullRange(size_t begin, size_t end);
+
+	size_t m_count = 0u;
+	// Padded to whole bitset words, so every lane of the last block reads valid memory.
+	std::vector<float> m_x;
+	std::vector<float> m_y;
+	std::vector<float> m_z;
+	std::vector<float> m_radius;
+	std::vector<uint64_t> m_visible;
+	std::array<DirectX::XMFLOAT4, 6> m_planes;
+};
\ No newline at end of file
@@ -13,7 +13,7 @@ class Intersection;
 typedef std::vector<Intersection> IntersectionArray;
 
 template <class T>
-void InitIntersection(Intersection& intersection, DWORD faceIndex, FLOAT dist, FLOAT u, FLOAT v, ActorId actorId, DWORD* pIndices, T* pVertices, DirectX::FXMMATRIX matWorld);
+void InitIntersection(Intersection& intersection, DWORD faceIndex, FLOAT dist, FLOAT u, FLOAT v, ActorId actorId, const DWORD* pIndices, const T* pVertices, DirectX::FXMMATRIX matWorld);
 
 class Intersection {
 public:
@@ -32,16 +32,16 @@ public:
 };
 
 template<class T>
-inline void InitIntersection(Intersection& intersection, DWORD faceIndex, FLOAT dist, FLOAT u, FLOAT v, ActorId actorId, DWORD* pIndices, T* pVertices, DirectX::FXMMATRIX matWorld) {
+inline void InitIntersection(Intersection& intersection, DWORD faceIndex, FLOAT dist, FLOAT u, FLOAT v, ActorId actorId, const DWORD* pIndices, const T* pVertices, DirectX::FXMMATRIX matWorld) {
 	using namespace DirectX;
 	intersection.m_dwFace = faceIndex;
 	intersection.m_fDist = dist;
 	intersection.m_fBary1 = u;
 	intersection.m_fBary2 = v;
 
-	T* v0 = &pVertices[pIndices[3 * faceIndex + 0]];
-	T* v1 = &pVertices[pIndices[3 * faceIndex + 1]];
-	T* v2 = &pVertices[pIndices[3 * faceIndex + 2]];
+	const T* v0 = &pVertices[pIndices[3 * faceIndex + 0]];
+	const T* v1 = &pVertices[pIndices[3 * faceIndex + 1]];
+	const T* v2 = &pVertices[pIndices[3 * faceIndex + 2]];
 
 	// If all you want is the vertices hit, then you are done. In this sample, we
 	// want to show how to infer texture coordinates as well, using the BaryCentric
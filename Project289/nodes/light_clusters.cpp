@@ -0,0 +1,227 @@
+#include "light_clusters.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <xmmintrin.h>
+
+namespace {
+	// Spot cones end where pow(cos, Spot) drops below this
+	constexpr float sk_SpotCutoff = 1.0f / 256.0f;
+
+	uint32_t ClampTile(float coordinate, uint32_t count) {
+		if (coordinate <= 0.0f) { return 0u; }
+		uint32_t tile = static_cast<uint32_t>(coordinate);
+		return tile < count ? tile : count - 1u;
+	}
+}
+
+LightClusters::LightClusters() {
+	m_ranges.assign(sk_ClusterCount, { 0u, 0u });
+}
+
+void LightClusters::SetProjection(float fov, float aspect, float nearClip, float farClip) {
+	if (fov == m_fov && aspect == m_aspect && nearClip == m_near && farClip == m_far) {
+		return;
+	}
+	m_fov = fov;
+	m_aspect = aspect;
+	m_near = nearClip;
+	m_far = farClip;
+	m_tanHalfY = std::tan(fov * 0.5f);
+	m_tanHalfX = m_tanHalfY * aspect;
+	m_sliceScale = sk_Slices / std::log(farClip / nearClip);
+
+	for (std::vector<float>* pArray : { &m_minX, &m_minY, &m_minZ, &m_maxX, &m_maxY, &m_maxZ, &m_centerX, &m_centerY, &m_centerZ, &m_radius }) {
+		pArray->resize(sk_ClusterCount);
+	}
+
+	// A tile is a frustum wedge, its box has to hold the tile rectangle at both ends of the slice
+	for (uint32_t slice = 0u; slice < sk_Slices; ++slice) {
+		float z0 = GetSliceDepth(slice);
+		float z1 = GetSliceDepth(slice + 1u);
+		for (uint32_t y = 0u; y < sk_TilesY; ++y) {
+			float top = 1.0f - 2.0f * y / sk_TilesY;
+			float bottom = 1.0f - 2.0f * (y + 1u) / sk_TilesY;
+			for (uint32_t x = 0u; x < sk_TilesX; ++x) {
+				float left = -1.0f + 2.0f * x / sk_TilesX;
+				float right = -1.0f + 2.0f * (x + 1u) / sk_TilesX;
+				uint32_t i = GetClusterIndex(x, y, slice);
+				m_minX[i] = std::min(left * z0, left * z1) * m_tanHalfX;
+				m_maxX[i] = std::max(right * z0, right * z1) * m_tanHalfX;
+				m_minY[i] = std::min(bottom * z0, bottom * z1) * m_tanHalfY;
+				m_maxY[i] = std::max(top * z0, top * z1) * m_tanHalfY;
+				m_minZ[i] = z0;
+				m_maxZ[i] = z1;
+
+				float ex = (m_maxX[i] - m_minX[i]) * 0.5f;
+				float ey = (m_maxY[i] - m_minY[i]) * 0.5f;
+				float ez = (z1 - z0) * 0.5f;
+				m_centerX[i] = m_minX[i] + ex;
+				m_centerY[i] = m_minY[i] + ey;
+				m_centerZ[i] = z0 + ez;
+				m_radius[i] = std::sqrt(ex * ex + ey * ey + ez * ez);
+			}
+		}
+	}
+}
+
+void LightClusters::Build(const std::vector<SpotLight>& lights, const DirectX::XMFLOAT4X4& view) {
+	m_lights = lights;
+	m_pairClusters.clear();
+	m_pairLights.clear();
+
+	DirectX::XMMATRIX viewMatrix = DirectX::XMLoadFloat4x4(&view);
+	for (size_t i = 0u; i < m_lights.size(); ++i) {
+		const SpotLight& light = m_lights[i];
+		DirectX::XMFLOAT3 center;
+		DirectX::XMStoreFloat3(&center, DirectX::XMVector3TransformCoord(DirectX::XMLoadFloat3(&light.Position), viewMatrix));
+
+		DirectX::XMFLOAT3 direction(0.0f, 0.0f, 1.0f);
+		float cosAngle = -1.0f;
+		float sinAngle = 0.0f;
+		if (light.Spot > 0.0f) {
+			DirectX::XMStoreFloat3(&direction, DirectX::XMVector3Normalize(DirectX::XMVector3TransformNormal(DirectX::XMLoadFloat3(&light.Direction), viewMatrix)));
+			cosAngle = std::pow(sk_SpotCutoff, 1.0f / light.Spot);
+			sinAngle = std::sqrt(1.0f - cosAngle * cosAngle);
+		}
+		BinLight(static_cast<uint32_t>(i), center, light.Range, direction, cosAngle, sinAngle);
+	}
+
+	// Counting sort of the pairs by cluster, lights stay in ascending order inside a cluster
+	for (ClusterRange& range : m_ranges) {
+		range.count = 0u;
+	}
+	for (uint32_t cluster : m_pairClusters) {
+		++m_ranges[cluster].count;
+	}
+	uint32_t offset = 0u;
+	for (ClusterRange& range : m_ranges) {
+		range.offset = offset;
+		offset += range.count;
+		range.count = 0u;
+	}
+	m_lightIndices.resize(m_pairClusters.size());
+	for (size_t i = 0u; i < m_pairClusters.size(); ++i) {
+		ClusterRange& range = m_ranges[m_pairClusters[i]];
+		m_lightIndices[range.offset + range.count++] = m_pairLights[i];
+	}
+}
+
+void LightClusters::BinLight(uint32_t light, const DirectX::XMFLOAT3& center, float radius, const DirectX::XMFLOAT3& direction, float cosAngle, float sinAngle) {
+	float zMin = std::max(center.z - radius, m_near);
+	float zMax = std::min(center.z + radius, m_far);
+	if (zMin > zMax) {
+		return;
+	}
+
+	// Screen extent of the sphere's box over its depth range, x / z is monotonic in both for positive z
+	float xa = center.x - radius;
+	float xb = center.x + radius;
+	float ya = center.y - radius;
+	float yb = center.y + radius;
+	float left = std::min(xa / zMin, xa / zMax) / m_tanHalfX;
+	float right = std::max(xb / zMin, xb / zMax) / m_tanHalfX;
+	float bottom = std::min(ya / zMin, ya / zMax) / m_tanHalfY;
+	float top = std::max(yb / zMin, yb / zMax) / m_tanHalfY;
+	if (left > 1.0f || right < -1.0f || bottom > 1.0f || top < -1.0f) {
+		return;
+	}
+
+	uint32_t x0 = ClampTile((left * 0.5f + 0.5f) * sk_TilesX, sk_TilesX);
+	uint32_t x1 = ClampTile((right * 0.5f + 0.5f) * sk_TilesX, sk_TilesX);
+	uint32_t y0 = ClampTile((0.5f - top * 0.5f) * sk_TilesY, sk_TilesY);
+	uint32_t y1 = ClampTile((0.5f - bottom * 0.5f) * sk_TilesY, sk_TilesY);
+	uint32_t s0 = GetSlice(zMin);
+	uint32_t s1 = GetSlice(zMax);
+
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 cx = _mm_set1_ps(center.x);
+	const __m128 cy = _mm_set1_ps(center.y);
+	const __m128 cz = _mm_set1_ps(center.z);
+	const __m128 radiusSq = _mm_set1_ps(radius * radius);
+	const __m128 range = _mm_set1_ps(radius);
+	const __m128 dx = _mm_set1_ps(direction.x);
+	const __m128 dy = _mm_set1_ps(direction.y);
+	const __m128 dz = _mm_set1_ps(direction.z);
+	const __m128 cosA = _mm_set1_ps(cosAngle);
+	const __m128 sinA = _mm_set1_ps(sinAngle);
+	const bool isSpot = cosAngle > -1.0f;
+
+	// Lanes of the first and last group that fall outside x0..x1
+	const int firstMask = 0xF & (0xF << (x0 & 3u));
+	const int lastMask = 0xF >> (3u - (x1 & 3u));
+
+	for (uint32_t slice = s0; slice <= s1; ++slice) {
+		for (uint32_t y = y0; y <= y1; ++y) {
+			uint32_t row = GetClusterIndex(0u, y, slice);
+			for (uint32_t x = x0 & ~3u; x <= x1; x += 4u) {
+				uint32_t i = row + x;
+				__m128 ex = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(&m_minX[i]), cx), _mm_sub_ps(cx, _mm_loadu_ps(&m_maxX[i]))), zero);
+				__m128 ey = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(&m_minY[i]), cy), _mm_sub_ps(cy, _mm_loadu_ps(&m_maxY[i]))), zero);
+				__m128 ez = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(&m_minZ[i]), cz), _mm_sub_ps(cz, _mm_loadu_ps(&m_maxZ[i]))), zero);
+				__m128 distanceSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ex, ex), _mm_mul_ps(ey, ey)), _mm_mul_ps(ez, ez));
+				__m128 hit = _mm_cmple_ps(distanceSq, radiusSq);
+
+				if (isSpot) {
+					// Cone against the cluster sphere: out when the sphere is past the cone's side, past its
+					// range or behind its apex
+					__m128 vx = _mm_sub_ps(_mm_loadu_ps(&m_centerX[i]), cx);
+					__m128 vy = _mm_sub_ps(_mm_loadu_ps(&m_centerY[i]), cy);
+					__m128 vz = _mm_sub_ps(_mm_loadu_ps(&m_centerZ[i]), cz);
+					__m128 clusterRadius = _mm_loadu_ps(&m_radius[i]);
+					__m128 lengthSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), _mm_mul_ps(vz, vz));
+					__m128 along = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, dx), _mm_mul_ps(vy, dy)), _mm_mul_ps(vz, dz));
+					__m128 across = _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(lengthSq, _mm_mul_ps(along, along)), zero));
+					__m128 closest = _mm_sub_ps(_mm_mul_ps(cosA, across), _mm_mul_ps(along, sinA));
+					hit = _mm_and_ps(hit, _mm_cmple_ps(closest, clusterRadius));
+					hit = _mm_and_ps(hit, _mm_cmple_ps(along, _mm_add_ps(clusterRadius, range)));
+					hit = _mm_and_ps(hit, _mm_cmpge_ps(along, _mm_sub_ps(zero, clusterRadius)));
+				}
+
+				int mask = _mm_movemask_ps(hit);
+				if (x == (x0 & ~3u)) { mask &= firstMask; }
+				if (x + 4u > x1) { mask &= lastMask; }
+				while (mask) {
+					int lane = 0;
+					while (!(mask & (1 << lane))) { ++lane; }
+					mask &= mask - 1;
+					m_pairClusters.push_back(i + static_cast<uint32_t>(lane));
+					m_pairLights.push_back(light);
+				}
+			}
+		}
+	}
+}
+
+uint32_t LightClusters::GetClusterIndex(uint32_t tileX, uint32_t tileY, uint32_t slice) {
+	return (slice * sk_TilesY + tileY) * sk_TilesX + tileX;
+}
+
+uint32_t LightClusters::GetSlice(float viewZ) const {
+	if (viewZ <= m_near) {
+		return 0u;
+	}
+	float slice = std::log(viewZ / m_near) * m_sliceScale;
+	return std::min(static_cast<uint32_t>(slice), sk_Slices - 1u);
+}
+
+float LightClusters::GetSliceDepth(uint32_t slice) const {
+	return m_near * std::pow(m_far / m_near, static_cast<float>(slice) / sk_Slices);
+}
+
+const std::vector<ClusterRange>& LightClusters::GetRanges() const {
+	return m_ranges;
+}
+
+const std::vector<uint32_t>& LightClusters::GetLightIndices() const {
+	return m_lightIndices;
+}
+
+const std::vector<SpotLight>& LightClusters::GetLights() const {
+	return m_lights;
+}
+
+size_t LightClusters::GetAssignmentCount() const {
+	return m_lightIndices.size();
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <DirectXMath.h>
+
+#include "../graphics/spot_light.h"
+
+struct ClusterRange {
+	uint32_t offset;
+	uint32_t count;
+};
+
+// Point and spot lights binned into a grid of view space clusters: screen tiles split into depth slices that grow
+// exponentially with distance. Each light is only tested against the clusters under its screen and depth extent,
+// four clusters at a time with SSE, sphere against cluster box and for spots also cone against cluster sphere.
+// The result is a range per cluster into one compact light index list. CPU side only for now: no shader reads the
+// lists and the renderer does not build them, -bench-lights measures the binning on its own.
+class LightClusters {
+public:
+	static constexpr uint32_t sk_TilesX = 16u;
+	static constexpr uint32_t sk_TilesY = 9u;
+	static constexpr uint32_t sk_Slices = 24u;
+	static constexpr uint32_t sk_ClusterCount = sk_TilesX * sk_TilesY * sk_Slices;
+
+	LightClusters();
+
+	// Vertical field of view as in Frustum, the cluster bounds are only rebuilt when something changed.
+	void SetProjection(float fov, float aspect, float nearClip, float farClip);
+	// Lights are in world space. A light with Spot above zero is a spot light, its cone ends where
+	// pow(cos, Spot) falls below 1/256, anything else lights the whole sphere of its range.
+	void Build(const std::vector<SpotLight>& lights, const DirectX::XMFLOAT4X4& view);
+
+	// Clusters are stored slice by slice, rows from the top of the screen.
+	static uint32_t GetClusterIndex(uint32_t tileX, uint32_t tileY, uint32_t slice);
+	// Slice holding a view space depth, clamped to the grid.
+	uint32_t GetSlice(float viewZ) const;
+
+	const std::vector<ClusterRange>& GetRanges() const;
+	const std::vector<uint32_t>& GetLightIndices() const;
+	// Lights of the last Build in the order the indices refer to.
+	const std::vector<SpotLight>& GetLights() const;
+	// Light and cluster pairs written by the last Build.
+	size_t GetAssignmentCount() const;
+
+private:
+	void BinLight(uint32_t light, const DirectX::XMFLOAT3& center, float radius, const DirectX::XMFLOAT3& direction, float cosAngle, float sinAngle);
+	float GetSliceDepth(uint32_t slice) const;
+
+	float m_fov = 0.0f;
+	float m_aspect = 0.0f;
+	float m_near = 0.0f;
+	float m_far = 0.0f;
+	float m_tanHalfX = 0.0f;
+	float m_tanHalfY = 0.0f;
+	float m_sliceScale = 0.0f;
+
+	// View space cluster boxes and bounding spheres, structure of arrays in cluster order
+	std::vector<float> m_minX;
+	std::vector<float> m_minY;
+	std::vector<float> m_minZ;
+	std::vector<float> m_maxX;
+	std::vector<float> m_maxY;
+	std::vector<float> m_maxZ;
+	std::vector<float> m_centerX;
+	std::vector<float> m_centerY;
+	std::vector<float> m_centerZ;
+	std::vector<float> m_radius;
+
+	std::vector<SpotLight> m_lights;
+	std::vector<uint32_t> m_pairClusters;
+	std::vector<uint32_t> m_pairLights;
+	std::vector<ClusterRange> m_ranges;
+	std::vector<uint32_t> m_lightIndices;
+};
\ No newline at end of file
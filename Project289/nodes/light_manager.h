@@ -8,7 +8,8 @@
 #include "light_node.h"
 #include "../graphics/constant_buffer_types.h"
 
-#define MAXIMUM_LIGHTS_SUPPORTED (3)
+// Directional lights go to the per object constant buffer, the shaders have no point or spot lighting yet.
+#define MAXIMUM_DIRECTIONAL_LIGHTS (3)
 
 class LightManager {
 	friend class Scene;
@@ -16,8 +17,6 @@ class LightManager {
 protected:
 	Lights m_Lights;
 	std::vector<DirectionalLight> gDirLights;
-	//PointLight gPointLights[3];
-	//SpotLight gSpotLights[3];
 	
 public:
 	void CalcLighting(Scene* pScene);
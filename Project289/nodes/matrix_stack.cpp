@@ -3,6 +3,7 @@
 MatrixStack::MatrixStack() {
 	DirectX::XMFLOAT4X4 identity;
 	DirectX::XMStoreFloat4x4(&identity, DirectX::XMMatrixIdentity());
+	m_MatrixStack.reserve(16u);
 	m_MatrixStack.push_back(identity);
 }
 
@@ -1,14 +1,14 @@
 #pragma once
 
-#include <deque>
 #include <iostream>
+#include <vector>
 
 #include <DirectXMath.h>
 
 #include "../tools/string_utility.h"
 
 class MatrixStack {
-	std::deque<DirectX::XMFLOAT4X4> m_MatrixStack;
+	std::vector<DirectX::XMFLOAT4X4> m_MatrixStack;
 
 public:
 	MatrixStack();
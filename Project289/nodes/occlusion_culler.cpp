@@ -0,0 +1,328 @@
+#include "occlusion_culler.h"
+#include "../tools/job_system.h"
+#include "../tools/game_timer.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include <xmmintrin.h>
+
+namespace {
+	float ElapsedMs(gameTimePoint from, gameTimePoint to) {
+		return std::chrono::duration<float, std::milli>(to - from).count();
+	}
+
+	// Pixel rows or columns whose centers lie in [minCoord, maxCoord], clamped to the buffer.
+	void GetPixelSpan(float minCoord, float maxCoord, int size, int& first, int& last) {
+		first = static_cast<int>(std::ceil(std::min(std::max(minCoord - 0.5f, -1.0f), static_cast<float>(size))));
+		last = static_cast<int>(std::floor(std::min(std::max(maxCoord - 0.5f, -1.0f), static_cast<float>(size))));
+		first = std::max(first, 0);
+		last = std::min(last, size - 1);
+	}
+}
+
+OcclusionCuller::OcclusionCuller() : m_depth(sk_Width * sk_Height, 1.0f), m_tileDepth(sk_TilesX * sk_TilesY, 1.0f) {
+	DirectX::XMStoreFloat4x4(&m_viewProjection, DirectX::XMMatrixIdentity());
+}
+
+void OcclusionCuller::SetViewProjection(const DirectX::XMFLOAT4X4& viewProjection) {
+	m_viewProjection = viewProjection;
+}
+
+void OcclusionCuller::Rasterize(const std::vector<OccluderMesh>& occluders, JobSystem* pJobSystem) {
+	gameTimePoint start = gameClock::now();
+
+	// Every occluder gets its own range of vertices and triangles, so the setup jobs share nothing
+	size_t count = occluders.size();
+	m_vertexOffsets.resize(count);
+	m_triangleOffsets.resize(count);
+	m_triangleCounts.assign(count, 0u);
+	size_t vertexCount = 0u;
+	size_t triangleCount = 0u;
+	for (size_t i = 0u; i < count; ++i) {
+		m_vertexOffsets[i] = vertexCount;
+		m_triangleOffsets[i] = triangleCount;
+		vertexCount += occluders[i].vertexCount;
+		triangleCount += occluders[i].indexCount / 3u;
+	}
+	m_screenVertices.resize(vertexCount);
+	m_triangles.resize(triangleCount);
+
+	auto setupRange = [this, &occluders](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			m_triangleCounts[i] = SetupOccluder(occluders[i], m_screenVertices.data() + m_vertexOffsets[i], m_triangles.data() + m_triangleOffsets[i]);
+		}
+	};
+	auto bandRange = [this](size_t begin, size_t end) {
+		for (size_t band = begin; band < end; ++band) {
+			RasterizeBand(static_cast<int>(band));
+		}
+	};
+	if (pJobSystem) {
+		pJobSystem->ParallelFor(count, 1u, setupRange);
+		pJobSystem->ParallelFor(sk_BandCount, 1u, bandRange);
+	}
+	else {
+		setupRange(0u, count);
+		bandRange(0u, sk_BandCount);
+	}
+
+	m_stats.occluders = static_cast<uint32_t>(count);
+	m_stats.triangles = 0u;
+	for (uint32_t occluderTriangles : m_triangleCounts) {
+		m_stats.triangles += occluderTriangles;
+	}
+	m_stats.rasterizeMs = ElapsedMs(start, gameClock::now());
+}
+
+bool OcclusionCuller::IsOccluded(const Aabb& box) const {
+	DirectX::XMMATRIX viewProjection = DirectX::XMLoadFloat4x4(&m_viewProjection);
+	float minX = FLT_MAX;
+	float minY = FLT_MAX;
+	float maxX = -FLT_MAX;
+	float maxY = -FLT_MAX;
+	float minZ = FLT_MAX;
+	for (int corner = 0; corner < 8; ++corner) {
+		DirectX::XMVECTOR position = DirectX::XMVectorSet(
+			(corner & 1) ? box.m_Max.x : box.m_Min.x,
+			(corner & 2) ? box.m_Max.y : box.m_Min.y,
+			(corner & 4) ? box.m_Max.z : box.m_Min.z,
+			1.0f
+		);
+		DirectX::XMFLOAT4 clip;
+		DirectX::XMStoreFloat4(&clip, DirectX::XMVector4Transform(position, viewProjection));
+		// In front of the near plane the projection flips, a box that close is never hidden
+		if (clip.z < 0.0f) {
+			return false;
+		}
+		float invW = 1.0f / clip.w;
+		float x = (clip.x * invW * 0.5f + 0.5f) * sk_Width;
+		float y = (0.5f - clip.y * invW * 0.5f) * sk_Height;
+		minX = std::min(minX, x);
+		maxX = std::max(maxX, x);
+		minY = std::min(minY, y);
+		maxY = std::max(maxY, y);
+		minZ = std::min(minZ, clip.z * invW);
+	}
+	if (maxX < 0.0f || maxY < 0.0f || minX > sk_Width || minY > sk_Height) {
+		return false;
+	}
+
+	// Every pixel the rectangle touches, not only the ones whose center it covers
+	int x0 = static_cast<int>(std::max(minX, 0.0f));
+	int y0 = static_cast<int>(std::max(minY, 0.0f));
+	int x1 = std::min(static_cast<int>(std::min(maxX, static_cast<float>(sk_Width))), sk_Width - 1);
+	int y1 = std::min(static_cast<int>(std::min(maxY, static_cast<float>(sk_Height))), sk_Height - 1);
+	if (x0 > x1 || y0 > y1) {
+		return false;
+	}
+
+	const __m128 boxZ = _mm_set1_ps(minZ);
+	const __m128 laneOffsets = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+	const __m128 spanMin = _mm_set1_ps(static_cast<float>(x0));
+	const __m128 spanMax = _mm_set1_ps(static_cast<float>(x1));
+	for (int tileY = y0 / sk_TileSize; tileY <= y1 / sk_TileSize; ++tileY) {
+		for (int tileX = x0 / sk_TileSize; tileX <= x1 / sk_TileSize; ++tileX) {
+			// The whole tile is nearer than the box
+			if (m_tileDepth[tileY * sk_TilesX + tileX] < minZ) {
+				continue;
+			}
+			int rowBegin = std::max(y0, tileY * sk_TileSize);
+			int rowEnd = std::min(y1, tileY * sk_TileSize + sk_TileSize - 1);
+			for (int y = rowBegin; y <= rowEnd; ++y) {
+				const float* pRow = &m_depth[y * sk_Width + tileX * sk_TileSize];
+				for (int group = 0; group < sk_TileSize; group += 4) {
+					__m128 laneX = _mm_add_ps(_mm_set1_ps(static_cast<float>(tileX * sk_TileSize + group)), laneOffsets);
+					__m128 inSpan = _mm_and_ps(_mm_cmpge_ps(laneX, spanMin), _mm_cmple_ps(laneX, spanMax));
+					__m128 farther = _mm_cmpge_ps(_mm_loadu_ps(pRow + group), boxZ);
+					if (_mm_movemask_ps(_mm_and_ps(inSpan, farther))) {
+						return false;
+					}
+				}
+			}
+		}
+	}
+	return true;
+}
+
+void OcclusionCuller::TestBoxes(const std::vector<Aabb>& boxes, std::vector<uint8_t>& occluded, JobSystem* pJobSystem) {
+	gameTimePoint start = gameClock::now();
+
+	occluded.resize(boxes.size());
+	auto testRange = [this, &boxes, &occluded](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			occluded[i] = IsOccluded(boxes[i]) ? 1u : 0u;
+		}
+	};
+	if (pJobSystem) {
+		pJobSystem->ParallelFor(boxes.size(), sk_TestBatchSize, testRange);
+	}
+	else {
+		testRange(0u, boxes.size());
+	}
+
+	m_stats.tested = static_cast<uint32_t>(boxes.size());
+	m_stats.occluded = 0u;
+	for (uint8_t hidden : occluded) {
+		m_stats.occluded += hidden;
+	}
+	m_stats.testMs = ElapsedMs(start, gameClock::now());
+}
+
+const OcclusionStats& OcclusionCuller::GetStats() const {
+	return m_stats;
+}
+
+void OcclusionCuller::ClearStats() {
+	m_stats = OcclusionStats();
+}
+
+const std::vector<float>& OcclusionCuller::GetDepth() const {
+	return m_depth;
+}
+
+float OcclusionCuller::GetTileDepth(int tileX, int tileY) const {
+	return m_tileDepth[tileY * sk_TilesX + tileX];
+}
+
+uint32_t OcclusionCuller::SetupOccluder(const OccluderMesh& occluder, DirectX::XMFLOAT4* pScreen, Triangle* pTriangles) const {
+	DirectX::XMMATRIX worldViewProjection = DirectX::XMMatrixMultiply(DirectX::XMLoadFloat4x4(&occluder.world), DirectX::XMLoadFloat4x4(&m_viewProjection));
+	for (size_t i = 0u; i < occluder.vertexCount; ++i) {
+		DirectX::XMFLOAT4 clip;
+		DirectX::XMStoreFloat4(&clip, DirectX::XMVector3Transform(DirectX::XMLoadFloat3(&occluder.pVertices[i].pos), worldViewProjection));
+		if (clip.z < 0.0f) {
+			pScreen[i] = DirectX::XMFLOAT4(0.0f, 0.0f, 0.0f, -1.0f);
+			continue;
+		}
+		float invW = 1.0f / clip.w;
+		pScreen[i] = DirectX::XMFLOAT4((clip.x * invW * 0.5f + 0.5f) * sk_Width, (0.5f - clip.y * invW * 0.5f) * sk_Height, clip.z * invW, clip.w);
+	}
+
+	uint32_t drawn = 0u;
+	size_t triangleCount = occluder.indexCount / 3u;
+	for (size_t t = 0u; t < triangleCount; ++t) {
+		Triangle& tri = pTriangles[t];
+		tri.minX = 0;
+		tri.maxX = -1;
+		// The geometry is borrowed from the caller, a triangle with an index past the vertices is left out
+		DWORD i0 = occluder.pIndices[t * 3u];
+		DWORD i1 = occluder.pIndices[t * 3u + 1u];
+		DWORD i2 = occluder.pIndices[t * 3u + 2u];
+		if (i0 >= occluder.vertexCount || i1 >= occluder.vertexCount || i2 >= occluder.vertexCount) {
+			continue;
+		}
+		const DirectX::XMFLOAT4& v0 = pScreen[i0];
+		const DirectX::XMFLOAT4& v1 = pScreen[i1];
+		const DirectX::XMFLOAT4& v2 = pScreen[i2];
+		// Clipping would only add coverage near the camera, leaving the triangle out keeps the test conservative
+		if (v0.w < 0.0f || v1.w < 0.0f || v2.w < 0.0f) {
+			continue;
+		}
+
+		float det = (v1.x - v0.x) * (v2.y - v0.y) - (v2.x - v0.x) * (v1.y - v0.y);
+		if (std::fabs(det) < 1e-6f) {
+			continue;
+		}
+		GetPixelSpan(std::min(std::min(v0.x, v1.x), v2.x), std::max(std::max(v0.x, v1.x), v2.x), sk_Width, tri.minX, tri.maxX);
+		GetPixelSpan(std::min(std::min(v0.y, v1.y), v2.y), std::max(std::max(v0.y, v1.y), v2.y), sk_Height, tri.minY, tri.maxY);
+		if (tri.minX > tri.maxX || tri.minY > tri.maxY) {
+			tri.minX = 0;
+			tri.maxX = -1;
+			continue;
+		}
+
+		// Both windings are drawn, flipping the edges of a negative area keeps the inside positive
+		const DirectX::XMFLOAT4* edges[3][2] = { { &v0, &v1 }, { &v1, &v2 }, { &v2, &v0 } };
+		float sign = det > 0.0f ? 1.0f : -1.0f;
+		for (int e = 0; e < 3; ++e) {
+			const DirectX::XMFLOAT4& a = *edges[e][0];
+			const DirectX::XMFLOAT4& b = *edges[e][1];
+			tri.edgeA[e] = (a.y - b.y) * sign;
+			tri.edgeB[e] = (b.x - a.x) * sign;
+			tri.edgeC[e] = (a.x * b.y - a.y * b.x) * sign;
+		}
+
+		// z / w is linear in screen space, so depth is a plane over the triangle
+		float invDet = 1.0f / det;
+		tri.zdx = ((v1.z - v0.z) * (v2.y - v0.y) - (v2.z - v0.z) * (v1.y - v0.y)) * invDet;
+		tri.zdy = ((v2.z - v0.z) * (v1.x - v0.x) - (v1.z - v0.z) * (v2.x - v0.x)) * invDet;
+		tri.zOrigin = v0.z - tri.zdx * v0.x - tri.zdy * v0.y;
+		tri.zMin = std::min(std::min(v0.z, v1.z), v2.z);
+		++drawn;
+	}
+	return drawn;
+}
+
+void OcclusionCuller::RasterizeBand(int band) {
+	int bandMinY = band * sk_BandHeight;
+	int bandMaxY = bandMinY + sk_BandHeight - 1;
+	std::fill(m_depth.begin() + bandMinY * sk_Width, m_depth.begin() + (bandMaxY + 1) * sk_Width, 1.0f);
+
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 four = _mm_set1_ps(4.0f);
+	const __m128 laneOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+	for (const Triangle& tri : m_triangles) {
+		if (tri.minX > tri.maxX || tri.maxY < bandMinY || tri.minY > bandMaxY) {
+			continue;
+		}
+
+		// Rows of four pixels from an aligned column, lanes outside the bounds are masked off
+		int firstX = tri.minX & ~3;
+		int firstY = std::max(tri.minY, bandMinY);
+		int lastY = std::min(tri.maxY, bandMaxY);
+		__m128 edgeA[3];
+		__m128 edgeStep[3];
+		for (int e = 0; e < 3; ++e) {
+			edgeA[e] = _mm_set1_ps(tri.edgeA[e]);
+			edgeStep[e] = _mm_set1_ps(tri.edgeA[e] * 4.0f);
+		}
+		const __m128 zdx = _mm_set1_ps(tri.zdx);
+		const __m128 zStep = _mm_set1_ps(tri.zdx * 4.0f);
+		const __m128 zMin = _mm_set1_ps(tri.zMin);
+		const __m128 spanMin = _mm_set1_ps(static_cast<float>(tri.minX));
+		const __m128 spanMax = _mm_set1_ps(static_cast<float>(tri.maxX + 1));
+		const __m128 rowX = _mm_add_ps(_mm_set1_ps(static_cast<float>(firstX)), laneOffsets);
+
+		for (int y = firstY; y <= lastY; ++y) {
+			float centerY = y + 0.5f;
+			__m128 x = rowX;
+			__m128 e0 = _mm_add_ps(_mm_mul_ps(edgeA[0], x), _mm_set1_ps(tri.edgeB[0] * centerY + tri.edgeC[0]));
+			__m128 e1 = _mm_add_ps(_mm_mul_ps(edgeA[1], x), _mm_set1_ps(tri.edgeB[1] * centerY + tri.edgeC[1]));
+			__m128 e2 = _mm_add_ps(_mm_mul_ps(edgeA[2], x), _mm_set1_ps(tri.edgeB[2] * centerY + tri.edgeC[2]));
+			__m128 z = _mm_add_ps(_mm_mul_ps(zdx, x), _mm_set1_ps(tri.zdy * centerY + tri.zOrigin));
+			float* pRow = &m_depth[y * sk_Width];
+			for (int column = firstX; column <= tri.maxX; column += 4) {
+				__m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)), _mm_cmpge_ps(e2, zero));
+				inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmpgt_ps(x, spanMin), _mm_cmplt_ps(x, spanMax)));
+				if (_mm_movemask_ps(inside)) {
+					// Never nearer than the nearest vertex, rounding at the edges cannot pull a pixel forward
+					__m128 old = _mm_loadu_ps(pRow + column);
+					__m128 depth = _mm_min_ps(old, _mm_max_ps(z, zMin));
+					_mm_storeu_ps(pRow + column, _mm_or_ps(_mm_and_ps(inside, depth), _mm_andnot_ps(inside, old)));
+				}
+				e0 = _mm_add_ps(e0, edgeStep[0]);
+				e1 = _mm_add_ps(e1, edgeStep[1]);
+				e2 = _mm_add_ps(e2, edgeStep[2]);
+				z = _mm_add_ps(z, zStep);
+				x = _mm_add_ps(x, four);
+			}
+		}
+	}
+
+	// Farthest depth of each tile in the band
+	for (int tileY = bandMinY / sk_TileSize; tileY <= bandMaxY / sk_TileSize; ++tileY) {
+		for (int tileX = 0; tileX < sk_TilesX; ++tileX) {
+			__m128 farthest = zero;
+			for (int y = 0; y < sk_TileSize; ++y) {
+				const float* pRow = &m_depth[(tileY * sk_TileSize + y) * sk_Width + tileX * sk_TileSize];
+				for (int group = 0; group < sk_TileSize; group += 4) {
+					farthest = _mm_max_ps(farthest, _mm_loadu_ps(pRow + group));
+				}
+			}
+			farthest = _mm_max_ps(farthest, _mm_shuffle_ps(farthest, farthest, _MM_SHUFFLE(1, 0, 3, 2)));
+			farthest = _mm_max_ps(farthest, _mm_shuffle_ps(farthest, farthest, _MM_SHUFFLE(2, 3, 0, 1)));
+			m_tileDepth[tileY * sk_TilesX + tileX] = _mm_cvtss_f32(farthest);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <DirectXMath.h>
+
+#include "spatial_index.h"
+#include "../tools/platform_types.h"
+#include "../graphics/vertex.h"
+
+class JobSystem;
+
+// Triangle list an occluder is drawn with, borrowed for one Rasterize. Any closed mesh works, a simplified stand in
+// with a few triangles costs the least.
+struct OccluderMesh {
+	const Vertex* pVertices;
+	size_t vertexCount;
+	const DWORD* pIndices;
+	size_t indexCount;
+	DirectX::XMFLOAT4X4 world;
+};
+
+// Counts and CPU time of the last Rasterize and TestBoxes.
+struct OcclusionStats {
+	uint32_t occluders = 0u;
+	uint32_t triangles = 0u;
+	uint32_t tested = 0u;
+	uint32_t occluded = 0u;
+	float rasterizeMs = 0.0f;
+	float testMs = 0.0f;
+};
+
+// Low resolution software depth buffer for occlusion culling. Occluders are transformed and their triangles set up
+// in parallel, one job per occluder, then rasterized four pixels at a time with SSE in horizontal bands, one job per
+// band. Each band also reduces its 8x8 tiles to the farthest depth they hold. A box is tested against those tiles
+// first and against single pixels only in the tiles that do not decide it. Depth is z / w of the projection, 0 at
+// the near plane. Triangles crossing the near plane are left out, which can only let more through.
+class OcclusionCuller {
+public:
+	static constexpr int sk_Width = 256;
+	static constexpr int sk_Height = 128;
+	static constexpr int sk_TileSize = 8;
+	static constexpr int sk_TilesX = sk_Width / sk_TileSize;
+	static constexpr int sk_TilesY = sk_Height / sk_TileSize;
+	static constexpr int sk_BandHeight = 16;
+	static constexpr int sk_BandCount = sk_Height / sk_BandHeight;
+	static constexpr size_t sk_TestBatchSize = 64u;
+
+	OcclusionCuller();
+
+	void SetViewProjection(const DirectX::XMFLOAT4X4& viewProjection);
+	// Clears the depth buffer and draws the occluders into it. pJobSystem may be null.
+	void Rasterize(const std::vector<OccluderMesh>& occluders, JobSystem* pJobSystem);
+	// True when every on-screen pixel under the box's screen rectangle holds something nearer than the box's nearest
+	// point. A box crossing the near plane counts as visible, as does one entirely off the screen; a box partly off
+	// the screen is tested on the part that is on it.
+	bool IsOccluded(const Aabb& box) const;
+	// occluded gets one entry per box, 1 for the occluded ones.
+	void TestBoxes(const std::vector<Aabb>& boxes, std::vector<uint8_t>& occluded, JobSystem* pJobSystem);
+
+	const OcclusionStats& GetStats() const;
+	// For frames that skip occlusion culling, so the stats do not describe an older frame.
+	void ClearStats();
+	// sk_Width * sk_Height depths, rows from the top of the screen.
+	const std::vector<float>& GetDepth() const;
+	// Farthest depth of a tile, tiles from the top left.
+	float GetTileDepth(int tileX, int tileY) const;
+
+private:
+	// Edge functions are positive inside, z = zOrigin + zdx * x + zdy * y at a pixel center x, y.
+	struct Triangle {
+		float edgeA[3];
+		float edgeB[3];
+		float edgeC[3];
+		float zOrigin;
+		float zdx;
+		float zdy;
+		float zMin;
+		// Inclusive pixel bounds, empty when minX > maxX.
+		int minX;
+		int maxX;
+		int minY;
+		int maxY;
+	};
+
+	// Returns how many of the occluder's triangles can cover a pixel.
+	uint32_t SetupOccluder(const OccluderMesh& occluder, DirectX::XMFLOAT4* pScreen, Triangle* pTriangles) const;
+	void RasterizeBand(int band);
+
+	DirectX::XMFLOAT4X4 m_viewProjection;
+	std::vector<float> m_depth;
+	std::vector<float> m_tileDepth;
+	// Screen x, y, depth and a negative w for vertices in front of the near plane.
+	std::vector<DirectX::XMFLOAT4> m_screenVertices;
+	std::vector<size_t> m_vertexOffsets;
+	std::vector<Triangle> m_triangles;
+	std::vector<size_t> m_triangleOffsets;
+	std::vector<uint32_t> m_triangleCounts;
+	OcclusionStats m_stats;
+};
\ No newline at end of file
@@ -4,6 +4,10 @@ void Plane::Normalize() {
 	DirectX::XMStoreFloat4(&m_coefficients, DirectX::XMPlaneNormalize(DirectX::XMLoadFloat4(&m_coefficients)));
 }
 
+const DirectX::XMFLOAT4& Plane::GetCoefficients() const {
+	return m_coefficients;
+}
+
 void Plane::Init(const DirectX::XMFLOAT3& p0, const DirectX::XMFLOAT3& p1, const DirectX::XMFLOAT3& p2) {
 	DirectX::XMStoreFloat4(&m_coefficients, DirectX::XMPlaneFromPoints(DirectX::XMLoadFloat3(&p0), DirectX::XMLoadFloat3(&p1), DirectX::XMLoadFloat3(&p2)));
 }
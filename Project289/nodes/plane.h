@@ -8,6 +8,7 @@ private:
 
 public:
 	void Normalize();
+	const DirectX::XMFLOAT4& GetCoefficients() const;
 
 	void Init(const DirectX::XMFLOAT3& p0, const DirectX::XMFLOAT3& p1, const DirectX::XMFLOAT3& p2);
 	void Init(DirectX::FXMVECTOR p0, DirectX::FXMVECTOR p1, DirectX::FXMVECTOR p2);
@@ -1,5 +1,7 @@
 #include "ray_cast.h"
 
+#include <cfloat>
+
 RayCast::RayCast(Point point, DWORD maxIntersections) {
 	m_MaxIntersections = maxIntersections;
 	m_IntersectionArray.reserve(m_MaxIntersections);
@@ -9,6 +11,42 @@ RayCast::RayCast(Point point, DWORD maxIntersections) {
 	m_Point = point;
 }
 
+HRESULT RayCast::Pick(ActorId actorId, const MeshBvh& bvh, const Vertex* pVertices, const DWORD* pIndices, const DirectX::XMFLOAT4X4& world, const DirectX::XMFLOAT4X4& invWorld) {
+	if (m_NumIntersections >= m_MaxIntersections) {
+		return S_OK;
+	}
+
+	// The direction is not normalized after the move to mesh space, so hit distances stay in world units
+	DirectX::XMMATRIX toLocal = DirectX::XMLoadFloat4x4(&invWorld);
+	BvhRay ray;
+	DirectX::XMStoreFloat3(&ray.origin, DirectX::XMVector3TransformCoord(DirectX::XMLoadFloat3(&m_vPickRayOrig), toLocal));
+	DirectX::XMStoreFloat3(&ray.direction, DirectX::XMVector3TransformNormal(DirectX::XMLoadFloat3(&m_vPickRayDir), toLocal));
+	ray.maxDistance = FLT_MAX;
+
+	m_Hits.clear();
+	if (m_bAllHits) {
+		bvh.IntersectAll(ray, m_Hits);
+	}
+	else {
+		BvhHit hit;
+		if (bvh.IntersectClosest(ray, hit)) {
+			m_Hits.push_back(hit);
+		}
+	}
+
+	DirectX::XMMATRIX matWorld = DirectX::XMLoadFloat4x4(&world);
+	for (const BvhHit& hit : m_Hits) {
+		if (m_NumIntersections >= m_MaxIntersections) {
+			break;
+		}
+		Intersection intersection;
+		InitIntersection(intersection, hit.triangle, hit.distance, hit.u, hit.v, actorId, pIndices, pVertices, matWorld);
+		m_IntersectionArray.push_back(intersection);
+		++m_NumIntersections;
+	}
+	return S_OK;
+}
+
 void RayCast::Sort() {
 	std::sort(m_IntersectionArray.begin(), m_IntersectionArray.end());
 }
\ No newline at end of file
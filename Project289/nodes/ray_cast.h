@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <vector>
 
 #include <DirectXMath.h>
 
@@ -8,6 +9,7 @@
 #include "../graphics/vertex.h"
 #include "../graphics/vertex_buffer.h"
 #include "../graphics/index_buffer.h"
+#include "../graphics/mesh_bvh.h"
 #include "intersection.h"
 
 class Scene;
@@ -15,6 +17,7 @@ class Scene;
 class RayCast {
 protected:
 	VertexBuffer<Vertex>* m_pVB;
+	std::vector<BvhHit> m_Hits;
 
 public:
 	RayCast(Point point, DWORD maxIntersections = 16);
@@ -30,8 +33,9 @@ public:
 
 	IntersectionArray m_IntersectionArray;
 
-	HRESULT Pick(Scene* pScene, ActorId actorId, VertexBuffer<Vertex>* pVerts, IndexBuffer* pIndices, DWORD numPolys);
-	HRESULT Pick(Scene* pScene, ActorId actorId, VertexBuffer<Vertex>* pVerts, DWORD numPolys);
+	// Casts the world space pick ray against one mesh part through its BVH, world being the part's world transform.
+	// Adds every hit when m_bAllHits is set and only the nearest otherwise, distances are along m_vPickRayDir.
+	HRESULT Pick(ActorId actorId, const MeshBvh& bvh, const Vertex* pVertices, const DWORD* pIndices, const DirectX::XMFLOAT4X4& world, const DirectX::XMFLOAT4X4& invWorld);
 
 	void Sort();
 };
\ No newline at end of file
@@ -0,0 +1,35 @@
+#include "recording_mesh.h"
+#include "../bindable/null_bindable.h"
+#include "../actors/mesh_render_component.h"
+
+RecordingMesh::RecordingMesh(int mesh_id, BaseRenderComponent* renderComponent, DirectX::FXMMATRIX to, DirectX::CXMMATRIX from, bool calculate_from) : D3D11Mesh(mesh_id, to, from, calculate_from) {
+	MeshRenderComponent* mrc = static_cast<MeshRenderComponent*>(renderComponent);
+	m_index_count = static_cast<UINT>(mrc->GetMesh(mesh_id).GetIndexCount());
+
+	// D3D11Mesh creates its buffers, shaders, texture view and input layout per mesh
+	AddBind(BindableType::vertex_buffer_bindable, std::make_unique<NullBindable>());
+	AddBind(BindableType::index_buffer, std::make_unique<NullBindable>());
+	AddBind(BindableType::vertex_shader, std::make_unique<NullBindable>());
+	AddBind(BindableType::pixel_shader, std::make_unique<NullBindable>());
+	AddBind(BindableType::shader_resource, std::make_unique<NullBindable>());
+	AddBind(BindableType::input_layout, std::make_unique<NullBindable>());
+	AddBind(BindableType::vertex_constant_buffer, std::make_unique<NullBindable>());
+	AddBind(BindableType::pixel_constant_buffer, std::make_unique<NullBindable>());
+	if (!mrc->GetInstancedVertexShaderResource().empty()) {
+		SetInstancedVertexShader(std::make_unique<NullBindable>(), mrc->GetInstanceKey(mesh_id));
+	}
+	SetOccluderGeometry(mrc);
+
+	// The device returns one object per state description and topology is identified by its value
+	AddBind(BindableType::topology, std::make_unique<NullBindable>(static_cast<uint64_t>(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST)));
+	AddBind(BindableType::sampler_state, std::make_unique<NullBindable>(static_cast<uint64_t>(BindableType::sampler_state) + 1u));
+	AddBind(BindableType::depth_stencil_state, std::make_unique<NullBindable>(static_cast<uint64_t>(BindableType::depth_stencil_state) + 1u));
+	AddBind(BindableType::rasterizer_state, std::make_unique<NullBindable>(static_cast<uint64_t>(BindableType::rasterizer_state) + 1u));
+	AddBind(BindableType::blend_state, std::make_unique<NullBindable>(static_cast<uint64_t>(BindableType::blend_state) + 1u));
+}
+
+RecordingMesh::~RecordingMesh() {}
+
+UINT RecordingMesh::VGetIndexCount() const {
+	return m_index_count;
+}
\ No newline at end of file
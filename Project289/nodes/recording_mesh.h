@@ -0,0 +1,16 @@
+#pragma once
+
+#include "d3d_11_mesh.h"
+
+// Mesh for the headless renderer. Builds the same bind slots as D3D11Mesh out of NullBindables and goes through the
+// same constant buffer updates and queue submission, so the recorded command stream matches a D3D11 frame.
+class RecordingMesh : public D3D11Mesh {
+	UINT m_index_count;
+
+public:
+	RecordingMesh(int mesh_id, BaseRenderComponent* renderComponent, DirectX::FXMMATRIX to, DirectX::CXMMATRIX from, bool calulate_from = false);
+	virtual ~RecordingMesh();
+
+protected:
+	virtual UINT VGetIndexCount() const override;
+};
\ No newline at end of file
@@ -0,0 +1,155 @@
+#include "render_queue.h"
+#include "scene_node.h"
+
+#include <cstring>
+#include <utility>
+
+RenderStateCache::RenderStateCache() {
+	Reset();
+}
+
+void RenderStateCache::Reset() {
+	// Zero never matches a live state id, so the first draw after a reset binds everything
+	m_Bound.fill(0u);
+}
+
+bool RenderStateCache::NeedsBind(BindableType type, uint64_t stateId) {
+	uint64_t& bound = m_Bound[static_cast<size_t>(type)];
+	if (bound == stateId) {
+		return false;
+	}
+	bound = stateId;
+	return true;
+}
+
+uint64_t RenderQueue::MakeSortKey(RenderPass pass, uint32_t shaderId, uint32_t materialId, float depth) {
+	float clamped = depth < 0.0f ? 0.0f : (depth > 1.0f ? 1.0f : depth);
+	uint64_t depthBits = static_cast<uint64_t>(clamped * 16777215.0f);
+	return (static_cast<uint64_t>(pass) & 0xFu) << 60u
+		| (static_cast<uint64_t>(shaderId) & 0xFFFFFu) << 40u
+		| (static_cast<uint64_t>(materialId) & 0xFFFFu) << 24u
+		| depthBits;
+}
+
+uint32_t RenderQueue::HashStateIds(uint64_t first, uint64_t second) {
+	// 64 bit finalizer mix, the key only keeps the low bits so they have to depend on the whole pointer
+	uint64_t h = first ^ (second * 0x9E3779B97F4A7C15ull);
+	h ^= h >> 33u;
+	h *= 0xFF51AFD7ED558CCDull;
+	h ^= h >> 33u;
+	h *= 0xC4CEB9FE1A85EC53ull;
+	h ^= h >> 33u;
+	return static_cast<uint32_t>(h);
+}
+
+uint64_t RenderQueue::MakeBackToFrontKey(float viewDepth) {
+	// Flipping the sign bit of positives and every bit of negatives makes the float bits order like the values,
+	// inverting the result puts the largest depth first. Only the low four bytes are used, so sorting skips the rest
+	uint32_t bits;
+	std::memcpy(&bits, &viewDepth, sizeof(bits));
+	bits ^= (bits & 0x80000000u) ? 0xFFFFFFFFu : 0x80000000u;
+	return static_cast<uint64_t>(~bits);
+}
+
+void RenderQueue::Push(uint64_t sortKey, SceneNode* pNode) {
+	m_Packets.push_back({ sortKey, pNode, 0u, 0u });
+}
+
+void RenderQueue::PushInstance(uint64_t sortKey, SceneNode* pNode, uint64_t instanceKey, const InstanceData& instance) {
+	m_Packets.push_back({ sortKey, pNode, instanceKey, static_cast<uint32_t>(m_InstanceSource.size()) });
+	m_InstanceSource.push_back(instance);
+}
+
+void RenderQueue::Sort() {
+	size_t count = m_Packets.size();
+	if (count < 2u) {
+		return;
+	}
+
+	// LSD radix sort a byte at a time, all eight histograms come from a single read of the keys
+	uint32_t histograms[8][256] = {};
+	for (const DrawPacket& packet : m_Packets) {
+		for (unsigned byte = 0u; byte < 8u; ++byte) {
+			++histograms[byte][(packet.m_SortKey >> (byte * 8u)) & 0xFFu];
+		}
+	}
+
+	m_Scratch.resize(count);
+	DrawPacket* pSrc = m_Packets.data();
+	DrawPacket* pDst = m_Scratch.data();
+	for (unsigned byte = 0u; byte < 8u; ++byte) {
+		uint32_t (&histogram)[256] = histograms[byte];
+		unsigned shift = byte * 8u;
+		// Bytes shared by every key (unused shader bits, a single pass) would only copy the array
+		if (histogram[(pSrc[0].m_SortKey >> shift) & 0xFFu] == count) {
+			continue;
+		}
+
+		uint32_t offset = 0u;
+		for (uint32_t& bucket : histogram) {
+			uint32_t bucketCount = bucket;
+			bucket = offset;
+			offset += bucketCount;
+		}
+		for (size_t i = 0u; i < count; ++i) {
+			pDst[histogram[(pSrc[i].m_SortKey >> shift) & 0xFFu]++] = pSrc[i];
+		}
+		std::swap(pSrc, pDst);
+	}
+
+	if (pSrc != m_Packets.data()) {
+		m_Packets.swap(m_Scratch);
+	}
+}
+
+void RenderQueue::Submit(IRenderer* pRenderer) {
+	Sort();
+
+	// Anything drawn outside the queue may have changed device state since the last submit
+	m_StateCache.Reset();
+	// Reserved up front, the pointers handed to the nodes stay valid while the rest is gathered
+	m_Instances.clear();
+	m_Instances.reserve(m_InstanceSource.size());
+	size_t count = m_Packets.size();
+	size_t i = 0u;
+	while (i < count) {
+		const DrawPacket& packet = m_Packets[i];
+		if (packet.m_InstanceKey == 0u) {
+			packet.m_pNode->VSubmit(pRenderer, m_StateCache);
+			++i;
+			continue;
+		}
+
+		// Equal instance keys sort next to each other, a run ends at the first packet with another key
+		size_t first = m_Instances.size();
+		size_t end = i;
+		while (end < count && m_Packets[end].m_InstanceKey == packet.m_InstanceKey) {
+			m_Instances.push_back(m_InstanceSource[m_Packets[end].m_Instance]);
+			++end;
+		}
+		packet.m_pNode->VSubmitInstanced(pRenderer, m_StateCache, m_Instances.data() + first, static_cast<UINT>(end - i));
+		i = end;
+	}
+	Clear();
+}
+
+void RenderQueue::Clear() {
+	m_Packets.clear();
+	m_InstanceSource.clear();
+}
+
+void RenderQueue::SetInstancing(bool enabled) {
+	m_bInstancing = enabled;
+}
+
+bool RenderQueue::IsInstancing() const {
+	return m_bInstancing;
+}
+
+bool RenderQueue::IsEmpty() const {
+	return m_Packets.empty();
+}
+
+const std::vector<DrawPacket>& RenderQueue::GetPackets() const {
+	return m_Packets;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "render_pass.h"
+#include "../bindable/bindable.h"
+#include "../graphics/constant_buffer_types.h"
+
+class IRenderer;
+class SceneNode;
+
+struct DrawPacket {
+	uint64_t m_SortKey;
+	SceneNode* m_pNode;
+	// Non zero when the node can be drawn as an instance, packets with equal keys share mesh, material and shaders.
+	uint64_t m_InstanceKey;
+	// Index of the node's transforms in the instance data pushed this frame.
+	uint32_t m_Instance;
+};
+
+// State id last bound to each bindable slot, so a draw only rebinds the slots that actually change.
+class RenderStateCache {
+	std::array<uint64_t, BindableTypeCount> m_Bound;
+
+public:
+	RenderStateCache();
+
+	void Reset();
+	// Records stateId as bound and returns true when the slot held something else.
+	bool NeedsBind(BindableType type, uint64_t stateId);
+};
+
+// Draws collected by scene traversal and submitted once per pass in sort key order. The key orders by pass, then
+// shader, then material, then front to back depth, so neighbouring draws share as much state as possible.
+// Neighbouring packets with the same instance key are merged into one instanced draw.
+class RenderQueue {
+	std::vector<DrawPacket> m_Packets;
+	std::vector<DrawPacket> m_Scratch;
+	RenderStateCache m_StateCache;
+	// Instance data in push order, and the same data gathered in draw order at submit.
+	std::vector<InstanceData> m_InstanceSource;
+	std::vector<InstanceData> m_Instances;
+	bool m_bInstancing = true;
+
+public:
+	// 4 bits pass | 20 bits shader | 16 bits material | 24 bits depth, depth being 0..1 from the camera.
+	static uint64_t MakeSortKey(RenderPass pass, uint32_t shaderId, uint32_t materialId, float depth);
+	static uint32_t HashStateIds(uint64_t first, uint64_t second);
+	// Ascending order of these keys draws the farthest view space depth first, for the alpha pass.
+	static uint64_t MakeBackToFrontKey(float viewDepth);
+
+	void Push(uint64_t sortKey, SceneNode* pNode);
+	// The sort key of an instanceable node should depend on the instance key, so its instances end up next to each other.
+	void PushInstance(uint64_t sortKey, SceneNode* pNode, uint64_t instanceKey, const InstanceData& instance);
+	void Sort();
+	// Sorts, draws every packet through the renderer and empties the queue.
+	void Submit(IRenderer* pRenderer);
+	void Clear();
+
+	// Nodes check this before pushing instances, off draws every node on its own.
+	void SetInstancing(bool enabled);
+	bool IsInstancing() const;
+
+	bool IsEmpty() const;
+	const std::vector<DrawPacket>& GetPackets() const;
+};
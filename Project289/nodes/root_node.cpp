@@ -35,8 +35,11 @@ HRESULT RootNode::VRenderChildren(Scene* pScene) {
 			}
 			break;
 			case RenderPass::RenderPass_Sky: {
+				// Static and actor draws share one sorted submit, the sky needs its own render state
+				pScene->FlushRenderQueue();
 				std::shared_ptr<IRenderState> skyPass = pScene->GetRenderer()->VPrepareSkyBoxPass();
 				m_Children[pass]->VRenderChildren(pScene);
+				pScene->FlushRenderQueue();
 			}
 			break;
 		}
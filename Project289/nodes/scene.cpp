@@ -7,6 +7,17 @@
 #include "../events/evt_data_modified_render_component.h"
 #include "light_manager.h"
 #include "../engine/engine.h"
+#include "../tools/game_timer.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <unordered_map>
+
+namespace {
+	float ElapsedMs(gameTimePoint from, gameTimePoint to) {
+		return std::chrono::duration<float, std::milli>(to - from).count();
+	}
+}
 
 void Scene::SetCamera(std::shared_ptr<CameraNode> camera) {
 	m_Camera = camera;
@@ -26,6 +37,12 @@ void Scene::PushAndSetMatrix4x4(const DirectX::XMFLOAT4X4& toWorld) {
 	m_Renderer->VSetWorldTransform4x4(GetTopMatrix4x4f());
 }
 
+void Scene::PushAndSetWorldMatrix4x4(const DirectX::XMFLOAT4X4& world) {
+	m_MatrixStack->Push();
+	m_MatrixStack->LoadMatrix(world);
+	m_Renderer->VSetWorldTransform4x4(world);
+}
+
 void Scene::PushAndSetMatrix(DirectX::FXMMATRIX toWorld) {
 	m_MatrixStack->Push();
 	m_MatrixStack->MultMatrixLocal(toWorld);
@@ -74,12 +91,86 @@ LightManager* Scene::GetLightManager() {
 	return m_LightManager.get();
 }
 
-void Scene::AddAlphaSceneNode(AlphaSceneNode* asn) {
-	m_AlphaSceneNodes.push_back(asn);
+void Scene::AddAlphaSceneNode(SceneNode* pNode) {
+	m_AlphaQueue.Push(RenderQueue::MakeBackToFrontKey(GetViewDepth(pNode->GetWorldTransform4x4())), pNode);
+}
+
+float Scene::GetViewDepth(const DirectX::XMFLOAT4X4& world) const {
+	// Only the third column of the view matrix contributes to z
+	const DirectX::XMFLOAT4X4& view = m_Camera->GetView4x4();
+	return world._41 * view._13 + world._42 * view._23 + world._43 * view._33 + view._43;
+}
+
+RenderQueue& Scene::GetRenderQueue() {
+	return m_RenderQueue;
+}
+
+void Scene::FlushRenderQueue() {
+	if (!m_RenderQueue.IsEmpty()) {
+		m_RenderQueue.Submit(m_Renderer);
+	}
 }
 
 HRESULT Scene::Pick(RayCast* pRayCast) {
-	return m_Root->VPick(this, pRayCast);
+	// Only actors whose bounds the ray passes through are asked to pick
+	m_QueryResults.clear();
+	m_SpatialIndex.QueryRay(pRayCast->m_vPickRayOrig, pRayCast->m_vPickRayDir, FLT_MAX, m_QueryResults);
+	for (SceneNode* pNode : m_QueryResults) {
+		if (pNode->VPick(this, pRayCast) == E_FAIL) {
+			return E_FAIL;
+		}
+	}
+	return S_OK;
+}
+
+void Scene::RayCastBatch(const BvhRay* pRays, SceneRayHit* pHits, size_t count, JobSystem* pJobSystem) {
+	// Broadphase first, so each actor's meshes see only the rays that pass its bounds and test them in one batch
+	std::unordered_map<SceneNode*, std::vector<uint32_t>> raysByActor;
+	for (size_t i = 0; i < count; ++i) {
+		pHits[i].actorId = INVALID_ACTOR_ID;
+		pHits[i].hit = { pRays[i].maxDistance, MeshBvh::sk_NoHit, 0.0f, 0.0f };
+		m_QueryResults.clear();
+		m_SpatialIndex.QueryRay(pRays[i].origin, pRays[i].direction, pRays[i].maxDistance, m_QueryResults);
+		for (SceneNode* pNode : m_QueryResults) {
+			raysByActor[pNode].push_back(static_cast<uint32_t>(i));
+		}
+	}
+
+	for (const auto& [pActorNode, rayIndices] : raysByActor) {
+		RayCastNodeBatch(pActorNode->m_Props.ActorId(), pActorNode, pRays, rayIndices, pHits, pJobSystem);
+	}
+}
+
+void Scene::RayCastNodeBatch(ActorId id, SceneNode* pNode, const BvhRay* pRays, const std::vector<uint32_t>& rayIndices, SceneRayHit* pHits, JobSystem* pJobSystem) {
+	const MeshBvh* pBvh = pNode->VGetPickBvh();
+	if (pBvh) {
+		// The direction is not normalized after the move to mesh space, so hit distances stay in world ray units
+		DirectX::XMMATRIX toLocal = DirectX::XMLoadFloat4x4(&pNode->m_WorldInvTransform);
+		std::vector<BvhRay> localRays(rayIndices.size());
+		std::vector<BvhHit> localHits(rayIndices.size());
+		for (size_t i = 0; i < rayIndices.size(); ++i) {
+			const BvhRay& ray = pRays[rayIndices[i]];
+			DirectX::XMStoreFloat3(&localRays[i].origin, DirectX::XMVector3TransformCoord(DirectX::XMLoadFloat3(&ray.origin), toLocal));
+			DirectX::XMStoreFloat3(&localRays[i].direction, DirectX::XMVector3TransformNormal(DirectX::XMLoadFloat3(&ray.direction), toLocal));
+			// Only hits nearer than the best so far can matter
+			localRays[i].maxDistance = pHits[rayIndices[i]].hit.distance;
+		}
+		pBvh->IntersectBatch(localRays.data(), localHits.data(), localRays.size(), pJobSystem);
+		for (size_t i = 0; i < rayIndices.size(); ++i) {
+			SceneRayHit& best = pHits[rayIndices[i]];
+			if (localHits[i].triangle != MeshBvh::sk_NoHit && localHits[i].distance < best.hit.distance) {
+				best.actorId = id;
+				best.hit = localHits[i];
+			}
+		}
+	}
+	for (const std::shared_ptr<ISceneNode>& pChild : pNode->m_Children) {
+		RayCastNodeBatch(id, static_cast<SceneNode*>(pChild.get()), pRays, rayIndices, pHits, pJobSystem);
+	}
+}
+
+const SceneRenderTimings& Scene::GetRenderTimings() const {
+	return m_RenderTimings;
 }
 
 IRenderer* Scene::GetRenderer() {
@@ -87,16 +178,189 @@ IRenderer* Scene::GetRenderer() {
 }
 
 void Scene::RenderAlphaPass() {
+	if (m_AlphaQueue.IsEmpty()) {
+		return;
+	}
 	std::shared_ptr<IRenderState> alphaPass = m_Renderer->VPrepareAlphaPass();
 
-	m_AlphaSceneNodes.sort();
-	while (!m_AlphaSceneNodes.empty()) 	{
-		AlphaSceneNodes::reverse_iterator i = m_AlphaSceneNodes.rbegin();
-		PushAndSetMatrix4x4((*i)->m_Concat);
-		(*i)->m_pNode->VRender(this);
-		delete (*i);
+	m_AlphaQueue.Sort();
+	for (const DrawPacket& packet : m_AlphaQueue.GetPackets()) {
+		PushAndSetWorldMatrix4x4(packet.m_pNode->GetWorldTransform4x4());
+		packet.m_pNode->VRender(this);
 		PopMatrix();
-		m_AlphaSceneNodes.pop_back();
+	}
+	m_AlphaQueue.Clear();
+}
+
+void Scene::RebuildTransformOrder() {
+	m_TransformNodes.clear();
+	m_TransformParents.clear();
+
+	// Breadth first, so every parent lands in the array before its children
+	m_TransformNodes.push_back(m_Root.get());
+	m_TransformParents.push_back(-1);
+	for (size_t i = 0; i < m_TransformNodes.size(); ++i) {
+		for (const std::shared_ptr<ISceneNode>& pChild : m_TransformNodes[i]->m_Children) {
+			m_TransformNodes.push_back(static_cast<SceneNode*>(pChild.get()));
+			m_TransformParents.push_back(static_cast<int>(i));
+		}
+	}
+
+	m_TransformChanged.assign(m_TransformNodes.size(), 0u);
+	for (size_t i = 0; i < m_TransformNodes.size(); ++i) {
+		m_TransformNodes[i]->m_CullIndex = static_cast<uint32_t>(i);
+	}
+	m_Culler.Resize(m_TransformNodes.size());
+	m_bTransformOrderDirty = false;
+}
+
+void Scene::UpdateTransforms() {
+	if (!m_Root) { return; }
+	// Node order changed, so every culling sphere slot has to be written again
+	bool rebuilt = m_bTransformOrderDirty;
+	if (rebuilt) {
+		RebuildTransformOrder();
+	}
+
+	for (size_t i = 0; i < m_TransformNodes.size(); ++i) {
+		SceneNode* pNode = m_TransformNodes[i];
+		int parent = m_TransformParents[i];
+		bool changed = pNode->SyncTransform() || pNode->m_bWorldDirty;
+		if (parent >= 0 && m_TransformChanged[parent]) {
+			changed = true;
+		}
+		m_TransformChanged[i] = changed ? 1u : 0u;
+		if (changed) {
+			pNode->UpdateWorldTransform(parent >= 0 ? m_TransformNodes[parent] : nullptr);
+		}
+		if (changed || rebuilt) {
+			const DirectX::XMFLOAT4X4& world = pNode->m_WorldTransform;
+			m_Culler.SetSphere(i, world._41, world._42, world._43, pNode->m_Props.Radius());
+		}
+		if (changed && pNode->m_SpatialProxy != SpatialIndex::sk_NullProxy) {
+			UpdateSpatialProxy(pNode, pNode->m_WorldTransform);
+		}
+	}
+}
+
+void Scene::CullNodes() {
+	m_Culler.SetPlanes(m_Camera->GetFrustum(), m_Camera->GetView4x4());
+	m_Culler.Cull(g_pApp ? g_pApp->GetJobSystem() : nullptr);
+
+	// Whole actors first, traversal skips the ones not stamped with this frame before touching their subtree
+	++m_FrameIndex;
+	m_QueryResults.clear();
+	m_SpatialIndex.QueryFrustum(m_Culler.GetPlanes(), m_QueryResults);
+	for (SceneNode* pNode : m_QueryResults) {
+		pNode->m_VisibleFrame = m_FrameIndex;
+	}
+
+	gameTimePoint occlusionStart = gameClock::now();
+	if (m_bOcclusionCulling && !m_Occluders.empty()) {
+		CullOccluded();
+	}
+	else {
+		m_OcclusionCuller.ClearStats();
+	}
+	m_RenderTimings.occlusion = ElapsedMs(occlusionStart, gameClock::now());
+}
+
+void Scene::CullOccluded() {
+	// Occluders outside the frustum cover no pixel, translucent ones hide nothing
+	m_OccluderMeshes.clear();
+	for (const OccluderEntry& entry : m_Occluders) {
+		if (entry.pActorNode->m_VisibleFrame != m_FrameIndex || entry.pNode->m_Props.GetMaterial().GetAlpha() != 1.0f) {
+			continue;
+		}
+		OccluderMesh occluder;
+		if (entry.pNode->VGetOccluderGeometry(occluder)) {
+			occluder.world = entry.pNode->m_WorldTransform;
+			m_OccluderMeshes.push_back(occluder);
+		}
+	}
+	if (m_OccluderMeshes.empty()) {
+		m_OcclusionCuller.ClearStats();
+		return;
+	}
+
+	DirectX::XMFLOAT4X4 viewProjection;
+	DirectX::XMStoreFloat4x4(&viewProjection, DirectX::XMMatrixMultiply(DirectX::XMLoadFloat4x4(&m_Camera->GetView4x4()), DirectX::XMLoadFloat4x4(&m_Camera->GetProjection4x4f())));
+	JobSystem* pJobSystem = g_pApp ? g_pApp->GetJobSystem() : nullptr;
+	m_OcclusionCuller.SetViewProjection(viewProjection);
+	m_OcclusionCuller.Rasterize(m_OccluderMeshes, pJobSystem);
+
+	// Same boxes the spatial index holds, an actor is hidden only when all of its bounds are
+	m_OcclusionBoxes.clear();
+	for (SceneNode* pNode : m_QueryResults) {
+		const DirectX::XMFLOAT4X4& world = pNode->m_WorldTransform;
+		m_OcclusionBoxes.push_back(SpatialIndex::MakeSphereBox(DirectX::XMFLOAT3(world._41, world._42, world._43), pNode->m_Props.Radius()));
+	}
+	m_OcclusionCuller.TestBoxes(m_OcclusionBoxes, m_Occluded, pJobSystem);
+	for (size_t i = 0; i < m_QueryResults.size(); ++i) {
+		if (m_Occluded[i]) {
+			m_QueryResults[i]->m_VisibleFrame = 0u;
+		}
+	}
+}
+
+bool Scene::IsVisible(uint32_t cullIndex) const {
+	return m_Culler.IsVisible(cullIndex);
+}
+
+uint32_t Scene::GetFrameIndex() const {
+	return m_FrameIndex;
+}
+
+void Scene::SetOcclusionCulling(bool enabled) {
+	m_bOcclusionCulling = enabled;
+}
+
+bool Scene::IsOcclusionCulling() const {
+	return m_bOcclusionCulling;
+}
+
+const OcclusionStats& Scene::GetOcclusionStats() const {
+	return m_OcclusionCuller.GetStats();
+}
+
+void Scene::QueryFrustum(const std::array<DirectX::XMFLOAT4, 6>& planes, std::vector<SceneNode*>& results) const {
+	m_SpatialIndex.QueryFrustum(planes, results);
+}
+
+void Scene::QueryRay(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction, float maxDistance, std::vector<SceneNode*>& results) const {
+	m_SpatialIndex.QueryRay(origin, direction, maxDistance, results);
+}
+
+void Scene::QuerySphere(const DirectX::XMFLOAT3& center, float radius, std::vector<SceneNode*>& results) const {
+	m_SpatialIndex.QuerySphere(center, radius, results);
+}
+
+void Scene::DestroySpatialProxy(SceneNode* pNode) {
+	m_SpatialIndex.DestroyProxy(pNode->m_SpatialProxy);
+	pNode->m_SpatialProxy = SpatialIndex::sk_NullProxy;
+}
+
+void Scene::AddOccluders(ActorId id, SceneNode* pActorNode, SceneNode* pNode) {
+	OccluderMesh occluder;
+	if (pNode->VGetOccluderGeometry(occluder)) {
+		m_Occluders.push_back({ id, pActorNode, pNode });
+	}
+	for (const std::shared_ptr<ISceneNode>& pChild : pNode->m_Children) {
+		AddOccluders(id, pActorNode, static_cast<SceneNode*>(pChild.get()));
+	}
+}
+
+void Scene::RemoveOccluders(ActorId id) {
+	m_Occluders.erase(std::remove_if(m_Occluders.begin(), m_Occluders.end(), [id](const OccluderEntry& entry) { return entry.actorId == id; }), m_Occluders.end());
+}
+
+void Scene::UpdateSpatialProxy(SceneNode* pNode, const DirectX::XMFLOAT4X4& world) {
+	Aabb box = SpatialIndex::MakeSphereBox(DirectX::XMFLOAT3(world._41, world._42, world._43), pNode->m_Props.Radius());
+	if (pNode->m_SpatialProxy == SpatialIndex::sk_NullProxy) {
+		pNode->m_SpatialProxy = m_SpatialIndex.CreateProxy(box, pNode);
+	}
+	else {
+		m_SpatialIndex.MoveProxy(pNode->m_SpatialProxy, box);
 	}
 }
 
@@ -123,15 +387,32 @@ Scene::~Scene() {
 
 HRESULT Scene::OnRender() {
 	if (m_Root && m_Camera) {
+		gameTimePoint start = gameClock::now();
 		m_Camera->SetViewTransform(this);
+		UpdateTransforms();
+		gameTimePoint transformsDone = gameClock::now();
+		CullNodes();
+		gameTimePoint cullDone = gameClock::now();
 		m_LightManager->CalcLighting(this);
+		gameTimePoint lightingDone = gameClock::now();
 
 		if (m_Root->VPreRender(this) == S_OK) {
 			m_Root->VRender(this);
 			m_Root->VRenderChildren(this);
 			m_Root->VPostRender(this);
 		}
+		gameTimePoint traversalDone = gameClock::now();
+		FlushRenderQueue();
+		gameTimePoint submitDone = gameClock::now();
 		RenderAlphaPass();
+		gameTimePoint alphaDone = gameClock::now();
+
+		m_RenderTimings.transforms = ElapsedMs(start, transformsDone);
+		m_RenderTimings.cull = ElapsedMs(transformsDone, cullDone);
+		m_RenderTimings.lighting = ElapsedMs(cullDone, lightingDone);
+		m_RenderTimings.traversal = ElapsedMs(lightingDone, traversalDone);
+		m_RenderTimings.submit = ElapsedMs(traversalDone, submitDone);
+		m_RenderTimings.alpha = ElapsedMs(submitDone, alphaDone);
 	}
 
 	return S_OK;
@@ -157,7 +438,7 @@ HRESULT Scene::OnUpdate(float deltaSeconds) {
 	if (!m_Root) {
 		return S_OK;
 	}
-	return m_Root->VOnUpdate(this, g_pApp->GetTimer().DeltaTime());
+	return m_Root->VOnUpdate(this, deltaSeconds);
 }
 
 std::shared_ptr<ISceneNode> Scene::FindActor(ActorId id) {
@@ -171,13 +452,27 @@ std::shared_ptr<ISceneNode> Scene::FindActor(ActorId id) {
 
 bool Scene::AddChild(ActorId id, std::shared_ptr<ISceneNode> kid) {
 	if (id != INVALID_ACTOR_ID) {
+		std::shared_ptr<ISceneNode> pOld = FindActor(id);
+		if (pOld) {
+			DestroySpatialProxy(static_cast<SceneNode*>(pOld.get()));
+			RemoveOccluders(id);
+		}
 		m_ActorMap[id] = kid;
+
+		// Sky and lights are never culled, only what the render groups draw goes into the index
+		RenderPass pass = kid->VGet().RenderPass();
+		if (pass == RenderPass::RenderPass_Static || pass == RenderPass::RenderPass_Actor) {
+			SceneNode* pNode = static_cast<SceneNode*>(kid.get());
+			UpdateSpatialProxy(pNode, pNode->m_Props.ToWorld4x4());
+			AddOccluders(id, pNode, pNode);
+		}
 	}
 
 	std::shared_ptr<LightNode> pLight = std::dynamic_pointer_cast<LightNode>(kid);
-	if (pLight && m_LightManager->m_Lights.size() + 1 < MAXIMUM_LIGHTS_SUPPORTED) 	{
+	if (pLight) 	{
 		m_LightManager->m_Lights.push_back(pLight);
 	}
+	m_bTransformOrderDirty = true;
 	return m_Root->VAddChild(kid);
 }
 
@@ -193,7 +488,10 @@ bool Scene::RemoveChild(ActorId id) {
 	if (pLight) {
 		m_LightManager->m_Lights.remove(pLight);
 	}
+	DestroySpatialProxy(static_cast<SceneNode*>(kid.get()));
+	RemoveOccluders(id);
 	m_ActorMap.erase(id);
+	m_bTransformOrderDirty = true;
 	return m_Root->VRemoveChild(id);
 }
 
@@ -245,5 +543,9 @@ void Scene::MoveActorDelegate(IEventDataPtr pEventData) {
 	std::shared_ptr<ISceneNode> pNode = FindActor(id);
 	if (pNode) {
 		pNode->VSetTransform4x4(&transform, nullptr);
+		SceneNode* pSceneNode = static_cast<SceneNode*>(pNode.get());
+		if (pSceneNode->m_SpatialProxy != SpatialIndex::sk_NullProxy) {
+			UpdateSpatialProxy(pSceneNode, transform);
+		}
 	}
 }
@@ -1,18 +1,41 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "i_scene_node.h"
 #include "scene_node.h"
 #include "../engine/i_renderer.h"
 #include "matrix_stack.h"
-#include "alpha_scene_node.h"
+#include "render_queue.h"
+#include "frustum_culler.h"
+#include "spatial_index.h"
+#include "occlusion_culler.h"
 
 class CameraNode;
 class SkyNode;
 class LightNode;
 class LightManager;
 class RootNode;
+class JobSystem;
+
+// Closest hit of one ray of Scene::RayCastBatch, actorId is INVALID_ACTOR_ID when the ray hit nothing.
+struct SceneRayHit {
+	ActorId actorId;
+	BvhHit hit;
+};
+
+// CPU time spent in each stage of the last OnRender, in milliseconds.
+struct SceneRenderTimings {
+	float transforms = 0.0f;
+	float cull = 0.0f;
+	float lighting = 0.0f;
+	float traversal = 0.0f;
+	float submit = 0.0f;
+	float alpha = 0.0f;
+	// Part of cull, drawing the occluders and testing the actors against them.
+	float occlusion = 0.0f;
+};
 
 class Scene {
 protected:
@@ -23,12 +46,48 @@ protected:
 	IRenderer* m_Renderer;
 
 	std::shared_ptr<MatrixStack> m_MatrixStack;
-	AlphaSceneNodes m_AlphaSceneNodes;
+	RenderQueue m_RenderQueue;
+	// Translucent nodes of the frame keyed by view depth, the storage is kept between frames.
+	RenderQueue m_AlphaQueue;
+	SceneRenderTimings m_RenderTimings;
 	SceneActorMap m_ActorMap;
 
 	std::unique_ptr<LightManager> m_LightManager;
 
+	// Scene nodes flattened parent-before-child, rebuilt only when the hierarchy changes.
+	std::vector<SceneNode*> m_TransformNodes;
+	std::vector<int> m_TransformParents;
+	std::vector<uint8_t> m_TransformChanged;
+	bool m_bTransformOrderDirty = true;
+	// Bounding spheres in the same order, refreshed with the transforms and culled once per frame.
+	FrustumCuller m_Culler;
+	// Bounds of the actor nodes under the render groups, for hierarchical culling and picking.
+	SpatialIndex m_SpatialIndex;
+	std::vector<SceneNode*> m_QueryResults;
+	uint32_t m_FrameIndex = 0u;
+	// Meshes of occluder actors, drawn into a software depth buffer that the frustum query results are tested against.
+	struct OccluderEntry {
+		ActorId actorId;
+		SceneNode* pActorNode;
+		SceneNode* pNode;
+	};
+	OcclusionCuller m_OcclusionCuller;
+	std::vector<OccluderEntry> m_Occluders;
+	std::vector<OccluderMesh> m_OccluderMeshes;
+	std::vector<Aabb> m_OcclusionBoxes;
+	std::vector<uint8_t> m_Occluded;
+	bool m_bOcclusionCulling = true;
+
 	void RenderAlphaPass();
+	void RebuildTransformOrder();
+	// Creates the node's proxy or moves it to a sphere of the node's radius at the world translation.
+	void UpdateSpatialProxy(SceneNode* pNode, const DirectX::XMFLOAT4X4& world);
+	void DestroySpatialProxy(SceneNode* pNode);
+	void AddOccluders(ActorId id, SceneNode* pActorNode, SceneNode* pNode);
+	void RayCastNodeBatch(ActorId id, SceneNode* pNode, const BvhRay* pRays, const std::vector<uint32_t>& rayIndices, SceneRayHit* pHits, JobSystem* pJobSystem);
+	void RemoveOccluders(ActorId id);
+	// Drops the frustum query results hidden behind the occluders drawn this frame.
+	void CullOccluded();
 
 public:
 	Scene(IRenderer* renderer);
@@ -52,7 +111,26 @@ public:
 
 	void ActivateScene(bool isActive);
 
+	// Refreshes the cached world transform of every node that moved since the last call, and of its subtree.
+	void UpdateTransforms();
+	// Tests every node's bounding sphere against the camera frustum, VIsVisible then reads the result.
+	void CullNodes();
+	bool IsVisible(uint32_t cullIndex) const;
+	// Incremented by every CullNodes, actor nodes stamped with it are inside the frustum.
+	uint32_t GetFrameIndex() const;
+
+	// On by default, only does work in scenes with occluder actors.
+	void SetOcclusionCulling(bool enabled);
+	bool IsOcclusionCulling() const;
+	const OcclusionStats& GetOcclusionStats() const;
+
+	// Actor nodes whose bounds may pass the test, the results are appended.
+	void QueryFrustum(const std::array<DirectX::XMFLOAT4, 6>& planes, std::vector<SceneNode*>& results) const;
+	void QueryRay(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction, float maxDistance, std::vector<SceneNode*>& results) const;
+	void QuerySphere(const DirectX::XMFLOAT3& center, float radius, std::vector<SceneNode*>& results) const;
+
 	void PushAndSetMatrix4x4(const DirectX::XMFLOAT4X4& toWorld);
+	void PushAndSetWorldMatrix4x4(const DirectX::XMFLOAT4X4& world);
 	void PushAndSetMatrix(DirectX::FXMMATRIX toWorld);
 	void PopMatrix();
 	DirectX::XMMATRIX GetTopMatrix();
@@ -64,9 +142,21 @@ public:
 
 	LightManager* GetLightManager();
 
-	void AddAlphaSceneNode(AlphaSceneNode* asn);
+	// Defers a translucent node to the alpha pass, drawn back to front after the opaque queue.
+	void AddAlphaSceneNode(SceneNode* pNode);
+	// View space z of the translation of a world matrix, valid once the camera has set the view for the frame.
+	float GetViewDepth(const DirectX::XMFLOAT4X4& world) const;
+
+	RenderQueue& GetRenderQueue();
+	// Draws everything queued since the last flush, called at the end of each render pass.
+	void FlushRenderQueue();
 
 	HRESULT Pick(RayCast* pRayCast);
+	// Closest hit of each world space ray. The spatial index finds the actors each ray passes, then every mesh part
+	// under them tests all of its rays in one MeshBvh::IntersectBatch. Distances are in units of each ray's direction.
+	void RayCastBatch(const BvhRay* pRays, SceneRayHit* pHits, size_t count, JobSystem* pJobSystem);
+
+	const SceneRenderTimings& GetRenderTimings() const;
 
 	IRenderer* GetRenderer();
 };
\ No newline at end of file
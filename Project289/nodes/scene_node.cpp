@@ -23,6 +23,9 @@ SceneNode::SceneNode(WeakBaseRenderComponentPtr renderComponent, RenderPass rend
 	m_Props.m_Name = (renderComponent) ? renderComponent->VGetName() : "SceneNode";
 	m_Props.m_RenderPass = renderPass;
 	m_Props.m_AlphaType = AlphaType::AlphaOpaque;
+
+	m_WorldTransform = m_Props.m_ToWorld;
+	m_WorldInvTransform = m_Props.m_FromWorld;
 }
 
 SceneNode::SceneNode(WeakBaseRenderComponentPtr renderComponent, RenderPass renderPass, DirectX::FXMMATRIX to, DirectX::CXMMATRIX from, bool calulate_from) {
@@ -36,6 +39,9 @@ SceneNode::SceneNode(WeakBaseRenderComponentPtr renderComponent, RenderPass rend
 	m_Props.m_Name = (renderComponent) ? renderComponent->VGetName() : "SceneNode";
 	m_Props.m_RenderPass = renderPass;
 	m_Props.m_AlphaType = AlphaType::AlphaOpaque;
+
+	m_WorldTransform = m_Props.m_ToWorld;
+	m_WorldInvTransform = m_Props.m_FromWorld;
 }
 
 SceneNode::~SceneNode() {}
@@ -45,6 +51,7 @@ const SceneNodeProperties& SceneNode::VGet() const {
 }
 
 void SceneNode::VSetTransform4x4(const DirectX::XMFLOAT4X4* toWorld, const DirectX::XMFLOAT4X4* fromWorld) {
+	m_bWorldDirty = true;
 	m_Props.m_ToWorld = *toWorld;
 	if (!fromWorld) {
 		DirectX::XMStoreFloat4x4(&m_Props.m_FromWorld, DirectX::XMMatrixInverse(nullptr, DirectX::XMLoadFloat4x4(&m_Props.m_ToWorld)));
@@ -55,6 +62,7 @@ void SceneNode::VSetTransform4x4(const DirectX::XMFLOAT4X4* toWorld, const Direc
 }
 
 void SceneNode::VSetTransform(DirectX::FXMMATRIX toWorld, DirectX::CXMMATRIX fromWorld, bool calulate_from) {
+	m_bWorldDirty = true;
 	DirectX::XMStoreFloat4x4(&m_Props.m_ToWorld, toWorld);
 	if (!calulate_from) {
 		DirectX::XMStoreFloat4x4(&m_Props.m_FromWorld, DirectX::XMMatrixInverse(nullptr, toWorld));
@@ -88,29 +96,47 @@ HRESULT SceneNode::VOnUpdate(Scene* pScene, float elapsedSeconds) {
 }
 
 HRESULT SceneNode::VPreRender(Scene* pScene) {
-	StrongActorPtr pActor = MakeStrongPtr(g_pApp->GetGameLogic()->VGetActor(m_Props.m_ActorId));
-	if (pActor) {
-		std::shared_ptr<TransformComponent> pTc = MakeStrongPtr(pActor->GetComponent<TransformComponent>("TransformComponent"));
-		if (pTc) {
-			m_Props.m_ToWorld = pTc->GetTransform4x4f();
-		}
-	}
-
-	pScene->PushAndSetMatrix4x4(m_Props.m_ToWorld);
+	pScene->PushAndSetWorldMatrix4x4(m_WorldTransform);
 	return S_OK;
 }
 
-bool SceneNode::VIsVisible(Scene* pScene) const {
-	DirectX::XMMATRIX toWorld = pScene->GetCamera()->VGet().ToWorld();
-	DirectX::XMMATRIX fromWorld = pScene->GetCamera()->VGet().FromWorld();
+bool SceneNode::SyncTransform() {
+	if (m_Props.m_ActorId == INVALID_ACTOR_ID) {
+		return false;
+	}
+
+	TransformComponent* pTc = m_TransformRef.Get();
+	bool refreshed = false;
+	if (!pTc) {
+		StrongActorPtr pActor = MakeStrongPtr(g_pApp->GetGameLogic()->VGetActor(m_Props.m_ActorId));
+		if (!pActor) {
+			return false;
+		}
+		m_TransformRef = g_pApp->GetGameLogic()->GetComponentStore()->MakeRef<TransformComponent>(*pActor);
+		pTc = pActor->GetComponentFast<TransformComponent>();
+		refreshed = true;
+	}
+	if (!pTc || (!refreshed && pTc->GetRevision() == m_TransformRevision)) {
+		return false;
+	}
 
-	DirectX::XMVECTOR pos = DirectX::XMVectorSetW(GetWorldPosition(), 1.0f);
-	DirectX::XMVECTOR fromWorldPos = DirectX::XMVector4Transform(pos, fromWorld);
+	m_TransformRevision = pTc->GetRevision();
+	m_Props.m_ToWorld = pTc->GetTransform4x4f();
+	return true;
+}
 
-	Frustum const& frustum = pScene->GetCamera()->GetFrustum();
+void SceneNode::UpdateWorldTransform(const SceneNode* pParent) {
+	DirectX::XMMATRIX world = DirectX::XMLoadFloat4x4(&m_Props.m_ToWorld);
+	if (pParent) {
+		world = DirectX::XMMatrixMultiply(world, DirectX::XMLoadFloat4x4(&pParent->m_WorldTransform));
+	}
+	DirectX::XMStoreFloat4x4(&m_WorldTransform, world);
+	DirectX::XMStoreFloat4x4(&m_WorldInvTransform, DirectX::XMMatrixInverse(nullptr, world));
+	m_bWorldDirty = false;
+}
 
-	bool isVisible = frustum.Inside(fromWorldPos, VGet().Radius());
-	return isVisible;
+bool SceneNode::VIsVisible(Scene* pScene) const {
+	return pScene->IsVisible(m_CullIndex);
 }
 
 HRESULT SceneNode::VRender(Scene* pScene) {
@@ -122,23 +148,22 @@ HRESULT SceneNode::VRenderChildren(Scene* pScene) {
 	SceneNodeList::iterator end = m_Children.end();
 
 	while (i != end) {
+		// Actors the spatial index left out of this frame are skipped with their whole subtree
+		const SceneNode* pKid = static_cast<const SceneNode*>(i->get());
+		if (pKid->m_SpatialProxy != SpatialIndex::sk_NullProxy && pKid->m_VisibleFrame != pScene->GetFrameIndex()) {
+			++i;
+			continue;
+		}
 		if ((*i)->VPreRender(pScene) == S_OK) {
 			if ((*i)->VIsVisible(pScene)) {
 				float alpha = (*i)->VGet().m_Material.GetAlpha();
 				if (alpha == 1.0f) {
-					(*i)->VRender(pScene);
+					if (!static_cast<SceneNode*>(i->get())->VQueueRender(pScene)) {
+						(*i)->VRender(pScene);
+					}
 				}
 				else if (alpha != 0.0f) {
-					AlphaSceneNode* asn = new AlphaSceneNode;
-					asn->m_pNode = *i;
-					asn->m_Concat = pScene->GetTopInvMatrix4x4f();
-					DirectX::XMVECTOR worldPos = DirectX::XMVectorSet(asn->m_Concat._41, asn->m_Concat._42, asn->m_Concat._43, asn->m_Concat._44);
-					DirectX::XMMATRIX fromWorld = pScene->GetCamera()->VGet().FromWorld();
-					DirectX::XMVECTOR screenPos = DirectX::XMVector4Transform(worldPos, fromWorld);
-
-					asn->m_ScreenZ = DirectX::XMVectorGetZ(screenPos);
-
-					pScene->AddAlphaSceneNode(asn);
+					pScene->AddAlphaSceneNode(static_cast<SceneNode*>(i->get()));
 				}
 				(*i)->VRenderChildren(pScene);
 			}
@@ -155,11 +180,28 @@ HRESULT SceneNode::VPostRender(Scene* pScene) {
 	return S_OK;
 }
 
+bool SceneNode::VQueueRender(Scene* pScene) {
+	return false;
+}
+
+void SceneNode::VSubmit(IRenderer* pRenderer, RenderStateCache& stateCache) {}
+
+void SceneNode::VSubmitInstanced(IRenderer* pRenderer, RenderStateCache& stateCache, const InstanceData* pInstances, UINT count) {}
+
+bool SceneNode::VGetOccluderGeometry(OccluderMesh& occluder) const {
+	return false;
+}
+
+const MeshBvh* SceneNode::VGetPickBvh() {
+	return nullptr;
+}
+
 bool SceneNode::VAddChild(std::shared_ptr<ISceneNode> ikid) {
 	m_Children.push_back(ikid);
 
 	std::shared_ptr<SceneNode> kid = std::static_pointer_cast<SceneNode>(ikid);
 	kid->m_pParent = this;
+	kid->m_bWorldDirty = true;
 	DirectX::XMVECTOR kidPos = kid->VGet().ToWorld().r[3];
 
 	float newRadius = DirectX::XMVectorGetX(DirectX::XMVector3Length(kidPos)) + kid->VGet().Radius();
@@ -234,17 +276,23 @@ void SceneNode::SetPosition3(const DirectX::XMFLOAT3& pos) {
 	m_Props.m_ToWorld.m[3][1] = pos.y;
 	m_Props.m_ToWorld.m[3][2] = pos.z;
 	m_Props.m_ToWorld.m[3][3] = 1.0f;
+	m_bWorldDirty = true;
+}
+
+const DirectX::XMFLOAT4X4& SceneNode::GetWorldTransform4x4() const {
+	return m_WorldTransform;
+}
+
+const DirectX::XMFLOAT4X4& SceneNode::GetWorldInvTransform4x4() const {
+	return m_WorldInvTransform;
+}
+
+void SceneNode::MarkWorldDirty() {
+	m_bWorldDirty = true;
 }
 
 DirectX::XMFLOAT3 SceneNode::GetWorldPosition3() const {
-	DirectX::XMFLOAT3 pos = GetPosition3();
-	if (m_pParent) {
-		DirectX::XMFLOAT3 wp1 = m_pParent->GetWorldPosition3();
-		pos.x += wp1.x;
-		pos.y += wp1.y;
-		pos.z += wp1.z;
-	}
-	return pos;
+	return DirectX::XMFLOAT3(m_WorldTransform.m[3][0], m_WorldTransform.m[3][1], m_WorldTransform.m[3][2]);
 }
 
 DirectX::XMVECTOR SceneNode::GetWorldPosition() const {
@@ -270,6 +318,8 @@ DirectX::XMFLOAT3 SceneNode::GetDirection() const {
 
 void SceneNode::SetRadius(const float radius) {
 	m_Props.m_Radius = radius;
+	// The scene rewrites the culling sphere of dirty nodes
+	m_bWorldDirty = true;
 }
 
 void SceneNode::SetMaterial(const Material& mat) {
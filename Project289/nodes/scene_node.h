@@ -7,9 +7,17 @@
 #include "../actors/actor.h"
 #include "i_scene_node.h"
 #include "../actors/base_render_component.h"
+#include "../actors/component_store.h"
 #include "ray_cast.h"
+#include "spatial_index.h"
 #include "../tools/memory_utility.h"
 
+class TransformComponent;
+class IRenderer;
+class RenderStateCache;
+struct InstanceData;
+struct OccluderMesh;
+
 using SceneNodeList = std::vector<std::shared_ptr<ISceneNode>>;
 
 class SceneNode : public ISceneNode {
@@ -20,6 +28,22 @@ protected:
 	SceneNode* m_pParent;
 	SceneNodeProperties m_Props;
 	WeakBaseRenderComponentPtr m_RenderComponent;
+	ComponentRef<TransformComponent> m_TransformRef;
+
+	// World transform cached by Scene::UpdateTransforms, only recomputed when this node or an ancestor moved.
+	DirectX::XMFLOAT4X4 m_WorldTransform;
+	DirectX::XMFLOAT4X4 m_WorldInvTransform;
+	uint32_t m_TransformRevision = 0u;
+	bool m_bWorldDirty = true;
+	// Slot of the node's bounding sphere in the scene's FrustumCuller.
+	uint32_t m_CullIndex = UINT32_MAX;
+	// Leaf of the scene's SpatialIndex, only actor nodes directly under a render group have one.
+	int m_SpatialProxy = SpatialIndex::sk_NullProxy;
+	// Scene frame index in which the spatial index last found the node inside the frustum.
+	uint32_t m_VisibleFrame = 0u;
+
+	bool SyncTransform();
+	void UpdateWorldTransform(const SceneNode* pParent);
 
 public:
 	SceneNode(WeakBaseRenderComponentPtr renderComponent, RenderPass renderPass, const DirectX::XMFLOAT4X4* to, const DirectX::XMFLOAT4X4* from = nullptr, bool calulate_from = false);
@@ -41,6 +65,19 @@ public:
 	virtual HRESULT VRenderChildren(Scene* pScene) override;
 	virtual HRESULT VPostRender(Scene* pScene) override;
 
+	// Drawables add a packet to the scene's render queue and return true, other nodes are rendered in place.
+	// VSubmit is the queued draw, called once the queue is sorted.
+	virtual bool VQueueRender(Scene* pScene);
+	virtual void VSubmit(IRenderer* pRenderer, RenderStateCache& stateCache);
+	// Draws count instances of this node's mesh, one per element of pInstances, for a run of packets pushed with
+	// the same instance key.
+	virtual void VSubmitInstanced(IRenderer* pRenderer, RenderStateCache& stateCache, const InstanceData* pInstances, UINT count);
+	// Fills in the triangles and returns true when the node is drawn into the scene's occlusion depth buffer. The
+	// world matrix is left to the scene.
+	virtual bool VGetOccluderGeometry(OccluderMesh& occluder) const;
+	// Hierarchy of the node's own triangles in its local space for batched ray casts, null for nodes with none.
+	virtual const MeshBvh* VGetPickBvh();
+
 	virtual bool VAddChild(std::shared_ptr<ISceneNode> kid) override;
 	virtual bool VRemoveChild(ActorId id) override;
 	virtual HRESULT VOnLostDevice(Scene* pScene) override;
@@ -57,6 +94,10 @@ public:
 	DirectX::XMFLOAT3 GetPosition3() const;
 	void SetPosition3(const DirectX::XMFLOAT3& pos);
 
+	const DirectX::XMFLOAT4X4& GetWorldTransform4x4() const;
+	const DirectX::XMFLOAT4X4& GetWorldInvTransform4x4() const;
+	void MarkWorldDirty();
+
 	DirectX::XMFLOAT3 GetWorldPosition3() const;
 	DirectX::XMVECTOR GetWorldPosition() const;
 
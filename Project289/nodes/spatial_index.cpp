@@ -0,0 +1,414 @@
+#include "spatial_index.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+	Aabb Union(const Aabb& a, const Aabb& b) {
+		return {
+			{ std::min(a.m_Min.x, b.m_Min.x), std::min(a.m_Min.y, b.m_Min.y), std::min(a.m_Min.z, b.m_Min.z) },
+			{ std::max(a.m_Max.x, b.m_Max.x), std::max(a.m_Max.y, b.m_Max.y), std::max(a.m_Max.z, b.m_Max.z) }
+		};
+	}
+
+	bool Contains(const Aabb& outer, const Aabb& inner) {
+		return outer.m_Min.x <= inner.m_Min.x && outer.m_Min.y <= inner.m_Min.y && outer.m_Min.z <= inner.m_Min.z
+			&& inner.m_Max.x <= outer.m_Max.x && inner.m_Max.y <= outer.m_Max.y && inner.m_Max.z <= outer.m_Max.z;
+	}
+
+	// Half the surface area, the constant factor does not change which choice is cheaper
+	float Area(const Aabb& box) {
+		float dx = box.m_Max.x - box.m_Min.x;
+		float dy = box.m_Max.y - box.m_Min.y;
+		float dz = box.m_Max.z - box.m_Min.z;
+		return dx * dy + dy * dz + dz * dx;
+	}
+
+	Aabb Fatten(const Aabb& box) {
+		const float m = SpatialIndex::sk_Margin;
+		return { { box.m_Min.x - m, box.m_Min.y - m, box.m_Min.z - m }, { box.m_Max.x + m, box.m_Max.y + m, box.m_Max.z + m } };
+	}
+
+	enum class PlaneTest { Outside, Intersecting, Inside };
+
+	PlaneTest TestPlane(const DirectX::XMFLOAT4& plane, const Aabb& box) {
+		// Farthest corner along the normal decides outside, the nearest one decides fully inside
+		float cx = (box.m_Min.x + box.m_Max.x) * 0.5f;
+		float cy = (box.m_Min.y + box.m_Max.y) * 0.5f;
+		float cz = (box.m_Min.z + box.m_Max.z) * 0.5f;
+		float ex = (box.m_Max.x - box.m_Min.x) * 0.5f;
+		float ey = (box.m_Max.y - box.m_Min.y) * 0.5f;
+		float ez = (box.m_Max.z - box.m_Min.z) * 0.5f;
+		float distance = plane.x * cx + plane.y * cy + plane.z * cz + plane.w;
+		float extent = std::fabs(plane.x) * ex + std::fabs(plane.y) * ey + std::fabs(plane.z) * ez;
+		if (distance + extent < 0.0f) {
+			return PlaneTest::Outside;
+		}
+		return distance - extent >= 0.0f ? PlaneTest::Inside : PlaneTest::Intersecting;
+	}
+}
+
+int SpatialIndex::CreateProxy(const Aabb& box, SceneNode* pNode) {
+	int proxyId = AllocateNode();
+	TreeNode& node = m_Nodes[proxyId];
+	node.m_Box = Fatten(box);
+	node.m_pSceneNode = pNode;
+	node.m_Height = 0;
+	InsertLeaf(proxyId);
+	++m_ProxyCount;
+	return proxyId;
+}
+
+void SpatialIndex::DestroyProxy(int proxyId) {
+	if (proxyId < 0 || proxyId >= static_cast<int>(m_Nodes.size()) || !m_Nodes[proxyId].IsLeaf() || m_Nodes[proxyId].m_Height != 0) {
+		return;
+	}
+	RemoveLeaf(proxyId);
+	FreeNode(proxyId);
+	--m_ProxyCount;
+}
+
+bool SpatialIndex::MoveProxy(int proxyId, const Aabb& box) {
+	if (Contains(m_Nodes[proxyId].m_Box, box)) {
+		return false;
+	}
+	RemoveLeaf(proxyId);
+	m_Nodes[proxyId].m_Box = Fatten(box);
+	InsertLeaf(proxyId);
+	return true;
+}
+
+SceneNode* SpatialIndex::GetSceneNode(int proxyId) const {
+	return m_Nodes[proxyId].m_pSceneNode;
+}
+
+const Aabb& SpatialIndex::GetFatAabb(int proxyId) const {
+	return m_Nodes[proxyId].m_Box;
+}
+
+size_t SpatialIndex::GetProxyCount() const {
+	return m_ProxyCount;
+}
+
+int SpatialIndex::GetHeight() const {
+	return m_Root == sk_NullProxy ? 0 : m_Nodes[m_Root].m_Height;
+}
+
+Aabb SpatialIndex::MakeSphereBox(const DirectX::XMFLOAT3& center, float radius) {
+	return { { center.x - radius, center.y - radius, center.z - radius }, { center.x + radius, center.y + radius, center.z + radius } };
+}
+
+void SpatialIndex::QueryFrustum(const std::array<DirectX::XMFLOAT4, 6>& planes, std::vector<SceneNode*>& results) const {
+	if (m_Root == sk_NullProxy) {
+		return;
+	}
+
+	// Each stack entry carries the planes its parent was not yet fully inside of, a subtree inside all six is
+	// reported without testing any of its boxes
+	std::vector<int>& stack = m_Stack;
+	stack.clear();
+	stack.push_back(m_Root);
+	stack.push_back(0x3F);
+	while (!stack.empty()) {
+		int mask = stack.back();
+		stack.pop_back();
+		int nodeId = stack.back();
+		stack.pop_back();
+		const TreeNode& node = m_Nodes[nodeId];
+
+		bool outside = false;
+		for (int plane = 0; plane < 6 && !outside; ++plane) {
+			if (!(mask & (1 << plane))) {
+				continue;
+			}
+			switch (TestPlane(planes[plane], node.m_Box)) {
+				case PlaneTest::Outside: outside = true; break;
+				case PlaneTest::Inside: mask &= ~(1 << plane); break;
+				case PlaneTest::Intersecting: break;
+			}
+		}
+		if (outside) {
+			continue;
+		}
+
+		if (node.IsLeaf()) {
+			results.push_back(node.m_pSceneNode);
+		}
+		else if (mask == 0) {
+			ReportSubtree(nodeId, results);
+		}
+		else {
+			stack.push_back(node.m_Child1);
+			stack.push_back(mask);
+			stack.push_back(node.m_Child2);
+			stack.push_back(mask);
+		}
+	}
+}
+
+void SpatialIndex::QueryRay(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction, float maxDistance, std::vector<SceneNode*>& results) const {
+	if (m_Root == sk_NullProxy) {
+		return;
+	}
+
+	// Slab test, infinities from zero direction components compare correctly as long as the origin is not on a slab
+	float invX = 1.0f / direction.x;
+	float invY = 1.0f / direction.y;
+	float invZ = 1.0f / direction.z;
+
+	std::vector<int>& stack = m_Stack;
+	stack.clear();
+	stack.push_back(m_Root);
+	while (!stack.empty()) {
+		int nodeId = stack.back();
+		stack.pop_back();
+		const TreeNode& node = m_Nodes[nodeId];
+
+		float tx1 = (node.m_Box.m_Min.x - origin.x) * invX;
+		float tx2 = (node.m_Box.m_Max.x - origin.x) * invX;
+		float ty1 = (node.m_Box.m_Min.y - origin.y) * invY;
+		float ty2 = (node.m_Box.m_Max.y - origin.y) * invY;
+		float tz1 = (node.m_Box.m_Min.z - origin.z) * invZ;
+		float tz2 = (node.m_Box.m_Max.z - origin.z) * invZ;
+		float tNear = std::max(std::max(std::min(tx1, tx2), std::min(ty1, ty2)), std::max(std::min(tz1, tz2), 0.0f));
+		float tFar = std::min(std::min(std::max(tx1, tx2), std::max(ty1, ty2)), std::min(std::max(tz1, tz2), maxDistance));
+		if (!(tNear <= tFar)) {
+			continue;
+		}
+
+		if (node.IsLeaf()) {
+			results.push_back(node.m_pSceneNode);
+		}
+		else {
+			stack.push_back(node.m_Child1);
+			stack.push_back(node.m_Child2);
+		}
+	}
+}
+
+void SpatialIndex::QuerySphere(const DirectX::XMFLOAT3& center, float radius, std::vector<SceneNode*>& results) const {
+	if (m_Root == sk_NullProxy) {
+		return;
+	}
+
+	float radiusSq = radius * radius;
+	std::vector<int>& stack = m_Stack;
+	stack.clear();
+	stack.push_back(m_Root);
+	while (!stack.empty()) {
+		int nodeId = stack.back();
+		stack.pop_back();
+		const TreeNode& node = m_Nodes[nodeId];
+
+		float dx = std::max(std::max(node.m_Box.m_Min.x - center.x, center.x - node.m_Box.m_Max.x), 0.0f);
+		float dy = std::max(std::max(node.m_Box.m_Min.y - center.y, center.y - node.m_Box.m_Max.y), 0.0f);
+		float dz = std::max(std::max(node.m_Box.m_Min.z - center.z, center.z - node.m_Box.m_Max.z), 0.0f);
+		if (dx * dx + dy * dy + dz * dz > radiusSq) {
+			continue;
+		}
+
+		if (node.IsLeaf()) {
+			results.push_back(node.m_pSceneNode);
+		}
+		else {
+			stack.push_back(node.m_Child1);
+			stack.push_back(node.m_Child2);
+		}
+	}
+}
+
+int SpatialIndex::AllocateNode() {
+	int nodeId;
+	if (m_FreeList != sk_NullProxy) {
+		nodeId = m_FreeList;
+		m_FreeList = m_Nodes[nodeId].m_Parent;
+	}
+	else {
+		nodeId = static_cast<int>(m_Nodes.size());
+		m_Nodes.emplace_back();
+	}
+
+	TreeNode& node = m_Nodes[nodeId];
+	node.m_pSceneNode = nullptr;
+	node.m_Parent = sk_NullProxy;
+	node.m_Child1 = sk_NullProxy;
+	node.m_Child2 = sk_NullProxy;
+	node.m_Height = 0;
+	return nodeId;
+}
+
+void SpatialIndex::FreeNode(int nodeId) {
+	TreeNode& node = m_Nodes[nodeId];
+	node.m_pSceneNode = nullptr;
+	node.m_Parent = m_FreeList;
+	node.m_Child1 = sk_NullProxy;
+	node.m_Height = -1;
+	m_FreeList = nodeId;
+}
+
+void SpatialIndex::InsertLeaf(int leaf) {
+	if (m_Root == sk_NullProxy) {
+		m_Root = leaf;
+		m_Nodes[leaf].m_Parent = sk_NullProxy;
+		return;
+	}
+
+	// Walk down towards the child whose box grows the least, stopping where pairing with the current node is cheaper
+	const Aabb leafBox = m_Nodes[leaf].m_Box;
+	int sibling = m_Root;
+	while (!m_Nodes[sibling].IsLeaf()) {
+		const TreeNode& node = m_Nodes[sibling];
+		float area = Area(node.m_Box);
+		float combinedArea = Area(Union(node.m_Box, leafBox));
+		float cost = 2.0f * combinedArea;
+		float inheritanceCost = 2.0f * (combinedArea - area);
+
+		float childCost[2];
+		const int children[2] = { node.m_Child1, node.m_Child2 };
+		for (int i = 0; i < 2; ++i) {
+			const TreeNode& child = m_Nodes[children[i]];
+			float grown = Area(Union(child.m_Box, leafBox));
+			childCost[i] = (child.IsLeaf() ? grown : grown - Area(child.m_Box)) + inheritanceCost;
+		}
+
+		if (cost < childCost[0] && cost < childCost[1]) {
+			break;
+		}
+		sibling = childCost[0] < childCost[1] ? children[0] : children[1];
+	}
+
+	int oldParent = m_Nodes[sibling].m_Parent;
+	int newParent = AllocateNode();
+	TreeNode& parent = m_Nodes[newParent];
+	parent.m_Parent = oldParent;
+	parent.m_Box = Union(leafBox, m_Nodes[sibling].m_Box);
+	parent.m_Height = m_Nodes[sibling].m_Height + 1;
+	parent.m_Child1 = sibling;
+	parent.m_Child2 = leaf;
+	m_Nodes[sibling].m_Parent = newParent;
+	m_Nodes[leaf].m_Parent = newParent;
+
+	if (oldParent == sk_NullProxy) {
+		m_Root = newParent;
+	}
+	else if (m_Nodes[oldParent].m_Child1 == sibling) {
+		m_Nodes[oldParent].m_Child1 = newParent;
+	}
+	else {
+		m_Nodes[oldParent].m_Child2 = newParent;
+	}
+
+	Refit(m_Nodes[leaf].m_Parent);
+}
+
+void SpatialIndex::RemoveLeaf(int leaf) {
+	if (leaf == m_Root) {
+		m_Root = sk_NullProxy;
+		return;
+	}
+
+	// The parent goes away and the sibling takes its place
+	int parent = m_Nodes[leaf].m_Parent;
+	int grandParent = m_Nodes[parent].m_Parent;
+	int sibling = m_Nodes[parent].m_Child1 == leaf ? m_Nodes[parent].m_Child2 : m_Nodes[parent].m_Child1;
+
+	if (grandParent == sk_NullProxy) {
+		m_Root = sibling;
+		m_Nodes[sibling].m_Parent = sk_NullProxy;
+		FreeNode(parent);
+		return;
+	}
+
+	if (m_Nodes[grandParent].m_Child1 == parent) {
+		m_Nodes[grandParent].m_Child1 = sibling;
+	}
+	else {
+		m_Nodes[grandParent].m_Child2 = sibling;
+	}
+	m_Nodes[sibling].m_Parent = grandParent;
+	FreeNode(parent);
+
+	Refit(grandParent);
+}
+
+void SpatialIndex::Refit(int nodeId) {
+	while (nodeId != sk_NullProxy) {
+		nodeId = Balance(nodeId);
+		TreeNode& node = m_Nodes[nodeId];
+		const TreeNode& child1 = m_Nodes[node.m_Child1];
+		const TreeNode& child2 = m_Nodes[node.m_Child2];
+		node.m_Height = 1 + std::max(child1.m_Height, child2.m_Height);
+		node.m_Box = Union(child1.m_Box, child2.m_Box);
+		nodeId = node.m_Parent;
+	}
+}
+
+int SpatialIndex::Balance(int a) {
+	// Rotates the taller child up when the heights differ by more than one, returns the node now at a's place
+	TreeNode& A = m_Nodes[a];
+	if (A.IsLeaf() || A.m_Height < 2) {
+		return a;
+	}
+
+	int b = A.m_Child1;
+	int c = A.m_Child2;
+	int balance = m_Nodes[c].m_Height - m_Nodes[b].m_Height;
+	if (balance >= -1 && balance <= 1) {
+		return a;
+	}
+
+	// Lift the taller child, up, in place of a, and a takes the shorter of up's children
+	int up = balance > 0 ? c : b;
+	int other = balance > 0 ? b : c;
+	TreeNode& Up = m_Nodes[up];
+	int f = Up.m_Child1;
+	int g = Up.m_Child2;
+
+	Up.m_Child1 = a;
+	Up.m_Parent = A.m_Parent;
+	A.m_Parent = up;
+	if (Up.m_Parent == sk_NullProxy) {
+		m_Root = up;
+	}
+	else if (m_Nodes[Up.m_Parent].m_Child1 == a) {
+		m_Nodes[Up.m_Parent].m_Child1 = up;
+	}
+	else {
+		m_Nodes[Up.m_Parent].m_Child2 = up;
+	}
+
+	int keep = m_Nodes[f].m_Height > m_Nodes[g].m_Height ? f : g;
+	int give = keep == f ? g : f;
+	Up.m_Child2 = keep;
+	if (balance > 0) {
+		A.m_Child2 = give;
+	}
+	else {
+		A.m_Child1 = give;
+	}
+	m_Nodes[give].m_Parent = a;
+
+	A.m_Box = Union(m_Nodes[other].m_Box, m_Nodes[give].m_Box);
+	A.m_Height = 1 + std::max(m_Nodes[other].m_Height, m_Nodes[give].m_Height);
+	Up.m_Box = Union(A.m_Box, m_Nodes[keep].m_Box);
+	Up.m_Height = 1 + std::max(A.m_Height, m_Nodes[keep].m_Height);
+	return up;
+}
+
+void SpatialIndex::ReportSubtree(int nodeId, std::vector<SceneNode*>& results) const {
+	// Runs on top of the caller's entries in the shared stack and leaves them as they were
+	std::vector<int>& stack = m_Stack;
+	size_t base = stack.size();
+	stack.push_back(nodeId);
+	while (stack.size() > base) {
+		const TreeNode& node = m_Nodes[stack.back()];
+		stack.pop_back();
+		if (node.IsLeaf()) {
+			results.push_back(node.m_pSceneNode);
+		}
+		else {
+			stack.push_back(node.m_Child1);
+			stack.push_back(node.m_Child2);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <DirectXMath.h>
+
+class SceneNode;
+
+struct Aabb {
+	DirectX::XMFLOAT3 m_Min;
+	DirectX::XMFLOAT3 m_Max;
+};
+
+// Dynamic AABB tree over scene nodes. Leaves hold a box fattened by a margin, so a node moving a little stays in
+// its leaf and only a move out of the fat box costs a remove and reinsert. Inserts pick the sibling with the least
+// surface area growth and rotations keep the tree balanced. Queries descend only into boxes that overlap, so their
+// cost follows the number of nodes near the query instead of the size of the level. Not thread safe.
+class SpatialIndex {
+public:
+	static constexpr int sk_NullProxy = -1;
+	static constexpr float sk_Margin = 0.5f;
+
+	int CreateProxy(const Aabb& box, SceneNode* pNode);
+	void DestroyProxy(int proxyId);
+	// Returns true when the box left the fat box and the leaf was reinserted.
+	bool MoveProxy(int proxyId, const Aabb& box);
+
+	SceneNode* GetSceneNode(int proxyId) const;
+	const Aabb& GetFatAabb(int proxyId) const;
+	size_t GetProxyCount() const;
+	int GetHeight() const;
+
+	// The query functions append the nodes whose fat box passes the test, in no particular order.
+	// Planes point inwards, as built by FrustumCuller::SetPlanes.
+	void QueryFrustum(const std::array<DirectX::XMFLOAT4, 6>& planes, std::vector<SceneNode*>& results) const;
+	void QueryRay(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction, float maxDistance, std::vector<SceneNode*>& results) const;
+	void QuerySphere(const DirectX::XMFLOAT3& center, float radius, std::vector<SceneNode*>& results) const;
+
+	static Aabb MakeSphereBox(const DirectX::XMFLOAT3& center, float radius);
+
+private:
+	struct TreeNode {
+		Aabb m_Box;
+		SceneNode* m_pSceneNode;
+		// Next free node while the node is on the free list
+		int m_Parent;
+		int m_Child1;
+		int m_Child2;
+		// Leaves are 0, free nodes -1
+		int m_Height;
+
+		bool IsLeaf() const { return m_Child1 == sk_NullProxy; }
+	};
+
+	int AllocateNode();
+	void FreeNode(int nodeId);
+	void InsertLeaf(int leaf);
+	void RemoveLeaf(int leaf);
+	int Balance(int nodeId);
+	void Refit(int nodeId);
+	void ReportSubtree(int nodeId, std::vector<SceneNode*>& results) const;
+
+	std::vector<TreeNode> m_Nodes;
+	int m_Root = sk_NullProxy;
+	int m_FreeList = sk_NullProxy;
+	size_t m_ProxyCount = 0u;
+	mutable std::vector<int> m_Stack;
+};
\ No newline at end of file
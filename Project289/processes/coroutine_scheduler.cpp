@@ -0,0 +1,135 @@
+#include "coroutine_scheduler.h"
+
+#include "process_manager.h"
+#include "../events/i_event_manager.h"
+
+CoroutineScheduler::CoroutineScheduler(ProcessManager& owner) : m_pArena(std::make_shared<SizeClassArena>()), m_owner(owner), m_time(0.0), m_timerSequence(0u) {}
+
+CoroutineScheduler::~CoroutineScheduler() {
+	AbortAll();
+
+	IEventManager* pEventManager = IEventManager::Get();
+	if (pEventManager) {
+		for (EventTypeId type : m_listenedEvents) {
+			pEventManager->VRemoveListener({ connect_arg<&CoroutineScheduler::EventDelegate>, this }, type);
+		}
+	}
+}
+
+void CoroutineScheduler::Attach(ProcessTask task) {
+	Handle handle = task.Release();
+	if (!handle) { return; }
+
+	handle.promise().pScheduler = this;
+	handle.promise().liveIndex = m_live.size();
+	m_live.push_back(handle);
+	m_ready.push_back(handle);
+}
+
+void CoroutineScheduler::Update(float deltaMs) {
+	m_time += deltaMs;
+
+	m_resuming.clear();
+	while (!m_timers.empty() && m_timers.top().wakeTime <= m_time) {
+		m_resuming.push_back(m_timers.top().handle);
+		m_timers.pop();
+	}
+	m_resuming.insert(m_resuming.end(), m_ready.begin(), m_ready.end());
+	m_ready.clear();
+
+	for (Handle handle : m_resuming) {
+		Resume(handle);
+	}
+	m_resuming.clear();
+}
+
+void CoroutineScheduler::AbortAll() {
+	m_ready.clear();
+	m_resuming.clear();
+	m_timers = decltype(m_timers)();
+	m_eventWaiters.clear();
+	m_processWaiters.clear();
+
+	for (Handle handle : m_live) {
+		handle.destroy();
+	}
+	m_live.clear();
+}
+
+void CoroutineScheduler::OnProcessFinished(Process* pProcess, bool succeeded) {
+	auto findIt = m_processWaiters.find(pProcess);
+	if (findIt == m_processWaiters.end()) { return; }
+
+	Handle handle = findIt->second;
+	m_processWaiters.erase(findIt);
+	handle.promise().childSucceeded = succeeded;
+	m_ready.push_back(handle);
+}
+
+void CoroutineScheduler::OnProcessChained(Process* pFinished, Process* pChild) {
+	auto findIt = m_processWaiters.find(pFinished);
+	if (findIt == m_processWaiters.end()) { return; }
+
+	Handle handle = findIt->second;
+	m_processWaiters.erase(findIt);
+	m_processWaiters[pChild] = handle;
+}
+
+size_t CoroutineScheduler::GetCoroutineCount() const {
+	return m_live.size();
+}
+
+size_t CoroutineScheduler::GetReadyCount() const {
+	return m_ready.size();
+}
+
+const std::shared_ptr<SizeClassArena>& CoroutineScheduler::GetArena() const {
+	return m_pArena;
+}
+
+void CoroutineScheduler::ScheduleNextFrame(Handle handle) {
+	m_ready.push_back(handle);
+}
+
+void CoroutineScheduler::ScheduleAfter(float seconds, Handle handle) {
+	m_timers.push({ m_time + seconds, m_timerSequence++, handle });
+}
+
+void CoroutineScheduler::WaitForEvent(EventTypeId type, Handle handle) {
+	m_eventWaiters[type].push_back(handle);
+	if (m_listenedEvents.insert(type).second) {
+		IEventManager::Get()->VAddListener({ connect_arg<&CoroutineScheduler::EventDelegate>, this }, type);
+	}
+}
+
+void CoroutineScheduler::WaitForProcess(StrongProcessPtr pProcess, Handle handle) {
+	m_processWaiters[pProcess.get()] = handle;
+	m_owner.AttachProcess(pProcess);
+}
+
+void CoroutineScheduler::EventDelegate(IEventDataPtr pEventData) {
+	auto findIt = m_eventWaiters.find(pEventData->VGetEventType());
+	if (findIt == m_eventWaiters.end()) { return; }
+
+	for (Handle handle : findIt->second) {
+		handle.promise().pWakeEvent = pEventData;
+		m_ready.push_back(handle);
+	}
+	findIt->second.clear();
+}
+
+void CoroutineScheduler::Resume(Handle handle) {
+	handle.resume();
+	if (handle.done()) {
+		Destroy(handle);
+	}
+}
+
+void CoroutineScheduler::Destroy(Handle handle) {
+	size_t index = handle.promise().liveIndex;
+	Handle last = m_live.back();
+	m_live[index] = last;
+	last.promise().liveIndex = index;
+	m_live.pop_back();
+	handle.destroy();
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "process_task.h"
+#include "../tools/size_class_arena.h"
+
+class ProcessManager;
+
+// Owns the coroutine frames of one ProcessManager and resumes a coroutine only when what it awaits has happened:
+// sleepers sit in a timer heap, event and child-process waiters in lookup tables, so idle coroutines cost nothing per frame.
+class CoroutineScheduler {
+public:
+	using Handle = ProcessTask::Handle;
+
+	explicit CoroutineScheduler(ProcessManager& owner);
+	~CoroutineScheduler();
+
+	void Attach(ProcessTask task);
+	void Update(float deltaMs);
+	void AbortAll();
+
+	void OnProcessFinished(Process* pProcess, bool succeeded);
+	void OnProcessChained(Process* pFinished, Process* pChild);
+
+	size_t GetCoroutineCount() const;
+	size_t GetReadyCount() const;
+	// Shared with every frame allocated from it, a task that is never attached can outlive the scheduler.
+	const std::shared_ptr<SizeClassArena>& GetArena() const;
+
+	void ScheduleNextFrame(Handle handle);
+	void ScheduleAfter(float seconds, Handle handle);
+	void WaitForEvent(EventTypeId type, Handle handle);
+	void WaitForProcess(StrongProcessPtr pProcess, Handle handle);
+
+private:
+	struct Timer {
+		double wakeTime;
+		uint64_t sequence;
+		Handle handle;
+	};
+
+	struct TimerLater {
+		bool operator()(const Timer& lhs, const Timer& rhs) const {
+			return lhs.wakeTime > rhs.wakeTime || (lhs.wakeTime == rhs.wakeTime && lhs.sequence > rhs.sequence);
+		}
+	};
+
+	void EventDelegate(IEventDataPtr pEventData);
+	void Resume(Handle handle);
+	void Destroy(Handle handle);
+
+	std::shared_ptr<SizeClassArena> m_pArena;
+	ProcessManager& m_owner;
+
+	std::vector<Handle> m_live;
+	std::vector<Handle> m_ready;
+	std::vector<Handle> m_resuming;
+	std::priority_queue<Timer, std::vector<Timer>, TimerLater> m_timers;
+	std::unordered_map<EventTypeId, std::vector<Handle>> m_eventWaiters;
+	std::unordered_set<EventTypeId> m_listenedEvents;
+	std::unordered_map<Process*, Handle> m_processWaiters;
+
+	double m_time;
+	uint64_t m_timerSequence;
+};
@@ -10,8 +10,11 @@
 class DelayProcess : public Process {
 public:
 	DelayProcess(float delay_in_seconds, std::function<bool(float dt, float tt, float n)> fn);
+	// Without a callback the process sleeps for the whole delay instead of ticking every frame.
+	explicit DelayProcess(float delay_in_seconds);
 
 protected:
+	virtual void VOnInit() override;
 	virtual void VOnUpdate(float deltaMs) override;
 
 private:
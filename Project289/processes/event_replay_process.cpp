@@ -0,0 +1,102 @@
+#include "event_replay_process.h"
+
+#include <fstream>
+#include <iterator>
+
+#include "../events/i_event_manager.h"
+#include "../events/event_recorder.h"
+
+EventReplayProcess::EventReplayProcess(const std::string& fileName, float speed) : m_fileName(fileName), m_speed(speed) {}
+
+size_t EventReplayProcess::GetInjectedCount() const {
+	return m_injectedCount;
+}
+
+size_t EventReplayProcess::GetSkippedCount() const {
+	return m_skippedCount;
+}
+
+void EventReplayProcess::VOnInit() {
+	Process::VOnInit();
+	if (!LoadFile()) {
+		Fail();
+		return;
+	}
+	m_hasRecord = ReadNextRecord();
+}
+
+void EventReplayProcess::VOnUpdate(float deltaMs) {
+	if (m_speed > 0.0f) {
+		m_playTimeUs += static_cast<double>(deltaMs) * m_speed * 1000000.0;
+	}
+
+	while (m_hasRecord && (m_speed <= 0.0f || static_cast<double>(m_recordTimeUs) <= m_playTimeUs)) {
+		InjectCurrentRecord();
+		m_hasRecord = ReadNextRecord();
+	}
+
+	if (!m_hasRecord) {
+		// A file cut off mid record did not replay the whole session
+		if (m_truncated) {
+			Fail();
+		}
+		else {
+			Succeed();
+		}
+	}
+}
+
+bool EventReplayProcess::LoadFile() {
+	std::ifstream file(m_fileName, std::ios::in | std::ios::binary);
+	if (!file.is_open()) {
+		return false;
+	}
+	m_data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+	BinaryReader header(m_data.data(), m_data.size());
+	uint32_t magic = header.ReadU32();
+	uint16_t version = header.ReadU16();
+	header.ReadU16();
+	if (!header.IsGood() || magic != EVENT_RECORD_MAGIC || version != EVENT_RECORD_VERSION) {
+		return false;
+	}
+
+	m_readPos = header.GetPosition();
+	return true;
+}
+
+bool EventReplayProcess::ReadNextRecord() {
+	if (m_readPos >= m_data.size()) {
+		return false;
+	}
+
+	BinaryReader reader(m_data.data() + m_readPos, m_data.size() - m_readPos);
+	m_recordType = static_cast<unsigned long>(reader.ReadVarint());
+	m_recordTimeUs = reader.ReadVarint();
+	m_recordPayloadSize = static_cast<size_t>(reader.ReadVarint());
+	if (!reader.IsGood() || reader.GetRemaining() < m_recordPayloadSize) {
+		m_truncated = true;
+		return false;
+	}
+
+	m_pRecordPayload = m_data.data() + m_readPos + reader.GetPosition();
+	m_readPos += reader.GetPosition() + m_recordPayloadSize;
+	return true;
+}
+
+void EventReplayProcess::InjectCurrentRecord() {
+	IEventDataPtr pEvent = IsEventReplayable(m_recordType) ? IEventManager::Create(m_recordType) : nullptr;
+	if (!pEvent) {
+		++m_skippedCount;
+		return;
+	}
+
+	BinaryReader payload(m_pRecordPayload, m_recordPayloadSize);
+	pEvent->VDeserializeBinary(payload);
+	if (!payload.IsGood() || !IEventManager::Get()->VQueueEvent(pEvent)) {
+		++m_skippedCount;
+		return;
+	}
+
+	++m_injectedCount;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "process.h"
+#include "../tools/binary_stream.h"
+
+class EventReplayProcess : public Process {
+public:
+	// speed scales the recorded timeline, speed <= 0 injects the whole stream on the first update.
+	EventReplayProcess(const std::string& fileName, float speed = 1.0f);
+
+	size_t GetInjectedCount() const;
+	size_t GetSkippedCount() const;
+
+protected:
+	virtual void VOnInit() override;
+	virtual void VOnUpdate(float deltaMs) override;
+
+private:
+	bool LoadFile();
+	// False at the end of the stream, and for a record cut short, which also sets m_truncated.
+	bool ReadNextRecord();
+	void InjectCurrentRecord();
+
+	std::string m_fileName;
+	float m_speed;
+	double m_playTimeUs = 0.0;
+
+	std::vector<uint8_t> m_data;
+	size_t m_readPos = 0u;
+
+	bool m_hasRecord = false;
+	unsigned long m_recordType = 0u;
+	uint64_t m_recordTimeUs = 0u;
+	const uint8_t* m_pRecordPayload = nullptr;
+	size_t m_recordPayloadSize = 0u;
+	bool m_truncated = false;
+
+	size_t m_injectedCount = 0u;
+	size_t m_skippedCount = 0u;
+};
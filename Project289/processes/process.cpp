@@ -1,6 +1,7 @@
 #include "process.h"
+#include "process_manager.h"
 
-Process::Process() {
+Process::Process() : m_pManager(nullptr), m_slot(0u), m_bucketIndex(0u), m_sleepTicket(0u), m_sleepSeconds(0.0f), m_parked(false) {
 	m_state = State::UNINITIALIZED;
 }
 
@@ -24,6 +25,10 @@ std::shared_ptr<Process> Process::PeekChild() {
 	return m_pChild;
 }
 
+bool Process::VIsParallelSafe() const {
+	return false;
+}
+
 void Process::VOnInit() {
 	m_state = State::RUNNING;
 }
@@ -36,14 +41,17 @@ void Process::VOnAbort() {}
 
 void Process::SetState(State newState) {
 	m_state = newState;
+	if (m_parked && m_pManager) {
+		m_pManager->UnparkProcess(*this);
+	}
 }
 
 void Process::Succeed() {
-	m_state = State::SUCCEEDED;
+	SetState(State::SUCCEEDED);
 }
 
 void Process::Fail() {
-	m_state = State::FAILED;
+	SetState(State::FAILED);
 }
 
 void Process::AttachChild(std::shared_ptr<Process> pChild) {
@@ -55,12 +63,24 @@ void Process::AttachChild(std::shared_ptr<Process> pChild) {
 
 void Process::Pause() {
 	if (m_state == State::RUNNING)
-		m_state = State::PAUSED;
+		SetState(State::PAUSED);
 }
 
 void Process::UnPause() {
 	if (m_state == State::PAUSED)
-		m_state = State::RUNNING;
+		SetState(State::RUNNING);
+}
+
+void Process::Sleep(float seconds) {
+	if (m_state == State::RUNNING) {
+		m_sleepSeconds = seconds;
+		SetState(State::SLEEPING);
+	}
+}
+
+void Process::Wake() {
+	if (m_state == State::SLEEPING)
+		SetState(State::RUNNING);
 }
 
 Process::State Process::GetState() const {
@@ -68,7 +88,7 @@ Process::State Process::GetState() const {
 }
 
 bool Process::IsAlive() const {
-	return (m_state == State::RUNNING || m_state == State::PAUSED);
+	return (m_state == State::RUNNING || m_state == State::PAUSED || m_state == State::SLEEPING);
 }
 
 bool Process::IsDead() const {
@@ -82,3 +102,7 @@ bool Process::IsRemoved() const {
 bool Process::IsPaused() const {
 	return m_state == State::PAUSED;
 }
+
+bool Process::IsSleeping() const {
+	return m_state == State::SLEEPING;
+}
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 
 class Process;
+class ProcessManager;
 typedef std::shared_ptr<Process> StrongProcessPtr;
 typedef std::weak_ptr<Process> WeakProcessPtr;
 
@@ -13,6 +16,7 @@ public:
 		REMOVED,
 		RUNNING,
 		PAUSED,
+		SLEEPING,
 		SUCCEEDED,
 		FAILED,
 		ABORTED
@@ -27,16 +31,24 @@ public:
 	void Pause();
 	void UnPause();
 
+	// Parks a running process in the manager's timer heap; VOnUpdate is not called again until the time has passed or Wake() is called.
+	void Sleep(float seconds);
+	void Wake();
+
 	State GetState() const;
 	bool IsAlive() const;
 	bool IsDead() const;
 	bool IsRemoved() const;
 	bool IsPaused() const;
+	bool IsSleeping() const;
 
 	void AttachChild(std::shared_ptr<Process> pChild);
 	std::shared_ptr<Process> RemoveChild();
 	std::shared_ptr<Process> PeekChild();
 
+	// Return true when VOnUpdate only touches this process' own state, so it may run on a worker thread alongside other processes.
+	virtual bool VIsParallelSafe() const;
+
 protected:
 	virtual void VOnInit();
 	virtual void VOnUpdate(float deltaMs) = 0;
@@ -47,8 +59,15 @@ protected:
 private:
 	void SetState(State newState);
 
-	State m_state;
+	std::atomic<State> m_state;
 	std::shared_ptr<Process> m_pChild;
 
+	ProcessManager* m_pManager;
+	uint32_t m_slot;
+	uint32_t m_bucketIndex;
+	uint32_t m_sleepTicket;
+	float m_sleepSeconds;
+	std::atomic<bool> m_parked;
+
 	friend class ProcessManager;
 };
\ No newline at end of file
@@ -1,4 +1,12 @@
 #include "process_manager.h"
+#include "coroutine_scheduler.h"
+#include "../tools/job_system.h"
+
+#include <algorithm>
+
+ProcessManager::ProcessManager(JobSystem* pJobSystem) : m_sleepingCount(0u), m_time(0.0), m_sleepSequence(0u), m_pJobSystem(pJobSystem) {
+    m_pCoroutineScheduler = std::make_unique<CoroutineScheduler>(*this);
+}
 
 ProcessManager::~ProcessManager(void) {
     ClearAllProcesses();
@@ -8,81 +16,267 @@ unsigned int ProcessManager::UpdateProcesses(float deltaMs) {
     unsigned short int successCount = 0;
     unsigned short int failCount = 0;
 
-    ProcessList::iterator it = m_processList.begin();
-    while (it != m_processList.end()) {
-        std::shared_ptr<Process> pCurrProcess = (*it);
+    m_time += deltaMs;
+    WakeSleepers();
 
-        ProcessList::iterator thisIt = it;
-        ++it;
+    size_t firstIncoming = m_active.size();
+    FlushIncoming();
+    for (size_t i = firstIncoming; i < m_active.size(); ++i) {
+        Process& process = *m_slots[m_active[i]].pProcess;
+        if (process.GetState() == Process::State::UNINITIALIZED) {
+            process.VOnInit();
+        }
+    }
 
-        if (pCurrProcess->GetState() == Process::State::UNINITIALIZED) {
-            pCurrProcess->VOnInit();
+    // Parallel-safe processes are fanned out to the job system while the rest update here on the calling thread.
+    JobCounter parallelCounter;
+    m_parallelBatch.clear();
+    if (m_pJobSystem) {
+        for (uint32_t slot : m_active) {
+            Process* pProcess = m_slots[slot].pProcess.get();
+            if (pProcess->GetState() == Process::State::RUNNING && pProcess->VIsParallelSafe()) {
+                m_parallelBatch.push_back(pProcess);
+            }
+        }
+        for (Process* pParallelProcess : m_parallelBatch) {
+            m_pJobSystem->Submit([pParallelProcess, deltaMs]() { pParallelProcess->VOnUpdate(deltaMs); }, parallelCounter);
         }
+    }
 
-        if (pCurrProcess->GetState() == Process::State::RUNNING) {
-            pCurrProcess->VOnUpdate(deltaMs);
+    for (size_t i = 0; i < m_active.size(); ++i) {
+        Process& process = *m_slots[m_active[i]].pProcess;
+        if (m_pJobSystem && process.VIsParallelSafe()) {
+            continue;
         }
+        if (process.GetState() == Process::State::RUNNING) {
+            process.VOnUpdate(deltaMs);
+        }
+    }
 
-        if (pCurrProcess->IsDead()) {
-            switch (pCurrProcess->GetState()) {
-                case Process::State::SUCCEEDED: {
-                    pCurrProcess->VOnSuccess();
-                    std::shared_ptr<Process> pChild = pCurrProcess->RemoveChild();
-                    if (pChild) {
-                        AttachProcess(pChild);
-                    }
-                    else {
-                        ++successCount;
-                    }
-                }
-                break;
-
-                case Process::State::FAILED: {
-                    pCurrProcess->VOnFail();
-                    ++failCount;
-                }
-                break;
-
-                case Process::State::ABORTED: {
-                    pCurrProcess->VOnAbort();
-                    ++failCount;
-                    break;
-                }
-            }
+    if (m_pJobSystem) {
+        m_pJobSystem->Wait(parallelCounter);
+    }
 
-            m_processList.erase(thisIt);
+    // Compact the running bucket in place so survivors keep their attach order.
+    size_t writeIndex = 0;
+    for (size_t readIndex = 0; readIndex < m_active.size(); ++readIndex) {
+        uint32_t slot = m_active[readIndex];
+        if (SettleProcess(*m_slots[slot].pProcess, successCount, failCount)) {
+            m_active[writeIndex++] = slot;
         }
     }
+    m_active.resize(writeIndex);
+
+    m_pCoroutineScheduler->Update(deltaMs);
 
     return ((successCount << 16) | failCount);
 }
 
+bool ProcessManager::SettleProcess(Process& process, unsigned short int& successCount, unsigned short int& failCount) {
+    switch (process.GetState()) {
+        case Process::State::PAUSED:
+        case Process::State::SLEEPING:
+            ParkProcess(process);
+            return false;
+
+        case Process::State::SUCCEEDED:
+        case Process::State::FAILED:
+        case Process::State::ABORTED:
+            break;
+
+        default:
+            return true;
+    }
+
+    std::shared_ptr<Process> pCurrProcess = m_slots[process.m_slot].pProcess;
+    switch (pCurrProcess->GetState()) {
+        case Process::State::SUCCEEDED: {
+            pCurrProcess->VOnSuccess();
+            std::shared_ptr<Process> pChild = pCurrProcess->RemoveChild();
+            if (pChild) {
+                AttachProcess(pChild);
+                m_pCoroutineScheduler->OnProcessChained(pCurrProcess.get(), pChild.get());
+            }
+            else {
+                ++successCount;
+                m_pCoroutineScheduler->OnProcessFinished(pCurrProcess.get(), true);
+            }
+        }
+        break;
+
+        case Process::State::FAILED: {
+            pCurrProcess->VOnFail();
+            ++failCount;
+            m_pCoroutineScheduler->OnProcessFinished(pCurrProcess.get(), false);
+        }
+        break;
+
+        case Process::State::ABORTED: {
+            pCurrProcess->VOnAbort();
+            ++failCount;
+            m_pCoroutineScheduler->OnProcessFinished(pCurrProcess.get(), false);
+            break;
+        }
+    }
+
+    ReleaseSlot(pCurrProcess->m_slot);
+    return false;
+}
+
+void ProcessManager::WakeSleepers() {
+    while (!m_sleeping.empty() && m_sleeping.top().wakeTime <= m_time) {
+        SleepEntry entry = m_sleeping.top();
+        m_sleeping.pop();
+
+        ProcessSlot& processSlot = m_slots[entry.slot];
+        if (processSlot.generation != entry.generation || !processSlot.pProcess) {
+            continue;
+        }
+        Process& process = *processSlot.pProcess;
+        if (!process.m_parked || process.m_sleepTicket != entry.ticket) {
+            continue;
+        }
+
+        process.m_parked = false;
+        process.m_state = Process::State::RUNNING;
+        --m_sleepingCount;
+        m_incoming.push_back(entry.slot);
+    }
+}
+
+void ProcessManager::FlushIncoming() {
+    m_active.insert(m_active.end(), m_incoming.begin(), m_incoming.end());
+    m_incoming.clear();
+}
+
+void ProcessManager::ParkProcess(Process& process) {
+    if (process.GetState() == Process::State::PAUSED) {
+        process.m_bucketIndex = static_cast<uint32_t>(m_paused.size());
+        m_paused.push_back(process.m_slot);
+    }
+    else {
+        m_sleeping.push({ m_time + process.m_sleepSeconds, m_sleepSequence++, process.m_slot, m_slots[process.m_slot].generation, ++process.m_sleepTicket });
+        ++m_sleepingCount;
+    }
+    process.m_parked = true;
+}
+
+void ProcessManager::UnparkProcess(Process& process) {
+    std::lock_guard<std::mutex> lock(m_unparkMutex);
+    if (!process.m_parked.exchange(false)) {
+        return;
+    }
+    if (process.m_bucketIndex < m_paused.size() && m_paused[process.m_bucketIndex] == process.m_slot) {
+        uint32_t movedSlot = m_paused.back();
+        m_paused[process.m_bucketIndex] = movedSlot;
+        m_slots[movedSlot].pProcess->m_bucketIndex = process.m_bucketIndex;
+        m_paused.pop_back();
+    }
+    else {
+        // The heap entry goes stale and is dropped when it surfaces.
+        ++process.m_sleepTicket;
+        --m_sleepingCount;
+    }
+    m_incoming.push_back(process.m_slot);
+}
+
+void ProcessManager::ReleaseSlot(uint32_t slot) {
+    ProcessSlot& processSlot = m_slots[slot];
+    processSlot.pProcess->m_pManager = nullptr;
+    processSlot.pProcess->m_parked = false;
+    processSlot.pProcess.reset();
+    ++processSlot.generation;
+    m_freeSlots.push_back(slot);
+}
+
 std::weak_ptr<Process> ProcessManager::AttachProcess(std::shared_ptr<Process> pProcess) {
-    m_processList.push_front(pProcess);
+    uint32_t slot;
+    if (!m_freeSlots.empty()) {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    else {
+        slot = static_cast<uint32_t>(m_slots.size());
+        m_slots.emplace_back();
+    }
+
+    m_slots[slot].pProcess = pProcess;
+    pProcess->m_pManager = this;
+    pProcess->m_slot = slot;
+    pProcess->m_parked = false;
+    m_incoming.push_back(slot);
     return std::weak_ptr<Process>(pProcess);
 }
 
+void ProcessManager::AttachCoroutine(ProcessTask task) {
+    m_pCoroutineScheduler->Attach(std::move(task));
+}
+
 void ProcessManager::ClearAllProcesses(void) {
-    m_processList.clear();
+    for (ProcessSlot& processSlot : m_slots) {
+        if (processSlot.pProcess) {
+            processSlot.pProcess->m_pManager = nullptr;
+            processSlot.pProcess->m_parked = false;
+        }
+    }
+    m_slots.clear();
+    m_freeSlots.clear();
+    m_active.clear();
+    m_paused.clear();
+    m_incoming.clear();
+    m_sleeping = {};
+    m_sleepingCount = 0u;
 }
 
 void ProcessManager::AbortAllProcesses(bool immediate) {
-    ProcessList::iterator it = m_processList.begin();
-    while (it != m_processList.end()) {
-        ProcessList::iterator tempIt = it;
-        ++it;
-
-        std::shared_ptr<Process> pProcess = *tempIt;
-        if (pProcess->IsAlive()) {
+    for (uint32_t slot = 0; slot < m_slots.size(); ++slot) {
+        std::shared_ptr<Process> pProcess = m_slots[slot].pProcess;
+        if (pProcess && pProcess->IsAlive()) {
             pProcess->SetState(Process::State::ABORTED);
             if (immediate) {
                 pProcess->VOnAbort();
-                m_processList.erase(tempIt);
+                ReleaseSlot(slot);
             }
         }
     }
+
+    if (immediate) {
+        auto isReleased = [this](uint32_t slot) { return !m_slots[slot].pProcess; };
+        m_active.erase(std::remove_if(m_active.begin(), m_active.end(), isReleased), m_active.end());
+        m_incoming.erase(std::remove_if(m_incoming.begin(), m_incoming.end(), isReleased), m_incoming.end());
+    }
+
+    m_pCoroutineScheduler->AbortAll();
 }
 
 size_t ProcessManager::GetProcessCount() const {
-    return m_processList.size();
+    return m_slots.size() - m_freeSlots.size();
+}
+
+size_t ProcessManager::GetActiveProcessCount() const {
+    return m_active.size() + m_incoming.size();
+}
+
+size_t ProcessManager::GetPausedProcessCount() const {
+    return m_paused.size();
+}
+
+size_t ProcessManager::GetSleepingProcessCount() const {
+    return m_sleepingCount;
+}
+
+size_t ProcessManager::GetCoroutineCount() const {
+    return m_pCoroutineScheduler->GetCoroutineCount();
+}
+
+const std::shared_ptr<SizeClassArena>& ProcessManager::GetCoroutineArena() const {
+    return m_pCoroutineScheduler->GetArena();
+}
+
+void ProcessManager::SetJobSystem(JobSystem* pJobSystem) {
+    m_pJobSystem = pJobSystem;
+}
+
+JobSystem* ProcessManager::GetJobSystem() const {
+    return m_pJobSystem;
 }
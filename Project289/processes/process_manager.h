@@ -1,23 +1,82 @@
 #pragma once
 
-#include <list>
+#include <cstdint>
+#include <mutex>
+#include <queue>
+#include <vector>
 
 #include "process.h"
+#include "process_task.h"
 
+class JobSystem;
+class CoroutineScheduler;
+class SizeClassArena;
+
+// Processes live in a slot map; the per-frame loops only walk the dense array of running slots.
+// Paused processes sit in their own bucket and sleeping ones in a timer heap, so neither costs anything until they are woken.
 class ProcessManager {
-	typedef std::list<std::shared_ptr<Process>> ProcessList;
+	struct ProcessSlot {
+		StrongProcessPtr pProcess;
+		uint32_t generation = 0u;
+	};
+
+	struct SleepEntry {
+		double wakeTime;
+		uint64_t sequence;
+		uint32_t slot;
+		uint32_t generation;
+		uint32_t ticket;
+	};
+
+	struct SleepLater {
+		bool operator()(const SleepEntry& lhs, const SleepEntry& rhs) const {
+			return lhs.wakeTime > rhs.wakeTime || (lhs.wakeTime == rhs.wakeTime && lhs.sequence > rhs.sequence);
+		}
+	};
 
-	ProcessList m_processList;
+	std::vector<ProcessSlot> m_slots;
+	std::vector<uint32_t> m_freeSlots;
+	std::vector<uint32_t> m_active;
+	std::vector<uint32_t> m_paused;
+	std::vector<uint32_t> m_incoming;
+	// Parallel-safe processes may wake or unpause a parked process from a worker thread.
+	std::mutex m_unparkMutex;
+	std::priority_queue<SleepEntry, std::vector<SleepEntry>, SleepLater> m_sleeping;
+	size_t m_sleepingCount;
+	double m_time;
+	uint64_t m_sleepSequence;
+
+	JobSystem* m_pJobSystem;
+	std::vector<Process*> m_parallelBatch;
+	std::unique_ptr<CoroutineScheduler> m_pCoroutineScheduler;
 
 public:
+	explicit ProcessManager(JobSystem* pJobSystem = nullptr);
 	~ProcessManager();
 
 	unsigned int UpdateProcesses(float deltaMs);
 	std::weak_ptr<Process> AttachProcess(std::shared_ptr<Process> pProcess);
+	void AttachCoroutine(ProcessTask task);
 	void AbortAllProcesses(bool immediate);
 
 	size_t GetProcessCount() const;
+	size_t GetActiveProcessCount() const;
+	size_t GetPausedProcessCount() const;
+	size_t GetSleepingProcessCount() const;
+	size_t GetCoroutineCount() const;
+	const std::shared_ptr<SizeClassArena>& GetCoroutineArena() const;
+
+	void SetJobSystem(JobSystem* pJobSystem);
+	JobSystem* GetJobSystem() const;
 
 private:
 	void ClearAllProcesses();
-};
\ No newline at end of file
+	void WakeSleepers();
+	void FlushIncoming();
+	bool SettleProcess(Process& process, unsigned short int& successCount, unsigned short int& failCount);
+	void ParkProcess(Process& process);
+	void UnparkProcess(Process& process);
+	void ReleaseSlot(uint32_t slot);
+
+	friend class Process;
+};
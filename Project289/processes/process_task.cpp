@@ -0,0 +1,84 @@
+#include "process_task.h"
+
+#include <cstdint>
+#include <new>
+
+#include "process_manager.h"
+#include "coroutine_scheduler.h"
+#include "../tools/size_class_arena.h"
+
+namespace {
+	using ArenaRef = std::shared_ptr<SizeClassArena>;
+
+	// The header holds a reference to the arena so the frame can be freed after its manager is gone, and keeps
+	// max_align_t alignment for the frame that follows it.
+	constexpr size_t FRAME_HEADER_SIZE = (sizeof(ArenaRef) + alignof(std::max_align_t) - 1u) / alignof(std::max_align_t) * alignof(std::max_align_t);
+}
+
+ProcessTask ProcessTask::promise_type::get_return_object() {
+	return ProcessTask(Handle::from_promise(*this));
+}
+
+void* ProcessTask::promise_type::AllocateFrame(size_t size, ProcessManager* pManager) {
+	ArenaRef pArena = pManager ? pManager->GetCoroutineArena() : nullptr;
+	void* pBlock = pArena ? pArena->Allocate(size + FRAME_HEADER_SIZE) : ::operator new(size + FRAME_HEADER_SIZE);
+	new (pBlock) ArenaRef(std::move(pArena));
+	return static_cast<uint8_t*>(pBlock) + FRAME_HEADER_SIZE;
+}
+
+void ProcessTask::promise_type::operator delete(void* pFrame, size_t size) {
+	void* pBlock = static_cast<uint8_t*>(pFrame) - FRAME_HEADER_SIZE;
+	ArenaRef* pHeader = static_cast<ArenaRef*>(pBlock);
+	ArenaRef pArena = std::move(*pHeader);
+	pHeader->~ArenaRef();
+	if (pArena) {
+		pArena->Deallocate(pBlock, size + FRAME_HEADER_SIZE);
+	}
+	else {
+		::operator delete(pBlock);
+	}
+}
+
+void ProcessTask::promise_type::FrameAwaiter::await_suspend(std::coroutine_handle<promise_type> handle) {
+	handle.promise().pScheduler->ScheduleNextFrame(handle);
+}
+
+void ProcessTask::promise_type::SecondsAwaiter::await_suspend(std::coroutine_handle<promise_type> handle) {
+	handle.promise().pScheduler->ScheduleAfter(seconds, handle);
+}
+
+void ProcessTask::promise_type::EventAwaiter::await_suspend(std::coroutine_handle<promise_type> handle) {
+	handle.promise().pScheduler->WaitForEvent(type, handle);
+}
+
+IEventDataPtr ProcessTask::promise_type::EventAwaiter::await_resume() {
+	return std::move(pPromise->pWakeEvent);
+}
+
+void ProcessTask::promise_type::ProcessAwaiter::await_suspend(std::coroutine_handle<promise_type> handle) {
+	handle.promise().pScheduler->WaitForProcess(pProcess, handle);
+}
+
+ProcessTask::ProcessTask(Handle handle) : m_handle(handle) {}
+
+ProcessTask::ProcessTask(ProcessTask&& other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {}
+
+ProcessTask& ProcessTask::operator=(ProcessTask&& other) noexcept {
+	if (this != &other) {
+		if (m_handle) {
+			m_handle.destroy();
+		}
+		m_handle = std::exchange(other.m_handle, nullptr);
+	}
+	return *this;
+}
+
+ProcessTask::~ProcessTask() {
+	if (m_handle) {
+		m_handle.destroy();
+	}
+}
+
+ProcessTask::Handle ProcessTask::Release() {
+	return std::exchange(m_handle, nullptr);
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <utility>
+
+#include "process.h"
+#include "../events/i_event_data.h"
+
+class ProcessManager;
+class CoroutineScheduler;
+
+struct WaitNextFrame {};
+
+struct WaitSeconds {
+	float seconds;
+};
+
+struct WaitEvent {
+	EventTypeId type;
+};
+
+struct WaitProcess {
+	StrongProcessPtr pProcess;
+};
+
+// Coroutine body run by a ProcessManager. It may co_await WaitNextFrame, WaitSeconds, WaitEvent (yields the event)
+// or WaitProcess (attaches the process and yields true when it succeeded). A body whose first parameter is a
+// ProcessManager& gets its frame from that manager's arena, otherwise from the global heap.
+class ProcessTask {
+public:
+	struct promise_type {
+		CoroutineScheduler* pScheduler = nullptr;
+		size_t liveIndex = 0u;
+		IEventDataPtr pWakeEvent;
+		bool childSucceeded = false;
+
+		ProcessTask get_return_object();
+		std::suspend_always initial_suspend() noexcept { return {}; }
+		std::suspend_always final_suspend() noexcept { return {}; }
+		void return_void() {}
+		void unhandled_exception() { std::terminate(); }
+
+		template <class... Args>
+		static void* operator new(size_t size, ProcessManager& manager, Args&&...) {
+			return AllocateFrame(size, &manager);
+		}
+		static void* operator new(size_t size) {
+			return AllocateFrame(size, nullptr);
+		}
+		static void operator delete(void* pFrame, size_t size);
+
+		struct FrameAwaiter {
+			bool await_ready() const noexcept { return false; }
+			void await_suspend(std::coroutine_handle<promise_type> handle);
+			void await_resume() const noexcept {}
+		};
+
+		struct SecondsAwaiter {
+			float seconds;
+			bool await_ready() const noexcept { return false; }
+			void await_suspend(std::coroutine_handle<promise_type> handle);
+			void await_resume() const noexcept {}
+		};
+
+		struct EventAwaiter {
+			EventTypeId type;
+			promise_type* pPromise;
+			bool await_ready() const noexcept { return false; }
+			void await_suspend(std::coroutine_handle<promise_type> handle);
+			IEventDataPtr await_resume();
+		};
+
+		struct ProcessAwaiter {
+			StrongProcessPtr pProcess;
+			promise_type* pPromise;
+			bool await_ready() const noexcept { return !pProcess; }
+			void await_suspend(std::coroutine_handle<promise_type> handle);
+			bool await_resume() const noexcept { return pProcess && pPromise->childSucceeded; }
+		};
+
+		FrameAwaiter await_transform(WaitNextFrame) { return {}; }
+		SecondsAwaiter await_transform(WaitSeconds wait) { return { wait.seconds }; }
+		EventAwaiter await_transform(WaitEvent wait) { return { wait.type, this }; }
+		ProcessAwaiter await_transform(WaitProcess wait) { return { std::move(wait.pProcess), this }; }
+
+	private:
+		static void* AllocateFrame(size_t size, ProcessManager* pManager);
+	};
+
+	using Handle = std::coroutine_handle<promise_type>;
+
+	ProcessTask() = default;
+	explicit ProcessTask(Handle handle);
+	ProcessTask(ProcessTask&& other) noexcept;
+	ProcessTask& operator=(ProcessTask&& other) noexcept;
+	ProcessTask(const ProcessTask&) = delete;
+	ProcessTask& operator=(const ProcessTask&) = delete;
+	~ProcessTask();
+
+	Handle Release();
+
+private:
+	Handle m_handle;
+};
@@ -0,0 +1,233 @@
+#include "binary_stream.h"
+
+#include <cstring>
+
+void BinaryWriter::WriteU8(uint8_t value) {
+	m_buffer.push_back(value);
+}
+
+void BinaryWriter::WriteU16(uint16_t value) {
+	m_buffer.push_back(static_cast<uint8_t>(value));
+	m_buffer.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+void BinaryWriter::WriteU32(uint32_t value) {
+	for (int i = 0; i < 4; ++i) {
+		m_buffer.push_back(static_cast<uint8_t>(value >> (i * 8)));
+	}
+}
+
+void BinaryWriter::WriteU64(uint64_t value) {
+	for (int i = 0; i < 8; ++i) {
+		m_buffer.push_back(static_cast<uint8_t>(value >> (i * 8)));
+	}
+}
+
+void BinaryWriter::WriteFloat(float value) {
+	uint32_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	WriteU32(bits);
+}
+
+void BinaryWriter::WriteBool(bool value) {
+	WriteU8(value ? 1u : 0u);
+}
+
+void BinaryWriter::WriteVarint(uint64_t value) {
+	while (value >= 0x80u) {
+		m_buffer.push_back(static_cast<uint8_t>(value | 0x80u));
+		value >>= 7;
+	}
+	m_buffer.push_back(static_cast<uint8_t>(value));
+}
+
+void BinaryWriter::WriteString(const std::string& value) {
+	WriteVarint(value.size());
+	WriteBytes(value.data(), value.size());
+}
+
+void BinaryWriter::WriteBytes(const void* pData, size_t size) {
+	const uint8_t* pBytes = static_cast<const uint8_t*>(pData);
+	m_buffer.insert(m_buffer.end(), pBytes, pBytes + size);
+}
+
+void BinaryWriter::WriteFloat3(const DirectX::XMFLOAT3& value) {
+	WriteFloat(value.x);
+	WriteFloat(value.y);
+	WriteFloat(value.z);
+}
+
+void BinaryWriter::WriteFloat4(const DirectX::XMFLOAT4& value) {
+	WriteFloat(value.x);
+	WriteFloat(value.y);
+	WriteFloat(value.z);
+	WriteFloat(value.w);
+}
+
+void BinaryWriter::WriteFloat4x4(const DirectX::XMFLOAT4X4& value) {
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			WriteFloat(value.m[i][j]);
+		}
+	}
+}
+
+size_t BinaryWriter::BeginBlock() {
+	size_t blockOffset = m_buffer.size();
+	WriteU32(0u);
+	return blockOffset;
+}
+
+void BinaryWriter::EndBlock(size_t blockOffset) {
+	uint32_t size = static_cast<uint32_t>(m_buffer.size() - blockOffset - 4u);
+	for (int i = 0; i < 4; ++i) {
+		m_buffer[blockOffset + i] = static_cast<uint8_t>(size >> (i * 8));
+	}
+}
+
+const std::vector<uint8_t>& BinaryWriter::GetBuffer() const {
+	return m_buffer;
+}
+
+const uint8_t* BinaryWriter::GetData() const {
+	return m_buffer.data();
+}
+
+size_t BinaryWriter::GetSize() const {
+	return m_buffer.size();
+}
+
+void BinaryWriter::Clear() {
+	m_buffer.clear();
+}
+
+BinaryReader::BinaryReader(const uint8_t* pData, size_t size) : m_pData(pData), m_size(size), m_pos(0u), m_good(true) {}
+
+uint8_t BinaryReader::ReadU8() {
+	if (!Require(1u)) { return 0u; }
+	return m_pData[m_pos++];
+}
+
+uint16_t BinaryReader::ReadU16() {
+	if (!Require(2u)) { return 0u; }
+	uint16_t value = static_cast<uint16_t>(m_pData[m_pos]) | static_cast<uint16_t>(m_pData[m_pos + 1] << 8);
+	m_pos += 2u;
+	return value;
+}
+
+uint32_t BinaryReader::ReadU32() {
+	if (!Require(4u)) { return 0u; }
+	uint32_t value = 0u;
+	for (int i = 0; i < 4; ++i) {
+		value |= static_cast<uint32_t>(m_pData[m_pos++]) << (i * 8);
+	}
+	return value;
+}
+
+uint64_t BinaryReader::ReadU64() {
+	if (!Require(8u)) { return 0u; }
+	uint64_t value = 0u;
+	for (int i = 0; i < 8; ++i) {
+		value |= static_cast<uint64_t>(m_pData[m_pos++]) << (i * 8);
+	}
+	return value;
+}
+
+float BinaryReader::ReadFloat() {
+	uint32_t bits = ReadU32();
+	float value;
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+bool BinaryReader::ReadBool() {
+	return ReadU8() != 0u;
+}
+
+uint64_t BinaryReader::ReadVarint() {
+	uint64_t value = 0u;
+	for (int shift = 0; shift < 64; shift += 7) {
+		if (!Require(1u)) { return 0u; }
+		uint8_t byte = m_pData[m_pos++];
+		value |= static_cast<uint64_t>(byte & 0x7fu) << shift;
+		if ((byte & 0x80u) == 0u) {
+			return value;
+		}
+	}
+	m_good = false;
+	return 0u;
+}
+
+std::string BinaryReader::ReadString() {
+	uint64_t size = ReadVarint();
+	if (!Require(static_cast<size_t>(size))) { return std::string(); }
+	std::string value(reinterpret_cast<const char*>(m_pData + m_pos), static_cast<size_t>(size));
+	m_pos += static_cast<size_t>(size);
+	return value;
+}
+
+bool BinaryReader::ReadBytes(void* pData, size_t size) {
+	if (!Require(size)) { return false; }
+	std::memcpy(pData, m_pData + m_pos, size);
+	m_pos += size;
+	return true;
+}
+
+DirectX::XMFLOAT3 BinaryReader::ReadFloat3() {
+	DirectX::XMFLOAT3 value;
+	value.x = ReadFloat();
+	value.y = ReadFloat();
+	value.z = ReadFloat();
+	return value;
+}
+
+DirectX::XMFLOAT4 BinaryReader::ReadFloat4() {
+	DirectX::XMFLOAT4 value;
+	value.x = ReadFloat();
+	value.y = ReadFloat();
+	value.z = ReadFloat();
+	value.w = ReadFloat();
+	return value;
+}
+
+DirectX::XMFLOAT4X4 BinaryReader::ReadFloat4x4() {
+	DirectX::XMFLOAT4X4 value;
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			value.m[i][j] = ReadFloat();
+		}
+	}
+	return value;
+}
+
+bool BinaryReader::ReadBlock(BinaryReader& block) {
+	uint32_t size = ReadU32();
+	if (!Require(size)) {
+		block = BinaryReader(nullptr, 0u);
+		block.m_good = false;
+		return false;
+	}
+	block = BinaryReader(m_pData + m_pos, size);
+	m_pos += size;
+	return true;
+}
+
+size_t BinaryReader::GetPosition() const {
+	return m_pos;
+}
+
+size_t BinaryReader::GetRemaining() const {
+	return m_size - m_pos;
+}
+
+bool BinaryReader::IsGood() const {
+	return m_good;
+}
+
+bool BinaryReader::Require(size_t size) {
+	if (!m_good || m_size - m_pos < size) {
+		m_good = false;
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <DirectXMath.h>
+
+// Fixed little-endian layout regardless of host byte order, integers that are usually small go as LEB128 varints.
+class BinaryWriter {
+	std::vector<uint8_t> m_buffer;
+
+public:
+	BinaryWriter() = default;
+
+	void WriteU8(uint8_t value);
+	void WriteU16(uint16_t value);
+	void WriteU32(uint32_t value);
+	void WriteU64(uint64_t value);
+	void WriteFloat(float value);
+	void WriteBool(bool value);
+	void WriteVarint(uint64_t value);
+	void WriteString(const std::string& value);
+	void WriteBytes(const void* pData, size_t size);
+	void WriteFloat3(const DirectX::XMFLOAT3& value);
+	void WriteFloat4(const DirectX::XMFLOAT4& value);
+	void WriteFloat4x4(const DirectX::XMFLOAT4X4& value);
+
+	// Length prefixed block: BeginBlock reserves a 32 bit size, EndBlock fills it with the bytes written since.
+	size_t BeginBlock();
+	void EndBlock(size_t blockOffset);
+
+	const std::vector<uint8_t>& GetBuffer() const;
+	const uint8_t* GetData() const;
+	size_t GetSize() const;
+	void Clear();
+};
+
+class BinaryReader {
+	const uint8_t* m_pData;
+	size_t m_size;
+	size_t m_pos;
+	bool m_good;
+
+public:
+	BinaryReader(const uint8_t* pData, size_t size);
+
+	uint8_t ReadU8();
+	uint16_t ReadU16();
+	uint32_t ReadU32();
+	uint64_t ReadU64();
+	float ReadFloat();
+	bool ReadBool();
+	uint64_t ReadVarint();
+	std::string ReadString();
+	bool ReadBytes(void* pData, size_t size);
+	DirectX::XMFLOAT3 ReadFloat3();
+	DirectX::XMFLOAT4 ReadFloat4();
+	DirectX::XMFLOAT4X4 ReadFloat4x4();
+	// Reads a block written with BeginBlock/EndBlock into its own reader and skips past it.
+	bool ReadBlock(BinaryReader& block);
+
+	size_t GetPosition() const;
+	size_t GetRemaining() const;
+	bool IsGood() const;
+
+private:
+	bool Require(size_t size);
+};
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cstdint>
+
+constexpr uint32_t FNV1A_32_OFFSET_BASIS = 0x811c9dc5u;
+constexpr uint32_t FNV1A_32_PRIME = 0x01000193u;
+
+constexpr uint32_t Fnv1a32(const char* str, uint32_t hash = FNV1A_32_OFFSET_BASIS) {
+	return (*str == '\0') ? hash : Fnv1a32(str + 1, (hash ^ static_cast<uint32_t>(static_cast<unsigned char>(*str))) * FNV1A_32_PRIME);
+}
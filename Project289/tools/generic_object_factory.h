@@ -43,10 +43,11 @@ public:
 	}
 
 	const std::string& GetName(IdType id) {
+		static const std::string notRegistered = "No name or not registered";
 		auto findIt = m_names.find(id);
 		if (findIt != m_names.end()) {
 			return findIt->second;
 		}
-		return "No name or not registered";
+		return notRegistered;
 	}
 };
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include "job_system.h"
+
+#include <algorithm>
+
+namespace {
+	thread_local const JobSystem* ts_pOwner = nullptr;
+	thread_local size_t ts_queueIndex = 0u;
+}
+
+bool JobCounter::IsDone() const {
+	return m_count.load(std::memory_order_acquire) == 0u;
+}
+
+JobSystem::JobSystem(unsigned int workerCount) : m_pendingCount(0u), m_quit(false) {
+	if (workerCount == 0u) {
+		unsigned int hardwareThreads = std::thread::hardware_concurrency();
+		workerCount = hardwareThreads > 1u ? hardwareThreads - 1u : 1u;
+	}
+
+	m_queues.reserve(workerCount + 1u);
+	for (unsigned int i = 0u; i < workerCount + 1u; ++i) {
+		m_queues.push_back(std::make_unique<WorkerQueue>());
+	}
+
+	m_workers.reserve(workerCount);
+	for (unsigned int i = 0u; i < workerCount; ++i) {
+		m_workers.emplace_back(&JobSystem::WorkerLoop, this, static_cast<size_t>(i + 1u));
+	}
+}
+
+JobSystem::~JobSystem() {
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_quit = true;
+	}
+	m_sleepCondition.notify_all();
+	for (std::thread& worker : m_workers) {
+		worker.join();
+	}
+}
+
+void JobSystem::Submit(Job job, JobCounter& counter) {
+	counter.m_count.fetch_add(1u, std::memory_order_relaxed);
+
+	WorkerQueue& queue = *m_queues[GetCurrentQueueIndex()];
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.tasks.push_back({ std::move(job), &counter });
+	}
+	m_pendingCount.fetch_add(1u, std::memory_order_release);
+
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+	}
+	m_sleepCondition.notify_one();
+}
+
+void JobSystem::Wait(JobCounter& counter) {
+	size_t queueIndex = GetCurrentQueueIndex();
+	while (!counter.IsDone()) {
+		if (!RunOne(queueIndex)) {
+			std::this_thread::yield();
+		}
+	}
+}
+
+unsigned int JobSystem::GetWorkerCount() const {
+	return static_cast<unsigned int>(m_workers.size());
+}
+
+void JobSystem::WorkerLoop(size_t queueIndex) {
+	ts_pOwner = this;
+	ts_queueIndex = queueIndex;
+
+	while (true) {
+		if (RunOne(queueIndex)) {
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
+		m_sleepCondition.wait(lock, [this]() { return m_quit.load() || m_pendingCount.load(std::memory_order_acquire) > 0u; });
+		if (m_quit.load() && m_pendingCount.load(std::memory_order_acquire) == 0u) {
+			return;
+		}
+	}
+}
+
+bool JobSystem::RunOne(size_t queueIndex) {
+	Task task;
+	if (!TryPop(queueIndex, task) && !TrySteal(queueIndex, task)) {
+		return false;
+	}
+
+	m_pendingCount.fetch_sub(1u, std::memory_order_acq_rel);
+	task.job();
+	task.pCounter->m_count.fetch_sub(1u, std::memory_order_acq_rel);
+	return true;
+}
+
+bool JobSystem::TryPop(size_t queueIndex, Task& task) {
+	WorkerQueue& queue = *m_queues[queueIndex];
+	std::lock_guard<std::mutex> lock(queue.mutex);
+	if (queue.tasks.empty()) {
+		return false;
+	}
+	task = std::move(queue.tasks.back());
+	queue.tasks.pop_back();
+	return true;
+}
+
+bool JobSystem::TrySteal(size_t thiefIndex, Task& task) {
+	const size_t queueCount = m_queues.size();
+	for (size_t offset = 1u; offset < queueCount; ++offset) {
+		WorkerQueue& victim = *m_queues[(thiefIndex + offset) % queueCount];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if (!victim.tasks.empty()) {
+			task = std::move(victim.tasks.front());
+			victim.tasks.pop_front();
+			return true;
+		}
+	}
+	return false;
+}
+
+size_t JobSystem::GetCurrentQueueIndex() const {
+	return (ts_pOwner == this) ? ts_queueIndex : 0u;
+}
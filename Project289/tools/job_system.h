@@ -0,0 +1,82 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class JobSystem;
+
+class JobCounter {
+	std::atomic<unsigned int> m_count{ 0u };
+
+	friend class JobSystem;
+
+public:
+	bool IsDone() const;
+};
+
+// Work-stealing pool: every worker owns a deque it pops from the back, idle workers steal from the front of the others.
+// Threads that are not workers submit into a shared queue and help execute jobs while they wait.
+class JobSystem {
+public:
+	using Job = std::function<void()>;
+
+	explicit JobSystem(unsigned int workerCount = 0u);
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	void Submit(Job job, JobCounter& counter);
+	void Wait(JobCounter& counter);
+
+	// Calls fn(begin, end) over [0, count) split into chunks of at most batchSize, returns when all chunks are done.
+	template <class Fn>
+	void ParallelFor(size_t count, size_t batchSize, Fn&& fn) {
+		if (count == 0u) { return; }
+		if (batchSize == 0u) { batchSize = 1u; }
+		if (count <= batchSize) {
+			fn(size_t(0u), count);
+			return;
+		}
+		JobCounter counter;
+		for (size_t begin = 0u; begin < count; begin += batchSize) {
+			size_t end = std::min(begin + batchSize, count);
+			Submit([&fn, begin, end]() { fn(begin, end); }, counter);
+		}
+		Wait(counter);
+	}
+
+	unsigned int GetWorkerCount() const;
+
+private:
+	struct Task {
+		Job job;
+		JobCounter* pCounter;
+	};
+
+	struct WorkerQueue {
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+	void WorkerLoop(size_t queueIndex);
+	bool RunOne(size_t queueIndex);
+	bool TryPop(size_t queueIndex, Task& task);
+	bool TrySteal(size_t thiefIndex, Task& task);
+	size_t GetCurrentQueueIndex() const;
+
+	std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+	std::vector<std::thread> m_workers;
+
+	std::mutex m_sleepMutex;
+	std::condition_variable m_sleepCondition;
+	std::atomic<unsigned int> m_pendingCount;
+	std::atomic<bool> m_quit;
+};
@@ -0,0 +1,112 @@
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+	Close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::string& fileName) {
+	Close();
+
+	// Shared for delete so the baker can rename the file aside while it is mapped
+	HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	m_file = file;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+		Close();
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0u, 0u, nullptr);
+	if (!mapping) {
+		Close();
+		return false;
+	}
+	m_mapping = mapping;
+
+	m_pData = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0u, 0u, 0u));
+	if (!m_pData) {
+		Close();
+		return false;
+	}
+	m_size = static_cast<size_t>(size.QuadPart);
+	return true;
+}
+
+void MappedFile::Close() {
+	if (m_pData) {
+		UnmapViewOfFile(m_pData);
+	}
+	if (m_mapping) {
+		CloseHandle(static_cast<HANDLE>(m_mapping));
+	}
+	if (m_file) {
+		CloseHandle(static_cast<HANDLE>(m_file));
+	}
+	m_file = nullptr;
+	m_mapping = nullptr;
+	m_pData = nullptr;
+	m_size = 0u;
+}
+
+#else
+
+bool MappedFile::Open(const std::string& fileName) {
+	Close();
+
+	int fd = open(fileName.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size == 0) {
+		close(fd);
+		return false;
+	}
+
+	void* pData = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (pData == MAP_FAILED) {
+		return false;
+	}
+	m_pData = static_cast<const uint8_t*>(pData);
+	m_size = static_cast<size_t>(st.st_size);
+	return true;
+}
+
+void MappedFile::Close() {
+	if (m_pData) {
+		munmap(const_cast<uint8_t*>(m_pData), m_size);
+	}
+	m_pData = nullptr;
+	m_size = 0u;
+}
+
+#endif
+
+bool MappedFile::IsOpen() const {
+	return m_pData != nullptr;
+}
+
+const uint8_t* MappedFile::GetData() const {
+	return m_pData;
+}
+
+size_t MappedFile::GetSize() const {
+	return m_size;
+}
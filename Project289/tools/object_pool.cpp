@@ -0,0 +1,84 @@
+#include "object_pool.h"
+
+#include <algorithm>
+
+namespace {
+	std::mutex& GetRegistryMutex() {
+		static std::mutex* pMutex = new std::mutex;
+		return *pMutex;
+	}
+
+	std::vector<ObjectPool*>& GetRegistry() {
+		static std::vector<ObjectPool*>* pRegistry = new std::vector<ObjectPool*>;
+		return *pRegistry;
+	}
+}
+
+ObjectPool::ObjectPool(std::string name) : m_name(std::move(name)), m_blockSize(0u), m_liveObjects(0u), m_pFreeList(nullptr) {
+	std::lock_guard<std::mutex> lock(GetRegistryMutex());
+	GetRegistry().push_back(this);
+}
+
+void* ObjectPool::Allocate(size_t size) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_blockSize == 0u) {
+		constexpr size_t alignment = alignof(std::max_align_t);
+		m_blockSize = (std::max(size, sizeof(FreeNode)) + alignment - 1u) & ~(alignment - 1u);
+	}
+	if (size > m_blockSize) {
+		return ::operator new(size);
+	}
+
+	if (!m_pFreeList) {
+		m_chunks.push_back(std::make_unique<uint8_t[]>(m_blockSize * sk_BlocksPerChunk));
+		uint8_t* pChunk = m_chunks.back().get();
+		for (size_t i = sk_BlocksPerChunk; i > 0u; --i) {
+			FreeNode* pNode = reinterpret_cast<FreeNode*>(pChunk + (i - 1u) * m_blockSize);
+			pNode->pNext = m_pFreeList;
+			m_pFreeList = pNode;
+		}
+	}
+
+	FreeNode* pNode = m_pFreeList;
+	m_pFreeList = pNode->pNext;
+	++m_liveObjects;
+	return pNode;
+}
+
+void ObjectPool::Deallocate(void* pBlock, size_t size) {
+	if (!pBlock) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (size > m_blockSize) {
+		::operator delete(pBlock);
+		return;
+	}
+
+	FreeNode* pNode = static_cast<FreeNode*>(pBlock);
+	pNode->pNext = m_pFreeList;
+	m_pFreeList = pNode;
+	--m_liveObjects;
+}
+
+ObjectPoolStats ObjectPool::GetStats() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	ObjectPoolStats stats;
+	stats.name = m_name;
+	stats.blockSize = m_blockSize;
+	stats.liveObjects = m_liveObjects;
+	stats.bytesInUse = m_liveObjects * m_blockSize;
+	stats.bytesReserved = m_chunks.size() * m_blockSize * sk_BlocksPerChunk;
+	return stats;
+}
+
+std::vector<ObjectPoolStats> ObjectPool::GetAllStats() {
+	std::lock_guard<std::mutex> lock(GetRegistryMutex());
+	std::vector<ObjectPoolStats> allStats;
+	allStats.reserve(GetRegistry().size());
+	for (const ObjectPool* pPool : GetRegistry()) {
+		allStats.push_back(pPool->GetStats());
+	}
+	return allStats;
+}
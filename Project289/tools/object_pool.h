@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+struct ObjectPoolStats {
+	std::string name;
+	size_t blockSize = 0u;
+	size_t liveObjects = 0u;
+	size_t bytesInUse = 0u;
+	size_t bytesReserved = 0u;
+};
+
+// Fixed-size block pool for one object type. The block size is taken from the first allocation, which for
+// allocate_shared is the object plus its control block; other sizes fall through to the global heap.
+// Pools register themselves so GetAllStats() can report every pooled type. Thread safe.
+class ObjectPool {
+public:
+	static constexpr size_t sk_BlocksPerChunk = 64u;
+
+	explicit ObjectPool(std::string name);
+	ObjectPool(const ObjectPool&) = delete;
+	ObjectPool& operator=(const ObjectPool&) = delete;
+
+	void* Allocate(size_t size);
+	void Deallocate(void* pBlock, size_t size);
+
+	ObjectPoolStats GetStats() const;
+	static std::vector<ObjectPoolStats> GetAllStats();
+
+private:
+	struct FreeNode {
+		FreeNode* pNext;
+	};
+
+	mutable std::mutex m_mutex;
+	std::string m_name;
+	size_t m_blockSize;
+	size_t m_liveObjects;
+	FreeNode* m_pFreeList;
+	std::vector<std::unique_ptr<uint8_t[]>> m_chunks;
+};
+
+// Pools live for the whole program: objects may still be released during static destruction.
+template <class T>
+ObjectPool& GetObjectPool() {
+	static ObjectPool* pPool = new ObjectPool(typeid(T).name());
+	return *pPool;
+}
+
+template <class T>
+class PoolAllocator {
+	template <class U> friend class PoolAllocator;
+
+	ObjectPool* m_pPool;
+
+public:
+	using value_type = T;
+
+	explicit PoolAllocator(ObjectPool& pool) : m_pPool(&pool) {}
+	template <class U>
+	PoolAllocator(const PoolAllocator<U>& other) : m_pPool(other.m_pPool) {}
+
+	T* allocate(size_t count) { return static_cast<T*>(m_pPool->Allocate(count * sizeof(T))); }
+	void deallocate(T* pBlock, size_t count) { m_pPool->Deallocate(pBlock, count * sizeof(T)); }
+
+	template <class U>
+	bool operator==(const PoolAllocator<U>& other) const { return m_pPool == other.m_pPool; }
+	template <class U>
+	bool operator!=(const PoolAllocator<U>& other) const { return m_pPool != other.m_pPool; }
+};
+
+template <class T, class... Args>
+std::shared_ptr<T> MakePooled(Args&&... args) {
+	return std::allocate_shared<T>(PoolAllocator<T>(GetObjectPool<T>()), std::forward<Args>(args)...);
+}
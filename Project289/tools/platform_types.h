@@ -0,0 +1,10 @@
+#pragma once
+
+// Win32 typedefs shared with code that also builds without the Windows SDK, such as the headless benchmarks.
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <cstdint>
+
+typedef uint32_t DWORD;
+#endif
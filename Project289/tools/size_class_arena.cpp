@@ -0,0 +1,65 @@
+#include "size_class_arena.h"
+
+#include <new>
+
+void* SizeClassArena::Allocate(size_t size) {
+	if (size == 0u) {
+		size = 1u;
+	}
+	if (size > sk_MaxPooledSize) {
+		m_bytesInUse += size;
+		return ::operator new(size);
+	}
+
+	size_t classIndex = GetClassIndex(size);
+	size_t classSize = (classIndex + 1u) * sk_Granularity;
+	m_bytesInUse += classSize;
+
+	FreeNode* pNode = m_freeLists[classIndex];
+	if (pNode) {
+		m_freeLists[classIndex] = pNode->pNext;
+		return pNode;
+	}
+
+	if (m_remaining < classSize) {
+		m_chunks.push_back(std::make_unique<uint8_t[]>(sk_ChunkSize));
+		m_pCursor = m_chunks.back().get();
+		m_remaining = sk_ChunkSize;
+	}
+
+	void* pBlock = m_pCursor;
+	m_pCursor += classSize;
+	m_remaining -= classSize;
+	return pBlock;
+}
+
+void SizeClassArena::Deallocate(void* pBlock, size_t size) {
+	if (!pBlock) { return; }
+	if (size == 0u) {
+		size = 1u;
+	}
+	if (size > sk_MaxPooledSize) {
+		m_bytesInUse -= size;
+		::operator delete(pBlock);
+		return;
+	}
+
+	size_t classIndex = GetClassIndex(size);
+	m_bytesInUse -= (classIndex + 1u) * sk_Granularity;
+
+	FreeNode* pNode = static_cast<FreeNode*>(pBlock);
+	pNode->pNext = m_freeLists[classIndex];
+	m_freeLists[classIndex] = pNode;
+}
+
+size_t SizeClassArena::GetBytesInUse() const {
+	return m_bytesInUse;
+}
+
+size_t SizeClassArena::GetBytesReserved() const {
+	return m_chunks.size() * sk_ChunkSize;
+}
+
+size_t SizeClassArena::GetClassIndex(size_t size) {
+	return (size + sk_Granularity - 1u) / sk_Granularity - 1u;
+}
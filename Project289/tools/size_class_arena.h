@@ -0,0 +1,39 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Pool allocator for many short-lived blocks of varying size: requests are rounded up to a size class
+// and recycled through per-class free lists, blocks larger than the biggest class go to the global heap.
+// Not thread safe.
+class SizeClassArena {
+public:
+	static constexpr size_t sk_Granularity = 64u;
+	static constexpr size_t sk_MaxPooledSize = 4096u;
+	static constexpr size_t sk_ChunkSize = 64u * 1024u;
+
+	SizeClassArena() = default;
+	SizeClassArena(const SizeClassArena&) = delete;
+	SizeClassArena& operator=(const SizeClassArena&) = delete;
+
+	void* Allocate(size_t size);
+	void Deallocate(void* pBlock, size_t size);
+
+	size_t GetBytesInUse() const;
+	size_t GetBytesReserved() const;
+
+private:
+	struct FreeNode {
+		FreeNode* pNext;
+	};
+
+	static size_t GetClassIndex(size_t size);
+
+	std::array<FreeNode*, sk_MaxPooledSize / sk_Granularity> m_freeLists{};
+	std::vector<std::unique_ptr<uint8_t[]>> m_chunks;
+	uint8_t* m_pCursor = nullptr;
+	size_t m_remaining = 0u;
+	size_t m_bytesInUse = 0u;
+};
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Hashed timing wheel: scheduling is O(1), advancing visits only the slots of the elapsed ticks.
+// Entries further than one revolution away stay in their slot until their tick comes around.
+template <class T>
+class TimingWheel {
+public:
+	struct Entry {
+		uint64_t tick;
+		T value;
+	};
+
+	explicit TimingWheel(size_t slotCount) : m_slots(std::max<size_t>(slotCount, 1u)), m_currentTick(0u), m_count(0u) {}
+
+	void Schedule(uint64_t tick, T value) {
+		tick = std::max(tick, m_currentTick + 1u);
+		m_slots[tick % m_slots.size()].push_back({ tick, std::move(value) });
+		++m_count;
+	}
+
+	// Expires every entry with tick <= toTick, calling onExpire(tick, value) in tick order.
+	template <class Fn>
+	void Advance(uint64_t toTick, Fn&& onExpire) {
+		if (toTick <= m_currentTick) { return; }
+		if (m_count == 0u) {
+			m_currentTick = toTick;
+			return;
+		}
+
+		const uint64_t slotCount = m_slots.size();
+		if (toTick - m_currentTick < slotCount) {
+			for (uint64_t tick = m_currentTick + 1u; tick <= toTick; ++tick) {
+				m_currentTick = tick;
+				ExpireSlot(m_slots[tick % slotCount], toTick, m_expired);
+				for (Entry& entry : m_expired) {
+					onExpire(entry.tick, entry.value);
+				}
+				m_expired.clear();
+			}
+		}
+		else {
+			for (std::vector<Entry>& slot : m_slots) {
+				ExpireSlot(slot, toTick, m_expired);
+			}
+			std::stable_sort(m_expired.begin(), m_expired.end(), [](const Entry& lhs, const Entry& rhs) { return lhs.tick < rhs.tick; });
+			m_currentTick = toTick;
+			for (Entry& entry : m_expired) {
+				onExpire(entry.tick, entry.value);
+			}
+			m_expired.clear();
+		}
+	}
+
+	// Removes entries for which pred(value) is true, stopping after the first one unless all is set.
+	template <class Pred>
+	size_t RemoveIf(Pred&& pred, bool all) {
+		size_t removed = 0u;
+		for (std::vector<Entry>& slot : m_slots) {
+			for (auto it = slot.begin(); it != slot.end();) {
+				if (pred(it->value)) {
+					it = slot.erase(it);
+					++removed;
+					--m_count;
+					if (!all) { return removed; }
+				}
+				else {
+					++it;
+				}
+			}
+		}
+		return removed;
+	}
+
+	template <class Fn>
+	void ForEach(Fn&& fn) const {
+		for (const std::vector<Entry>& slot : m_slots) {
+			for (const Entry& entry : slot) {
+				fn(entry.tick, entry.value);
+			}
+		}
+	}
+
+	uint64_t GetCurrentTick() const {
+		return m_currentTick;
+	}
+
+	size_t Size() const {
+		return m_count;
+	}
+
+	void Clear() {
+		for (std::vector<Entry>& slot : m_slots) {
+			slot.clear();
+		}
+		m_count = 0u;
+	}
+
+private:
+	void ExpireSlot(std::vector<Entry>& slot, uint64_t toTick, std::vector<Entry>& expired) {
+		size_t keep = 0u;
+		for (size_t i = 0u; i < slot.size(); ++i) {
+			if (slot[i].tick <= toTick) {
+				expired.push_back(std::move(slot[i]));
+			}
+			else {
+				if (keep != i) {
+					slot[keep] = std::move(slot[i]);
+				}
+				++keep;
+			}
+		}
+		m_count -= slot.size() - keep;
+		slot.erase(slot.begin() + keep, slot.end());
+	}
+
+	std::vector<std::vector<Entry>> m_slots;
+	std::vector<Entry> m_expired;
+	uint64_t m_currentTick;
+	size_t m_count;
+};
@@ -0,0 +1,75 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "../Project289/engine/component_benchmark.h"
+#include "../Project289/engine/light_benchmark.h"
+#include "../Project289/engine/process_benchmark.h"
+#include "../Project289/engine/occlusion_benchmark.h"
+
+using namespace std::literals;
+
+// Project289Bench -bench-lights 500 1000 bins 500 point and spot lights into the light clusters 1000 times and writes
+// the timings to bench_lights.txt.
+static int BenchLights(int argc, char** argv) {
+	int lights = argc > 2 ? std::atoi(argv[2]) : 500;
+	int frames = argc > 3 ? std::atoi(argv[3]) : 1000;
+
+	std::ofstream report("bench_lights.txt");
+	report << BenchmarkLightClusters(lights, frames);
+	return 0;
+}
+
+// Project289Bench -bench-processes 100000 1000 updates 100000 mostly idle processes for 1000 frames and writes the
+// timings to bench_processes.txt.
+static int BenchProcesses(int argc, char** argv) {
+	int processes = argc > 2 ? std::atoi(argv[2]) : 100000;
+	int frames = argc > 3 ? std::atoi(argv[3]) : 1000;
+
+	std::ofstream report("bench_processes.txt");
+	report << BenchmarkProcesses(processes, frames);
+	return 0;
+}
+
+// Project289Bench -bench-occlusion 20000 1000 tests 20000 boxes against a row of wall occluders 1000 times and writes
+// the timings to bench_occlusion.txt.
+static int BenchOcclusion(int argc, char** argv) {
+	int boxes = argc > 2 ? std::atoi(argv[2]) : 20000;
+	int frames = argc > 3 ? std::atoi(argv[3]) : 1000;
+
+	std::ofstream report("bench_occlusion.txt");
+	report << BenchmarkOcclusion(boxes, frames);
+	return 0;
+}
+
+// Project289Bench -bench-components 100000 1000 updates 100000 actors for 1000 frames actor by actor, through the
+// component store and with 1% of them respawned every frame, and writes the timings to bench_components.txt.
+static int BenchComponents(int argc, char** argv) {
+	int actors = argc > 2 ? std::atoi(argv[2]) : 100000;
+	int frames = argc > 3 ? std::atoi(argv[3]) : 1000;
+
+	std::ofstream report("bench_components.txt");
+	report << BenchmarkComponentUpdate(actors, frames);
+	return 0;
+}
+
+// The CPU only benchmarks, without a window, a device or an engine. Benchmarks that need the engine run from
+// Project289.exe in headless mode.
+int main(int argc, char** argv) {
+	if (argc > 1 && argv[1] == "-bench-lights"s) {
+		return BenchLights(argc, argv);
+	}
+	if (argc > 1 && argv[1] == "-bench-processes"s) {
+		return BenchProcesses(argc, argv);
+	}
+	if (argc > 1 && argv[1] == "-bench-occlusion"s) {
+		return BenchOcclusion(argc, argv);
+	}
+	if (argc > 1 && argv[1] == "-bench-components"s) {
+		return BenchComponents(argc, argv);
+	}
+
+	std::cerr << "Usage: Project289Bench -bench-lights [lights] [frames] | -bench-processes [processes] [frames] | -bench-occlusion [boxes] [frames] | -bench-components [actors] [frames]\n";
+	return 1;
+}